@@ -0,0 +1,87 @@
+# 分配器的优化构建流程：基线、unity+LTO、unity+LTO+PGO 三次构建，用同一个基准比较吞吐量
+#
+#   cmake -P cmake/AllocatorProfile.cmake
+#   cmake -DBINARY_DIR=/tmp/mystl-profile -DBENCH_ARGS="--threads 1,4 --ops 1000000 --repeat 5" -P cmake/AllocatorProfile.cmake
+#
+# 可选变量：
+#   BINARY_DIR        构建目录，默认 <源码>/build-profile，下面分别是 baseline、inline、pgo
+#   BENCH_ARGS        比较时传给 mystl_allocator_benchmark 的参数
+#   TRAINING_ARGS     PGO 训练时的参数，默认用 CMakeLists.txt 里的 MYSTL_PGO_TRAINING_ARGS
+#   GENERATOR         传给 cmake -G
+#   CXX_COMPILER      传给 CMAKE_CXX_COMPILER
+#
+# 每个阶段的结果保存在 BINARY_DIR 下的 baseline.csv、inline.csv、pgo.csv，
+# 后两次运行用 --compare baseline.csv 输出每一行和汇总的吞吐量变化
+
+cmake_minimum_required(VERSION 3.16)
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if(NOT BINARY_DIR)
+    set(BINARY_DIR "${SOURCE_DIR}/build-profile")
+endif()
+if(NOT BENCH_ARGS)
+    set(BENCH_ARGS "--threads 1,2,4 --ops 500000 --repeat 3")
+endif()
+separate_arguments(BENCH_ARGS NATIVE_COMMAND "${BENCH_ARGS}")
+
+set(common_args -DCMAKE_BUILD_TYPE=Release -DMYSTL_BUILD_TESTS=OFF -DMYSTL_BUILD_BENCHMARKS=ON)
+if(GENERATOR)
+    list(APPEND common_args -G "${GENERATOR}")
+endif()
+if(CXX_COMPILER)
+    list(APPEND common_args -DCMAKE_CXX_COMPILER=${CXX_COMPILER})
+endif()
+
+function(run_step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        string(REPLACE ";" " " command "${ARGN}")
+        message(FATAL_ERROR "failed (${result}): ${command}")
+    endif()
+endfunction()
+
+function(configure_and_build dir)
+    run_step(${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${dir} ${common_args} ${ARGN})
+    run_step(${CMAKE_COMMAND} --build ${dir} --config Release --target mystl_allocator_benchmark)
+endfunction()
+
+function(run_benchmark dir)
+    find_program(benchmark mystl_allocator_benchmark PATHS ${dir} ${dir}/Release NO_DEFAULT_PATH)
+    if(NOT benchmark)
+        message(FATAL_ERROR "mystl_allocator_benchmark not found in ${dir}")
+    endif()
+    run_step(${benchmark} ${BENCH_ARGS} ${ARGN})
+endfunction()
+
+# 1. 基线：普通的 Release 构建
+message(STATUS "==== baseline ====")
+configure_and_build(${BINARY_DIR}/baseline)
+run_benchmark(${BINARY_DIR}/baseline --save ${BINARY_DIR}/baseline.csv)
+
+# 2. 只打开 unity 构建和 LTO，看跨文件内联本身带来多少
+message(STATUS "==== unity + LTO ====")
+set(inline_args -DMYSTL_UNITY_BUILD=ON -DMYSTL_ENABLE_LTO=ON)
+configure_and_build(${BINARY_DIR}/inline ${inline_args} -DMYSTL_PGO=OFF)
+run_benchmark(${BINARY_DIR}/inline --save ${BINARY_DIR}/inline.csv --compare ${BINARY_DIR}/baseline.csv)
+
+# 3. 在 2 的基础上加 PGO：插桩构建，跑训练负载，再用 profile 重新构建
+#    GCC 按目标文件的路径查找 profile，所以插桩和使用必须在同一个构建目录里
+message(STATUS "==== unity + LTO + PGO ====")
+set(pgo_dir ${BINARY_DIR}/pgo/profile)
+file(REMOVE_RECURSE ${pgo_dir})
+set(pgo_args ${inline_args} -DMYSTL_PGO_DIR=${pgo_dir})
+if(TRAINING_ARGS)
+    list(APPEND pgo_args "-DMYSTL_PGO_TRAINING_ARGS=${TRAINING_ARGS}")
+endif()
+configure_and_build(${BINARY_DIR}/pgo ${pgo_args} -DMYSTL_PGO=GENERATE)
+run_step(${CMAKE_COMMAND} --build ${BINARY_DIR}/pgo --config Release --target mystl_pgo_train)
+
+file(GLOB raw_profiles ${pgo_dir}/*.profraw)
+if(raw_profiles)
+    # Clang 的原始 profile 要先合并成 default.profdata
+    find_program(llvm_profdata NAMES llvm-profdata REQUIRED)
+    run_step(${llvm_profdata} merge -output=${pgo_dir}/default.profdata ${raw_profiles})
+endif()
+
+configure_and_build(${BINARY_DIR}/pgo ${pgo_args} -DMYSTL_PGO=USE)
+run_benchmark(${BINARY_DIR}/pgo --save ${BINARY_DIR}/pgo.csv --compare ${BINARY_DIR}/baseline.csv)
@@ -11,10 +11,10 @@ namespace HashBucketMemoryPool
 		SLOT_BASE_SIZE = 8,
 		MAX_SLOT_SIZE = 512,
 		MEMORY_POOL_NUM = MAX_SLOT_SIZE / SLOT_BASE_SIZE,
-		BLOCK_SIZE_DEFAULT = 4096//ĬϵĿС
+		BLOCK_SIZE_DEFAULT = 4096//默认的块大小
 	};
 
-	class SimpleMemoryPool;//ǰ
+	class SimpleMemoryPool;//前向声明
 
 	class HashBucket
 	{
@@ -30,7 +30,7 @@ namespace HashBucketMemoryPool
 		friend void deleteElement(T* p);
 
 	private:
-		//鱾Ǿ̬ģָĬϳʼΪ nullptr
+		//数组本身是静态的，指针默认初始化为 nullptr
 		static SimpleMemoryPool* _s_pool_instances[static_cast<size_t>(HashBucketConstants::MEMORY_POOL_NUM)];
 
 		static SimpleMemoryPool& getPoolInstance(size_t index);
@@ -79,9 +79,9 @@ namespace HashBucketMemoryPool
 	}
 
 
-	//֮ǰSimpleMemoryPooolиģinit
-	//۽ṹ壺ڵ
-	//ΪʲôѡstructunionΪ˼ݺĲ̣ڵ߳unionãڴ渴
+	//以下是之前的SimpleMemoryPoool的声明，但有更改，将init分离出来
+	//槽结构体：链表节点
+	//为什么选择struct而不是union：是为了兼容后续的并发编程，在但线程中用union更好，可以内存复用
 	struct SimpleSlot
 	{
 		SimpleSlot* next;
@@ -90,41 +90,41 @@ namespace HashBucketMemoryPool
 	class SimpleMemoryPool {
 	public:
 
-		// 캯ָÿϵͳڴС
+		// 构造函数：指定每次向系统申请的内存块大小
 		SimpleMemoryPool(size_t blockSize = 4096);
-		// ͷѷĴڴ
+		// 析构函数：释放所有已分配的大内存块
 		~SimpleMemoryPool();
 
-		//׶γʼƣò۴С׼ڴ
+		//用于两阶段初始化的设计，设置槽大小并准备内存池
 		void init(size_t slotSize);
 
-		// ڴطһڴۣ void* ָ
+		// 从内存池分配一个内存槽，返回 void* 指针
 		void* allocate();
 
-		// һڴ۹黹ڴ
+		// 将一个内存槽归还给内存池
 		void deallocate(void*);
 
 	private:
-		//ϵͳһµĴڴ飬׼иɲ
+		//向系统申请一个新的大内存块，并准备将其切割成槽
 		void allocateNewBlock();
 
-		// p ڴʼַalign һַС루ֵ
-		// ȷ¿иĲ۵ַǶ
+		// p 是内存的起始地址，align 是其与下一个地址的最小距离（即对齐值）
+		// 确保从新块中切割出的槽地址是对齐的
 		size_t padPointer(char* p, size_t align);
 
-		// һͷ
+		// 将一个槽推入空闲链表头部
 		void pushFreeList(SimpleSlot* slot);
-		// ӿͷȡһ
+		// 从空闲链表头部取出一个槽
 		SimpleSlot* popFreeList();
 
 	private:
-		size_t                 BlockSize_;		// ڴС
-		size_t                 SlotSize_;		// ۴С
+		size_t                 BlockSize_;		// 内存块大小
+		size_t                 SlotSize_;		// 槽大小
 
-		SimpleSlot* firstBlock_;				// ָڴع׸ʵڴ
-		char* curSlot_;							// ָǰʹõĴڴУһֱӷȥ²۵ʼλ
-		SimpleSlot* freeList_;					// ָвͷűʹùֱͷŵĲۣ
-		char* lastSlot_;						// ΪǰڴܹԪصλñʶ(λµڴ)
+		SimpleSlot* firstBlock_;				// 指向内存池管理的首个实际内存块
+		char* curSlot_;							// 指向当前正在使用的大内存块中，下一个可直接分配出去的新槽的起始位置
+		SimpleSlot* freeList_;					// 指向空闲槽链表的头部（存放被使用过后又被释放的槽）
+		char* lastSlot_;						// 作为当前内存块中最后能够存放元素的位置标识(超过该位置需申请新的内存块)
 	};
 
 }
\ No newline at end of file
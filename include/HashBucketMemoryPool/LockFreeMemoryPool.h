@@ -14,7 +14,7 @@ namespace LockFreeMemoryPool
 		SLOT_BASE_SIZE = 8,
 		MAX_SLOT_SIZE = 512,
 		MEMORY_POOL_NUM = MAX_SLOT_SIZE / SLOT_BASE_SIZE,
-		BLOCK_SIZE_DEFAULT = 4096//ĬϵĿС
+		BLOCK_SIZE_DEFAULT = 4096//默认的块大小
 	};
 
 	struct SimpleSlot
@@ -26,9 +26,9 @@ namespace LockFreeMemoryPool
 	{
 		SimpleSlot* ptr;
 		unsigned int tag;
-		// ֽڣȷ TagAtomicSlot ܴС 16 ֽ ( 64 λϵͳ)
-		// 64λϵͳ: ptr (8ֽ) + tag (4ֽ) + 4ֽ = 16ֽ
-		char padding[4];
+		// 填充字节，确保 TagAtomicSlot 总大小是 16 字节 (在 64 位系统上)
+		// 64位系统: ptr (8字节) + tag (4字节) + 4字节填充 = 16字节
+		char padding[4] = {};
 
 		bool operator==(const TagAtomicSlot& other)const
 		{
@@ -59,7 +59,7 @@ namespace LockFreeMemoryPool
 
 		size_t padPointer(char* p, size_t align);
 
-		//ʹCASӺͳ
+		//使用CAS操作进行无锁入队和出队
 		bool pushFreeList(SimpleSlot* slot);
 
 		SimpleSlot* popFreeList();
@@ -69,7 +69,7 @@ namespace LockFreeMemoryPool
 		size_t						SlotSize_;
 		SimpleSlot*					firstBlock_;
 		char* curSlot_;
-		std::atomic<TagAtomicSlot>	freeList_;//ڴԭӻ
+		std::atomic<TagAtomicSlot>	freeList_;//在此原子化
 		char* lastSlot_;
 		std::mutex					mutexForBlock_;
 	};
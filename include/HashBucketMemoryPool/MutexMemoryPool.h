@@ -14,7 +14,7 @@ namespace MutexMemoryPool
 		SLOT_BASE_SIZE = 8,
 		MAX_SLOT_SIZE = 512,
 		MEMORY_POOL_NUM = MAX_SLOT_SIZE / SLOT_BASE_SIZE,
-		BLOCK_SIZE_DEFAULT = 4096//ĬϵĿС
+		BLOCK_SIZE_DEFAULT = 4096//默认的块大小
 	};
 
 	struct SimpleSlot
@@ -52,8 +52,8 @@ namespace MutexMemoryPool
 		char*				curSlot_;
 		SimpleSlot*			freeList_;
 		char*				lastSlot_;
-		std::mutex			mutexForFreeList_;//֤freeList_ڶ߳вԭ
-		std::mutex			mutexForBlock_;//֤߳±ⲻҪظڴ浼µ˷Ϊ
+		std::mutex			mutexForFreeList_;//保证freeList_在多线程中操作的原子性
+		std::mutex			mutexForBlock_;//保证多线程情况下避免不必要的重复开辟内存导致的浪费行为
 	};
 
 	class HashBucket
@@ -70,7 +70,7 @@ namespace MutexMemoryPool
 		friend void deleteElement(T* p);
 
 	private:
-		//鱾Ǿ̬ģָĬϳʼΪ nullptr
+		//数组本身是静态的，指针默认初始化为 nullptr
 		static SimpleMemoryPool* _s_pool_instances[static_cast<size_t>(HashBucketConstants::MEMORY_POOL_NUM)];
 
 		static SimpleMemoryPool& getPoolInstance(size_t index);
@@ -1,61 +1,89 @@
 #pragma once
 #include <atomic>
 #include <optional>
+#include <utility>
 //#include "../list.h"
 #include "../span.h"
 #include "../byte.h"
 //#include "../map.h"
 #include "TCMallocutils.h"
+#include "NumaTopology.h"
 namespace mystl
 {
-	//ǰ listΪ allocate() ķֵҪ
-	template<typename T> class list;
-
-	//PIMPLʵǰ
+	//PIMPL实现类的前向声明
 	class CentralCacheImpl;
+	struct allocator_stats;
 
 	class central_cache
 	{
 	public:
-		//һ8ҳĿռ
+		//一次性申请8页的空间
 		static constexpr size_t PAGE_SPAN = 8;
+		//每个 NUMA 节点一个，span 都从同一节点的 PageCache 申请
+		static central_cache& get_instance(size_t node)
+		{
+			assert(node < numa_topology::MAX_NODES);
+			return instances(std::make_index_sequence<numa_topology::MAX_NODES>())[node];
+		}
+
+		//当前线程所在节点的中心缓存
 		static central_cache& get_instance()
 		{
-			static central_cache instance;
-			return instance;
+			return get_instance(numa_topology::current_node());
 		}
 
-		//ڷָָСĿռ
-		//memory_size:ҪĴСblock_count:ĸ
-		//һͬСָڴ
-		std::optional<list<span<byte>>> allocate(size_t memory_size, size_t block_count);
+		//用于分配指向个数的指向大小的空间
+		//memory_size:要申请的大小，block_count:申请的个数
+		//返回一组相同大小的指定个数的内存块
+		std::optional<free_list> allocate(size_t memory_size, size_t block_count);
+
+		//回收内存块，所有的块都必须属于这个节点
+		//memories:从线程缓存池中回收的内存碎片，memory_size:每一块的大小
+		void deallocate(free_list memories, size_t memory_size);
 
-		// ĺֻһڴ飬ڴƳʼ
-		std::optional<span<byte>> allocate_single(size_t memory_size);
+		//别的节点上的线程归还属于这个节点的内存块
+		//只把整条链表挂到这一级的无锁队列上，不碰这个节点的锁，下次这个节点用到这一级时再真正回收
+		void deallocate_remote(free_list memories, size_t memory_size);
 
-		//ڴ
-		//memories:̻߳лյڴƬ
-		void deallocate(list<span<byte>> memories);
+		//统计每一级的span和空闲块
+		void collect_stats(allocator_stats& stats);
 
 		~central_cache();
 
 	private:
-		central_cache();
+		explicit central_cache(size_t node);
+
+		//所有节点的中心缓存，只有编号小于 node_count() 的会真正创建内部数据
+		template<size_t... Nodes>
+		static central_cache* instances(std::index_sequence<Nodes...>)
+		{
+			static central_cache result[] = { central_cache(Nodes)... };
+			return result;
+		}
+
+		//把块挂回所属 span 自己的空闲链表，整个 span 都空闲时直接还给 PageCache，调用时必须持有这一级的锁
+		void release_blocks(free_list& memories, size_t index);
 
-		//¼䵽TreadCacheڴ
-		void record_allocate_memory_span(span<byte> memory);
+		//回收别的节点挂在这一级队列上的块，调用时必须持有这一级的锁
+		void drain_remote(size_t index);
+
+		//从PageCache申请一个新的span，挂到这一级占用率最低的分组，调用时必须持有这一级的锁
+		bool add_span(size_t index);
 
 		std::optional<span<byte>> get_page_from_page_cache(size_t page_allocate_count);
 
 		/*
-		list<span<byte>> m_free_array[size_utils::CACHE_LINE_SIZE];
-		std::atomic_flag m_status[size_utils::CACHE_LINE_SIZE];
-
-		map<byte*, page_span> m_page_set[size_utils::CACHE_LINE_SIZE];
+		page_span* m_spans[size_utils::SIZE_CLASS_COUNT][OCCUPANCY_BUCKETS];
+		std::atomic_flag m_status[size_utils::SIZE_CLASS_COUNT];
+		size_t m_span_count[size_utils::SIZE_CLASS_COUNT];
+		size_t m_free_count[size_utils::SIZE_CLASS_COUNT];
 		*/
 
-		//ָԱ
+		//指针成员
 		CentralCacheImpl* pimpl;
 
+		//所属的 NUMA 节点
+		size_t m_node;
+
 	};
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include <optional>
+#include "TCMallocutils.h"
+namespace mystl
+{
+	//PIMPL实现类的前向声明
+	class CpuCacheImpl;
+	struct allocator_stats;
+
+	//按CPU划分的前端缓存，可以替代ThreadCache
+	//线程很多但大多空闲的服务里，缓存的内存随核数增长而不是随线程数增长
+	//Linux下通过glibc注册的rseq区域直接读取当前CPU编号，不需要系统调用
+	//拿不到CPU编号时（非Linux、glibc没有注册rseq）自动退回ThreadCache
+	class cpu_cache
+	{
+	public:
+		//每个CPU每一级最多缓存的字节数
+		static constexpr size_t MAX_FREE_BYTES_PER_LISTS = 256 * 1024;
+
+		static cpu_cache& get_instance()
+		{
+			static cpu_cache instance;
+			return instance;
+		}
+
+		//当前线程能不能拿到CPU编号
+		static bool is_available();
+
+		//向内存池申请一块内存
+		std::optional<void*> allocate(size_t memory_size);
+
+		//申请一块起始地址按 alignment 对齐的内存，规则和 thread_cache::allocate_aligned 相同
+		std::optional<void*> allocate_aligned(size_t memory_size, size_t alignment);
+
+		//申请一块全是零的内存，规则和 thread_cache::allocate_zeroed 相同
+		std::optional<void*> allocate_zeroed(size_t memory_size);
+
+		//向内存池归还一片空间
+		void deallocate(void* start_p, size_t memory_size);
+
+		//不带大小的归还，通过 page_map 找到块的大小
+		void deallocate(void* start_p);
+
+		//把所有CPU缓存的块还给各自节点的TransferCache，返回还回去的字节数
+		//page_cache::release_free_memory 和 thread_cache::request_flush_all 会调用它
+		size_t drain();
+
+		//统计所有CPU缓存的字节数
+		void collect_stats(allocator_stats& stats);
+
+		~cpu_cache();
+
+	private:
+		cpu_cache();
+
+		//当前线程所在的CPU，拿不到时返回-1
+		static int current_cpu();
+
+		//不经过采样的分配，cpu 是当前线程所在的CPU
+		std::optional<void*> allocate_unsampled(size_t memory_size, int cpu);
+
+		//到了采样点的分配，分配完以后交给 heap_profiler 记录
+		std::optional<void*> allocate_sampled(size_t memory_size, int cpu);
+
+		//直接向页面缓存申请的大块在分配完以后补上采样
+		static void sample_large_allocation(void* address, size_t requested_size, size_t allocated_size);
+
+		/*
+		struct cpu_slot
+		{
+			std::atomic_flag status;
+			free_list free_cache[size_utils::SIZE_CLASS_COUNT];
+		};
+		cpu_slot* m_slots;
+		size_t m_cpu_count;
+		*/
+
+		//指针成员
+		CpuCacheImpl* pimpl;
+	};
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include "TCMallocutils.h"
+namespace mystl
+{
+	//PIMPL实现类的前向声明
+	class HeapProfilerImpl;
+
+	//采样堆分析器
+	//平均每分配 sample_rate 字节（按泊松过程）采样一次，记录调用栈、大小和时间
+	//采样记录放在单独向系统映射的表里，不占用分配器自己的内存
+	//可以输出 pprof 能够读取的文本格式（heap_v2）
+	class heap_profiler
+	{
+	public:
+		//调用栈最多记录多少层
+		static constexpr size_t MAX_STACK_DEPTH = 32;
+		//最多同时保留多少条采样记录
+		static constexpr size_t MAX_SAMPLES = 1 << 14;
+		//关闭采样时，每分配这么多字节重新检查一次是否打开了采样
+		static constexpr size_t RECHECK_INTERVAL = 1024 * 1024;
+
+		//一条采样记录
+		struct sample
+		{
+			void* address;
+			//用户申请的大小，和实际分配的块大小
+			size_t requested_size;
+			size_t allocated_size;
+			//steady_clock 的纳秒数
+			uint64_t timestamp;
+			size_t depth;
+			void* stack[MAX_STACK_DEPTH];
+		};
+
+		static heap_profiler& get_instance()
+		{
+			static heap_profiler instance;
+			return instance;
+		}
+
+		//设置平均采样间隔（字节），0 表示关闭采样
+		static void set_sample_rate(size_t sample_rate);
+		static size_t get_sample_rate();
+
+		//按当前的采样率生成下一次采样前还要分配的字节数，rng_state 是调用方自己的随机数状态
+		static size_t next_sample_interval(uint64_t& rng_state);
+
+		//当前有没有仍然存活的采样记录，归还内存时先用它判断要不要查表
+		static bool has_samples()
+		{
+			return s_live_samples.load(std::memory_order_relaxed) != 0;
+		}
+
+		//记录一次被采样的分配
+		void record_allocation(void* address, size_t requested_size, size_t allocated_size);
+
+		//被采样的内存被释放时删除记录，不是采样过的地址什么也不做
+		void record_deallocation(void* address);
+
+		//复制当前存活的采样记录，返回复制的条数
+		size_t snapshot(sample* samples, size_t max_count);
+
+		//输出 pprof 文本格式的堆分析结果，多个线程同时调用时依次输出
+		void dump(std::ostream& os);
+
+		~heap_profiler();
+
+	private:
+		heap_profiler();
+
+		static inline std::atomic<size_t> s_sample_rate{ 0 };
+		static inline std::atomic<size_t> s_live_samples{ 0 };
+
+		//指针成员
+		HeapProfilerImpl* pimpl;
+	};
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "TCMallocutils.h"
+namespace mystl
+{
+	namespace detail
+	{
+		//直接向系统申请一块清零的内存，失败返回 nullptr
+		void* metadata_allocate_chunk(size_t size);
+	}
+
+	//分配器内部元数据（空闲页段、大块记录等）专用的对象池
+	//按块直接向系统申请，释放的对象放进侵入式空闲链表重复使用，内存永远不还给系统
+	//不经过 mystl::allocator，所以不会重新进入分配器；也不加锁，由调用者保证互斥
+	template<typename T>
+	class metadata_arena
+	{
+	public:
+		//一次向系统申请的字节数
+		static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+		metadata_arena() = default;
+		metadata_arena(const metadata_arena&) = delete;
+		metadata_arena& operator=(const metadata_arena&) = delete;
+
+		//构造一个对象，系统内存不足时返回 nullptr
+		template<typename... Args>
+		T* create(Args&&... args)
+		{
+			void* memory = allocate();
+			if (memory == nullptr)
+			{
+				return nullptr;
+			}
+			return new(memory) T(std::forward<Args>(args)...);
+		}
+
+		void destroy(T* object)
+		{
+			object->~T();
+			m_free.push(object);
+		}
+
+		//预先准备好至少 count 个空闲对象，之后 count 次 create 一定成功，系统内存不足时返回 false
+		//调用者在拆开已有记录之前先预留，失败时还什么都没改
+		bool reserve(size_t count)
+		{
+			while (m_free.size() < count)
+			{
+				void* memory = carve();
+				if (memory == nullptr)
+				{
+					return false;
+				}
+				m_free.push(memory);
+			}
+			return true;
+		}
+
+		//系统内存不足时把调用者的一段可写内存切成对象放进空闲链表，这段内存从此归对象池所有
+		void donate(span<byte> memory)
+		{
+			byte* next = reinterpret_cast<byte*>(size_utils::align(reinterpret_cast<uintptr_t>(memory.data()), OBJECT_ALIGNMENT));
+			byte* end = memory.data() + memory.size();
+			for (; next + OBJECT_SIZE <= end; next += OBJECT_SIZE)
+			{
+				m_free.push(next);
+			}
+		}
+
+	private:
+		//空闲的对象里要能放下一个指针
+		static constexpr size_t OBJECT_ALIGNMENT = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+		static constexpr size_t OBJECT_SIZE = ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + OBJECT_ALIGNMENT - 1) & ~(OBJECT_ALIGNMENT - 1);
+		static_assert(OBJECT_SIZE <= CHUNK_SIZE, "metadata object is larger than an arena chunk");
+
+		void* allocate()
+		{
+			if (!m_free.empty())
+			{
+				return m_free.pop();
+			}
+			return carve();
+		}
+
+		//从当前的块里切出一个对象，不够时再向系统申请一块
+		void* carve()
+		{
+			if (m_remaining < OBJECT_SIZE)
+			{
+				m_next = static_cast<byte*>(detail::metadata_allocate_chunk(CHUNK_SIZE));
+				if (m_next == nullptr)
+				{
+					m_remaining = 0;
+					return nullptr;
+				}
+				m_remaining = CHUNK_SIZE;
+			}
+			void* result = m_next;
+			m_next += OBJECT_SIZE;
+			m_remaining -= OBJECT_SIZE;
+			return result;
+		}
+
+		free_list m_free;
+		byte* m_next = nullptr;
+		size_t m_remaining = 0;
+	};
+}
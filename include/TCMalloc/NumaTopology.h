@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include "../span.h"
+#include "../byte.h"
+namespace mystl
+{
+	//NUMA 拓扑：有几个节点、每个CPU属于哪个节点，以及把一段内存绑定到某个节点
+	//PageCache、CentralCache 和 TransferCache 每个节点各有一份，线程从自己所在节点的那一份申请内存
+	//只在 Linux 上读取 /sys/devices/system/node，其它平台或者只有一个节点的机器上退化成单节点，行为和以前完全一样
+	//环境变量 MYSTL_TCMALLOC_NUMA_NODES=n 可以强制使用 n 个节点：n 为 1 时关闭 NUMA，
+	//大于 1 时按 CPU 编号取模模拟多个节点（不绑定内存），用来在普通机器上测试多节点的路径
+	class numa_topology
+	{
+	public:
+		//最多支持的节点数，更多的节点按编号取模合并
+		static constexpr size_t MAX_NODES = 8;
+		//能查到所属节点的 CPU 个数上限，编号更大的 CPU 算在节点 0
+		static constexpr size_t MAX_CPUS = 1024;
+
+		//节点个数，至少是 1
+		static size_t node_count();
+
+		//某个 CPU 所在的节点，cpu 为负数时返回 0
+		static size_t node_of_cpu(int cpu);
+
+		//当前线程正在运行的 CPU 所在的节点，单节点时直接返回 0
+		static size_t current_node();
+
+		//让这段内存的物理页从 node 节点分配（MPOL_PREFERRED，节点内存不够时仍可从别的节点分配）
+		//必须在第一次访问之前调用；单节点或者模拟的节点什么都不做
+		static void bind_memory(span<byte> memory, size_t node);
+	};
+}
@@ -1,64 +1,202 @@
 #pragma once
 #include <atomic>
-//#include "../map.h"
 #include "../span.h"
-//#include "../set.h"
-//#include "../vector.h"
 #include "TCMallocutils.h"
+#include "NumaTopology.h"
 #include <optional>
 #include <mutex>
+#include <utility>
 namespace mystl
 {
-	//PIMPLʵǰ
+	//PIMPL实现类的前向声明
 	class PageCacheImpl;
+	struct allocator_stats;
+
+	//空闲页面的物理内存状态，不同状态的页段不合并
+	enum class page_state : unsigned char
+	{
+		//仍然占着物理内存
+		committed,
+		//物理内存已经归还给系统
+		released,
+		//映射以后还没有访问过，不占物理内存，内容一定是零
+		untouched,
+	};
+
+	//页面缓存中的一段连续空闲页面，也用来记录向系统申请的一整块区域
+	//对象本身从元数据池中申请，按页数挂在分桶的双向链表上
+	//空闲页段的首页和尾页登记在 page_map 里，回收页面时据此找到相邻的空闲页段
+	struct page_run
+	{
+		byte* start = nullptr;
+		size_t page_count = 0;
+		//物理内存的状态
+		page_state state = page_state::committed;
+		//整段页面确定全是零，calloc 可以省掉清零
+		bool zeroed = false;
+		//挂在哪个节点的 PageCache 上，不同节点的页段即使地址相邻也不合并
+		size_t node = 0;
+		page_run* prev = nullptr;
+		page_run* next = nullptr;
+
+		page_run(byte* run_start, size_t run_page_count, page_state run_state, bool run_zeroed)
+			: start(run_start), page_count(run_page_count), state(run_state), zeroed(run_zeroed) {}
+
+		byte* end() const
+		{
+			return start + page_count * size_utils::PAGE_SIZE;
+		}
+
+		span<byte> memory() const
+		{
+			return span<byte>(start, page_count * size_utils::PAGE_SIZE);
+		}
+	};
 
 	class page_cache
 	{
 	public:
 		static constexpr size_t PAGE_ALLOCATE_COUNT = 2048;
+		//大块内存达到这个大小以后单独向系统映射，释放时直接归还给系统
+		static constexpr size_t LARGE_MMAP_THRESHOLD = 1024 * 1024;
+		//空闲页面默认最多占着这么多物理内存，超过的部分归还给系统
+		static constexpr size_t DEFAULT_RELEASE_BUDGET = 64 * 1024 * 1024;
+		//大页的大小。定义 MYSTL_TCMALLOC_HUGE_PAGES 后（仅 Linux），向系统申请的区域按大页对齐并标记 MADV_HUGEPAGE，
+		//再定义 MYSTL_TCMALLOC_HUGETLB 会先尝试 MAP_HUGETLB 预留的大页；归还物理内存时只归还完整的大页
+		//小于一个大页的申请优先从已经分出去页数最多的大页里切，page_map 记录每个大页分出去的页数
+		static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+		//每个 NUMA 节点一个页面堆，单节点的机器上只用到节点 0
+		static page_cache& get_instance(size_t node) {
+			assert(node < numa_topology::MAX_NODES);
+			return instances(std::make_index_sequence<numa_topology::MAX_NODES>())[node];
+		}
+
+		//当前线程所在节点的页面堆
 		static page_cache& get_instance() {
-			static page_cache instance;
-			return instance;
+			return get_instance(numa_topology::current_node());
+		}
+
+		//这个页面堆所属的节点
+		size_t node() const {
+			return m_node;
 		}
 
-		// ָҳڴ
-		// ҳ
-		std::optional<span<byte>> allocate_page(size_t page_count);
+		// 申请指定页数的内存
+		// 参数：申请的页数；zeroed 不为空时写入这段页面是否确定全是零
+		std::optional<span<byte>> allocate_page(size_t page_count, bool* zeroed = nullptr);
 
-		// ָҳڴ
+		// 回收指定页数的内存
 		void deallocate_page(span<byte> page);
 
-		static std::optional<span<byte>> allocate_unit(size_t memory_size);
+		// 申请一个超过 MAX_CACHED_UNIT_SIZE 的大块，按页向上取整，从当前线程所在的节点申请
+		// 小于 LARGE_MMAP_THRESHOLD 的从页面缓存中切出整段页面，否则单独 mmap
+		// 大块会登记到 page_map，之后可以按地址找到它的大小
+		// zeroed 不为空时写入这块内存是否确定全是零
+		static std::optional<span<byte>> allocate_unit(size_t memory_size, bool* zeroed = nullptr);
 
-		// һԪڴ棬ڻճڴ
+		// 回收一个单元的内存，用于回收超大块内存
+		// 只用到起始地址，真实大小和所属节点从登记的记录中取得
 		static void deallocate_unit(span<byte> memories);
 
-		// رڴ
-		void stop();
+		// 原地调整一个大块的大小，new_size 必须超过 MAX_CACHED_UNIT_SIZE
+		// 从页面缓存切出来的大块吞并后面相邻的空闲页面来增长，缩小时把多余的页面还回去
+		// 单独映射的大块用 mremap 调整（仅 Linux），这时起始地址可能改变
+		// 做不到时返回 nullopt，原来的块保持不变
+		static std::optional<span<byte>> reallocate_unit(span<byte> memories, size_t new_size);
+
+		// 申请一个起始地址按 alignment 对齐的大块，alignment 必须是 2 的幂
+		// 不超过一页的对齐和 allocate_unit 一样；更大的对齐从页面缓存中多切一些页面，再把两端不用的部分放回去
+		// 同样通过 deallocate_unit 回收
+		static std::optional<span<byte>> allocate_unit_aligned(size_t memory_size, size_t alignment);
+
+		// 设置空闲页面保留的物理内存上限，超出的部分在回收页面时归还给系统（每个节点分别计算）
+		void set_release_budget(size_t budget);
+
+		// 立即把所有空闲页面的物理内存归还给系统，返回归还的字节数
+		// 会先清空按CPU的缓存和这个节点的 TransferCache，让它们缓存的块所在的空 span 也能一起归还
+		size_t release_free_memory();
+
+		// 统计映射、空闲和大块的字节数
+		void collect_stats(allocator_stats& stats);
+
+		// 关闭内存池，把所有区域还给系统
+		// 还有页面在使用时（包括线程缓存、中心缓存手里的块）什么都不做并返回 false，否则这些块会指向已经解除映射的内存
+		bool stop();
 
 		~page_cache();
 
 	private:
-		page_cache();
+		explicit page_cache(size_t node);
+
+		//所有节点的页面堆，只有编号小于 node_count() 的会真正创建内部数据
+		template<size_t... Nodes>
+		static page_cache* instances(std::index_sequence<Nodes...>) {
+			static page_cache result[] = { page_cache(Nodes)... };
+			return result;
+		}
 
-		// ֻ룬գֻʱ
+		// 只申请，不回收，只有在销毁时回收；多节点时绑定到这个页面堆的节点
 		std::optional<span<byte>> system_allocate_memory(size_t page_count);
 
-		/// ڴ棬ֻе
+		/// 回收内存，只有在析构函数中调用
 		void system_deallocate_memory(span<byte> page);
 
+		// 解除所有区域和单独映射的大块，调用者持有锁
+		void unmap_all();
+
+		// 把物理内存还给系统，虚拟地址仍然保留
+		void system_release_memory(span<byte> page);
+
+		// 重新提交已经归还的内存，POSIX 下第一次访问时由内核补页，不需要做任何事
+		void system_commit_memory(span<byte> page);
+
+		// 从空闲页段中切出或向系统申请 page_count 页，调用时必须持有 m_mutex
+		// state 和 zeroed 写入这段页面原来的状态，是 released 时由调用者重新提交用到的部分
+		std::optional<span<byte>> take_pages(size_t page_count, page_state& state, bool& zeroed);
+
+		// 申请起始地址按 alignment（大于一页）对齐的 page_count 页
+		std::optional<span<byte>> allocate_aligned_page(size_t page_count, size_t alignment);
+
+		// 把大块登记到 large_spans 和 page_map，元数据池耗尽时返回 false
+		bool register_large_unit(span<byte> memory, bool dedicated);
+
+		// 把空闲页面的物理内存归还到预算以内，从最大的空闲段开始，调用时必须持有 m_mutex
+		size_t release_to_budget(size_t budget);
+
+		// 把一段空闲页面放进分桶，并与相邻的同状态空闲页段合并，调用时必须持有 m_mutex
+		// 合并后只有两边都是零，整段才算是零
+		// 会新建记录的调用者要先用 run_arena.reserve 预留，只有归还占着物理内存的页面时可以不预留：
+		// 元数据池耗尽时拿这段页面的第一页充当记录，计入 metadata_bytes，整段只有一页时返回 nullptr
+		page_run* insert_free_run(span<byte> page, page_state state, bool zeroed);
+
 		/*
-		mystl::map<size_t, mystl::set<span<byte>>> free_page_store;
-		mystl::map<byte*, span<byte>> free_page_map;
-		// ڻʱ munmap
-		mystl::vector<span<byte>> page_vector;
+		// 按页数分桶的空闲页段，按 page_state 分成三组
+		// 1~128 页每个页数一个桶，更大的按 2 的幂分组
+		page_run* free_lists[STATE_COUNT][BUCKET_COUNT];
+		// 非空桶的位图，找不小于某个页数的空闲页段只需要找下一个置位的桶
+		uint64_t nonempty_buckets[STATE_COUNT][BITMAP_WORDS];
+		// 向系统申请的区域，用于回收时 munmap
+		page_run* regions;
+		// 正在使用中的大块，page_map 指向这里的记录
+		large_span_record* large_spans;
+		// 上面这些记录都从元数据池中申请
+		metadata_arena<page_run> run_arena;
+		metadata_arena<large_span_record> large_arena;
+		size_t free_committed_bytes = 0;
+		size_t released_bytes = 0;
+		size_t untouched_bytes = 0;
+		size_t metadata_bytes = 0;
 		*/
 
 		PageCacheImpl* pimpl;
 
-		// ʾǰڴǲѾر
+		// 所属的 NUMA 节点
+		size_t m_node;
+		// 表示当前的内存池是不是已经关闭了
 		bool m_stop = false;
-		// 
+		// 空闲页面保留物理内存的上限
+		size_t m_release_budget = DEFAULT_RELEASE_BUDGET;
+		// 并发控制
 		std::mutex m_mutex;
 	};
 
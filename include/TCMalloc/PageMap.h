@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "TCMallocutils.h"
+#include "../span.h"
+#include "../byte.h"
+
+namespace mystl
+{
+	struct page_run;
+
+	//页号 -> 所属 page_span 的基数树（radix tree）
+	//释放一个内存块时，只需要按页号逐层下标访问就能找到它所在的 page_span，
+	//不用再在 map 里做 upper_bound 的红黑树查找，读操作也不需要加锁
+	class page_map
+	{
+	public:
+		//一个页面是 4K，页内偏移占 12 位
+		static constexpr size_t PAGE_SHIFT = 12;
+		//64 位系统的用户态地址只用到低 48 位
+		static constexpr size_t ADDRESS_BITS = sizeof(void*) == 8 ? 48 : 32;
+		//页号的位数
+		static constexpr size_t PAGE_NUMBER_BITS = ADDRESS_BITS - PAGE_SHIFT;
+		//三层：根 / 中间 / 叶子，64 位下各占 12 位
+		static constexpr size_t LEAF_BITS = PAGE_NUMBER_BITS / 3;
+		static constexpr size_t MIDDLE_BITS = PAGE_NUMBER_BITS / 3;
+		static constexpr size_t ROOT_BITS = PAGE_NUMBER_BITS - LEAF_BITS - MIDDLE_BITS;
+
+		static constexpr size_t LEAF_LENGTH = size_t(1) << LEAF_BITS;
+		static constexpr size_t MIDDLE_LENGTH = size_t(1) << MIDDLE_BITS;
+		static constexpr size_t ROOT_LENGTH = size_t(1) << ROOT_BITS;
+
+		static_assert((size_t(1) << PAGE_SHIFT) == size_utils::PAGE_SIZE, "PAGE_SHIFT must match size_utils::PAGE_SIZE");
+
+		//透明大页是 2M，一个叶子覆盖整数个大页
+		static constexpr size_t HUGE_PAGE_SHIFT = 21;
+		static constexpr size_t PAGES_PER_HUGE_PAGE = size_t(1) << (HUGE_PAGE_SHIFT - PAGE_SHIFT);
+		static_assert(LEAF_LENGTH % PAGES_PER_HUGE_PAGE == 0, "a leaf must cover whole huge pages");
+
+		static page_map& get_instance()
+		{
+			static page_map instance;
+			return instance;
+		}
+
+		//查找某个地址所在的 page_span，没有登记过则返回 nullptr
+		//无锁：只读取已经发布的节点
+		page_span* get(const void* address) const;
+
+		//把 pages 覆盖的每一页都指向 owner
+		//写操作需要由调用者保证同一段页面不会被并发登记
+		void set(span<byte> pages, page_span* owner);
+
+		//取消 pages 覆盖的每一页的登记
+		void clear(span<byte> pages);
+
+		//page_cache 用来登记空闲页段的首页和尾页，合并相邻的空闲页段时按页号查找
+		//只在持有页面所属的那个 page_cache 的锁时访问
+		page_run* get_run(const void* address) const;
+		void set_run(const void* address, page_run* run);
+
+		//没有登记给任何 page_cache 的页面
+		static constexpr size_t NO_NODE = static_cast<size_t>(-1);
+
+		//页面属于哪个节点的 page_cache，区域映射时登记、解除映射时取消，中间不会改变
+		//合并相邻的空闲页段之前先用它确认相邻的页面是自己的，不去读别的节点的 page_run；无锁读取
+		size_t get_run_node(const void* address) const;
+		void set_run_node(span<byte> pages, size_t node);
+
+		//开启大页时 page_cache 记录每个大页里已经分出去的页数，挑空闲页段时优先挤进用得多的大页
+		//和 get_run 一样只在持有页面所属的那个 page_cache 的锁时访问
+		size_t get_huge_used(const void* address) const;
+		void add_huge_used(span<byte> pages, bool used);
+
+		~page_map();
+
+	private:
+		page_map();
+
+		struct leaf_node
+		{
+			std::atomic<page_span*> spans[LEAF_LENGTH];
+			page_run* runs[LEAF_LENGTH];
+			//节点编号加 1，0 表示没有登记
+			std::atomic<unsigned char> run_nodes[LEAF_LENGTH];
+			//叶子里每个大页已经分出去的页数
+			uint16_t huge_used[LEAF_LENGTH / PAGES_PER_HUGE_PAGE];
+		};
+
+		struct middle_node
+		{
+			std::atomic<leaf_node*> leaves[MIDDLE_LENGTH];
+		};
+
+		static uintptr_t page_number(const void* address)
+		{
+			return reinterpret_cast<uintptr_t>(address) >> PAGE_SHIFT;
+		}
+
+		//沿途缺失的节点会被创建，返回叶子节点
+		leaf_node* ensure_leaf(uintptr_t number);
+
+		//只查找，不创建，不存在时返回 nullptr
+		leaf_node* find_leaf(uintptr_t number) const;
+
+		//节点直接向系统申请，不能走 mystl::allocator，否则会重新进入分配器
+		static void* system_allocate_node(size_t size);
+
+		std::atomic<middle_node*> m_root[ROOT_LENGTH];
+	};
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+namespace mystl
+{
+	//TCMalloc 层对外的申请/释放入口，mystl::allocator（定义 MYSTL_ALLOCATOR_USE_TCMALLOC 后）和替换 malloc/operator new 的
+	//TCMallocOverride.cpp 都调用这里，按CPU缓存、线程缓存和线程退出阶段的处理只有这一份实现
+	//分配器自己正在运行（构造单例、采样记录）或者线程缓存已经析构时，请求转给系统分配器，
+	//释放时按 page_map 区分两种来源，所以不会重新进入分配器，也不会把系统的内存还给线程缓存
+
+	//申请 size 字节，size 为 0 时按 1 处理，失败或者超过 PTRDIFF_MAX 时返回 nullptr
+	void* tcmalloc_allocate(size_t size);
+
+	//申请 size 字节并清零，整段页面本来就是零的大块不再重复清零
+	void* tcmalloc_allocate_zeroed(size_t size);
+
+	//按 alignment（2 的幂）对齐申请，不合法的对齐值返回 nullptr
+	void* tcmalloc_allocate_aligned(size_t size, size_t alignment);
+
+	//释放 tcmalloc_allocate、tcmalloc_allocate_zeroed 或 tcmalloc_reallocate 得到的内存，真实大小从 page_map 中取得
+	void tcmalloc_deallocate(void* ptr);
+
+	//释放 tcmalloc_allocate_aligned 得到的内存
+	void tcmalloc_deallocate_aligned(void* ptr);
+
+	//调整大小，保留前 min(old_size, new_size) 个字节；同一级别内或者大块能原地扩展时不复制
+	//失败返回 nullptr，原来的内存保持不变
+	void* tcmalloc_reallocate(void* ptr, size_t old_size, size_t new_size);
+
+	//块的实际可用大小，不是本分配器的块返回 0
+	size_t tcmalloc_usable_size(void* ptr);
+}
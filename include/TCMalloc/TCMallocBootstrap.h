@@ -1,5 +1,35 @@
 #pragma once
+#include <cstddef>
+
+//替换了全局的分配函数以后，进程退出阶段（静态对象析构、stdio 刷新缓冲区）仍然会用到分配器里的内存，
+//所以这时 central_cache/page_cache 的单例在析构时不能释放任何资源
+//mystl::allocator 接入 TCMalloc 时也一样：比单例先构造的静态容器会在单例析构以后才归还内存
+#if defined(MYSTL_TCMALLOC_OVERRIDE) || defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC) || defined(MYSTL_ALLOCATOR_USE_TCMALLOC)
+#define MYSTL_TCMALLOC_IMMORTAL
+#endif
+
 namespace mystl {
-    //ǵκηǰڵǰ߳Ϲ죬˱־Ϊ
-    inline thread_local bool g_is_allocator_constructing = false;
+    //当前线程处在分配器自身调用链里的深度
+    //大于0时说明正在构造分配器的单例，或者正在操作分配器内部的 list/map/set，
+    //这时再来的分配请求不能进入 thread_cache，只能交给系统分配器，否则会无限递归或者自己锁死自己
+    inline thread_local size_t g_allocator_reentry_depth = 0;
+
+    //当前线程的 thread_cache 已经析构（线程退出阶段还有别的 thread_local 在释放内存）
+    inline thread_local bool g_thread_cache_destroyed = false;
+
+    inline bool is_allocator_reentrant() noexcept
+    {
+        return g_allocator_reentry_depth != 0;
+    }
+
+    //进入分配器时加一，离开作用域时自动减一
+    class allocator_reentry_guard
+    {
+    public:
+        allocator_reentry_guard() noexcept { ++g_allocator_reentry_depth; }
+        ~allocator_reentry_guard() { --g_allocator_reentry_depth; }
+
+        allocator_reentry_guard(const allocator_reentry_guard&) = delete;
+        allocator_reentry_guard& operator=(const allocator_reentry_guard&) = delete;
+    };
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include <ostream>
+#include "TCMallocutils.h"
+namespace mystl
+{
+	//某一个尺寸级别的统计
+	struct size_class_stats
+	{
+		//块大小
+		size_t unit_size = 0;
+		//CentralCache持有的span个数
+		size_t span_count = 0;
+		//CentralCache中空闲的块数
+		size_t central_free_blocks = 0;
+		//已经交给前端（线程缓存、CPU缓存、中转层或者用户）的块数
+		size_t central_allocated_blocks = 0;
+		//TransferCache中缓存的块数
+		size_t transfer_cached_blocks = 0;
+		//别的节点归还、还在远程回收队列里的块数
+		size_t remote_free_blocks = 0;
+		//前端向下申请的次数，其中直接从TransferCache拿到的次数
+		size_t refill_count = 0;
+		size_t transfer_hit_count = 0;
+		//前端向下归还的次数
+		size_t flush_count = 0;
+		//前端（线程缓存和CPU缓存）累计交给用户和从用户收回的块数，包括已经退出的线程
+		size_t alloc_count = 0;
+		size_t free_count = 0;
+	};
+
+	//整个TCMalloc层的统计快照
+	//各层的数据分别在各自的锁下读取，所以不同层之间不保证是同一时刻的
+	struct allocator_stats
+	{
+		//从系统映射的字节数（页面缓存的大块区域和单独映射的大块）
+		size_t mapped_bytes = 0;
+		//PageCache中的空闲字节数，其中已经把物理内存还给系统的字节数，和映射以后从来没有访问过的字节数
+		size_t page_free_bytes = 0;
+		size_t page_released_bytes = 0;
+		size_t page_untouched_bytes = 0;
+		//元数据池向系统要不到内存时，从空闲页面里拿去充当页段记录的字节数
+		size_t page_metadata_bytes = 0;
+		//正在使用中的大块
+		size_t large_allocated_bytes = 0;
+		size_t large_allocated_count = 0;
+		//CentralCache持有的span的总字节数，以及其中空闲块的字节数
+		size_t central_span_bytes = 0;
+		size_t central_free_bytes = 0;
+		//span切完以后剩下的尾巴，永远不会被分配出去
+		size_t fragmented_bytes = 0;
+		//TransferCache缓存的字节数
+		size_t transfer_cached_bytes = 0;
+		//各节点远程回收队列里的字节数
+		size_t remote_free_bytes = 0;
+		//所有线程缓存的字节数，以及线程缓存的个数
+		size_t thread_cached_bytes = 0;
+		size_t thread_cache_count = 0;
+		//所有CPU缓存的字节数
+		size_t cpu_cached_bytes = 0;
+		//NUMA 节点个数，下面各层的数据是所有节点的总和
+		size_t numa_node_count = 1;
+		//用户正在使用的字节数（按块大小计算）
+		size_t allocated_bytes = 0;
+
+		size_class_stats classes[size_utils::SIZE_CLASS_COUNT];
+	};
+
+	//收集各层的统计
+	allocator_stats get_allocator_stats();
+
+	//输出可读的统计报告
+	void print_allocator_stats(std::ostream& os);
+	void print_allocator_stats(std::ostream& os, const allocator_stats& stats);
+}
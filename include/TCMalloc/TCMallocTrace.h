@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+namespace mystl
+{
+	//分配器内部的事件类型
+	enum class trace_event_type : uint32_t
+	{
+		//向系统映射了一块新的区域
+		page_grow = 1,
+		//把空闲页面的物理内存还给了系统
+		page_release,
+		//回收的页面和相邻的空闲页面合并
+		page_coalesce,
+		//从页面缓存切出一段页面
+		span_allocate,
+		//一段页面回到页面缓存
+		span_deallocate,
+		//单独映射的大块
+		large_map,
+		large_unmap,
+		//分配失败
+		allocation_failure,
+	};
+
+	//一条事件记录
+	struct trace_event
+	{
+		uint64_t sequence;
+		uint64_t timestamp;
+		trace_event_type type;
+		const void* address;
+		size_t size;
+	};
+
+	//无锁的环形事件缓冲区，写满以后覆盖最旧的记录
+	//记录时只有一次 fetch_add 和几次原子写，不会申请内存，也不会加锁，可以在分配器的任何位置调用
+	//每个槽位带一个序号，读取时序号前后一致才认为这条记录是完整的
+	class trace_buffer
+	{
+	public:
+		//必须是2的幂
+		static constexpr size_t CAPACITY = 4096;
+
+		static trace_buffer& get_instance()
+		{
+			//常量初始化，不需要运行构造函数
+			static trace_buffer instance;
+			return instance;
+		}
+
+		void record(trace_event_type type, const void* address, size_t size);
+
+		//按时间顺序取出缓冲区中仍然有效的记录，返回取出的条数
+		size_t snapshot(trace_event* events, size_t max_count) const;
+
+		//输出可读的事件列表
+		void dump(std::ostream& os) const;
+
+		//事件类型的名称
+		static const char* get_type_name(trace_event_type type);
+
+	private:
+		constexpr trace_buffer() = default;
+
+		struct slot
+		{
+			//0 表示正在写入
+			std::atomic<uint64_t> sequence{ 0 };
+			std::atomic<uint64_t> timestamp{ 0 };
+			std::atomic<uint32_t> type{ 0 };
+			std::atomic<const void*> address{ nullptr };
+			std::atomic<size_t> size{ 0 };
+		};
+
+		static_assert((CAPACITY& (CAPACITY - 1)) == 0, "trace buffer capacity must be a power of two");
+
+		std::atomic<uint64_t> m_next{ 0 };
+		slot m_slots[CAPACITY];
+	};
+}
+
+//定义 MYSTL_TCMALLOC_TRACE 时记录分配器内部事件，否则不产生任何代码
+#if defined(MYSTL_TCMALLOC_TRACE)
+#define MYSTL_TCMALLOC_TRACE_EVENT(type, address, size) ::mystl::trace_buffer::get_instance().record(::mystl::trace_event_type::type, (address), (size))
+#else
+#define MYSTL_TCMALLOC_TRACE_EVENT(type, address, size) ((void)0)
+#endif
@@ -2,89 +2,439 @@
 #include "../span.h"
 #include "../bitset.h"
 #include "../byte.h"
+#include <cassert>
+#include <cstdint>
 namespace mystl
 {
-	//̬ṩֳڴ㷽
+	//尺寸分级表的编译期生成
+	namespace detail
+	{
+		//不超过 128 字节的按 8 字节等距分级
+		constexpr size_t SIZE_CLASS_SMALL_LIMIT = 128;
+		constexpr size_t SIZE_CLASS_SMALL_SHIFT = 3;
+		//超过 128 字节以后，每翻一倍再均分成 8 级，相邻两级相差约 12.5%，内部碎片也就不超过 12.5%
+		constexpr size_t SIZE_CLASS_DOUBLING_SHIFT = 3;
+		constexpr size_t SIZE_CLASS_SMALL_COUNT = SIZE_CLASS_SMALL_LIMIT >> SIZE_CLASS_SMALL_SHIFT;
+		//一个 span 期望容纳的字节数，用来推导每级的页数和批量
+		constexpr size_t SIZE_CLASS_TARGET_BYTES = 64 * 1024;
+
+		//二进制位数，bit_width(128) = 8
+		constexpr size_t bit_width(size_t value)
+		{
+			size_t width = 0;
+			while (value != 0)
+			{
+				value >>= 1;
+				++width;
+			}
+			return width;
+		}
+
+		//尺寸 -> 级别
+		constexpr size_t compute_size_class(size_t memory_size)
+		{
+			if (memory_size <= SIZE_CLASS_SMALL_LIMIT)
+			{
+				return memory_size == 0 ? 0 : ((memory_size - 1) >> SIZE_CLASS_SMALL_SHIFT);
+			}
+			//memory_size 落在 (2^lg, 2^(lg+1)] 之间
+			const size_t lg = bit_width(memory_size - 1) - 1;
+			const size_t step_shift = lg - SIZE_CLASS_DOUBLING_SHIFT;
+			const size_t offset = (memory_size - (size_t(1) << lg) + (size_t(1) << step_shift) - 1) >> step_shift;
+			return SIZE_CLASS_SMALL_COUNT + ((lg - bit_width(SIZE_CLASS_SMALL_LIMIT) + 1) << SIZE_CLASS_DOUBLING_SHIFT) + offset - 1;
+		}
+
+		//级别 -> 该级的块大小
+		constexpr size_t compute_class_size(size_t index)
+		{
+			if (index < SIZE_CLASS_SMALL_COUNT)
+			{
+				return (index + 1) << SIZE_CLASS_SMALL_SHIFT;
+			}
+			const size_t k = index - SIZE_CLASS_SMALL_COUNT;
+			const size_t lg = bit_width(SIZE_CLASS_SMALL_LIMIT) - 1 + (k >> SIZE_CLASS_DOUBLING_SHIFT);
+			const size_t step = size_t(1) << (lg - SIZE_CLASS_DOUBLING_SHIFT);
+			return (size_t(1) << lg) + ((k & ((size_t(1) << SIZE_CLASS_DOUBLING_SHIFT) - 1)) + 1) * step;
+		}
+
+		constexpr size_t clamp_size(size_t value, size_t low, size_t high)
+		{
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		//每一级一次向 page_cache 申请多少页：至少能切出若干块，并且切完剩下的尾巴不超过 1/8
+		constexpr size_t compute_span_pages(size_t unit_size, size_t page_size)
+		{
+			const size_t min_units = clamp_size(SIZE_CLASS_TARGET_BYTES / unit_size, 4, 128);
+			size_t pages = (unit_size * min_units + page_size - 1) / page_size;
+			while ((pages * page_size) % unit_size > pages * page_size / 8)
+			{
+				++pages;
+			}
+			return pages;
+		}
+
+		//thread_cache 和 central_cache 之间一次搬运的最大块数
+		constexpr size_t compute_batch_count(size_t unit_size, size_t units_per_span)
+		{
+			const size_t count = clamp_size(SIZE_CLASS_TARGET_BYTES / unit_size, 2, 32);
+			return count < units_per_span ? count : units_per_span;
+		}
+
+		//所有级别里，一个 span 最多会被切成多少块
+		constexpr size_t compute_max_units_per_span(size_t count, size_t page_size)
+		{
+			size_t result = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const size_t unit_size = compute_class_size(i);
+				const size_t units = compute_span_pages(unit_size, page_size) * page_size / unit_size;
+				result = units > result ? units : result;
+			}
+			return result;
+		}
+
+		struct size_class_info
+		{
+			size_t unit_size;
+			size_t span_pages;
+			size_t batch_count;
+		};
+
+		template<size_t Count, size_t LookupMaxSize, size_t PageSize>
+		struct size_class_table
+		{
+			size_class_info classes[Count]{};
+			//按 8 字节为步长的查找表，覆盖 [0, LookupMaxSize]
+			unsigned char lookup[(LookupMaxSize >> SIZE_CLASS_SMALL_SHIFT) + 1]{};
+
+			constexpr size_class_table()
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					const size_t unit_size = compute_class_size(i);
+					const size_t span_pages = compute_span_pages(unit_size, PageSize);
+					classes[i] = size_class_info{ unit_size, span_pages, compute_batch_count(unit_size, span_pages * PageSize / unit_size) };
+				}
+				for (size_t i = 0; i <= (LookupMaxSize >> SIZE_CLASS_SMALL_SHIFT); ++i)
+				{
+					lookup[i] = static_cast<unsigned char>(compute_size_class(i << SIZE_CLASS_SMALL_SHIFT));
+				}
+			}
+		};
+	}
+
+	//静态提供各种常量和内存计算方法
 	class size_utils
 	{
 	public:
-		//ڴС뵥λ
-		static constexpr size_t ALIGNMENT = sizeof(void*);//ֳ
-		//һڴҳı׼С4K
+		//内存的最小对齐单位
+		static constexpr size_t ALIGNMENT = sizeof(void*);//机器字长
+		//一个内存页的标准大小4K
 		static constexpr size_t PAGE_SIZE = 4096;
-		//ִСڴֵ
+		//区分大小内存的阈值
 		static constexpr size_t MAX_CACHED_UNIT_SIZE = 16 * 1024;
-		//Сɶٸ뵥Ԫ
-		static constexpr size_t CACHE_LINE_SIZE = MAX_CACHED_UNIT_SIZE / ALIGNMENT;
+		//小对象一共分成多少级
+		static constexpr size_t SIZE_CLASS_COUNT = detail::compute_size_class(MAX_CACHED_UNIT_SIZE) + 1;
+		//不超过这个大小的直接查表，超过的再按位计算
+		static constexpr size_t LOOKUP_MAX_SIZE = 1024;
+		//单次申请的上限，和 glibc 一样拒绝超过 PTRDIFF_MAX 的大小
+		//不超过它的大小按页（或者不超过它的对齐值）向上对齐都不会回绕
+		static constexpr size_t MAX_ALLOCATION_SIZE = static_cast<size_t>(PTRDIFF_MAX);
 
-		//ֽ϶
+		//字节数向上对齐，调用者要先保证 memory_size 不超过 MAX_ALLOCATION_SIZE
 		static size_t align(const size_t memory_size, const size_t alignment=ALIGNMENT)
 		{
+			assert(memory_size <= SIZE_MAX - (alignment - 1) && "size_utils::align overflow");
 			return (memory_size + alignment - 1) & ~(alignment - 1);
 		}
 
-		//0-base
+		//0-base索引（尺寸级别）
 		static size_t get_index(const size_t memory_size)
 		{
-			return align(memory_size) / ALIGNMENT - 1;
+			if (memory_size <= LOOKUP_MAX_SIZE)
+			{
+				return TABLE.lookup[(memory_size + ALIGNMENT - 1) >> detail::SIZE_CLASS_SMALL_SHIFT];
+			}
+			return detail::compute_size_class(memory_size);
+		}
+
+		//该级的块大小
+		static size_t get_class_size(const size_t index)
+		{
+			return TABLE.classes[index].unit_size;
+		}
+
+		//向上取整到所在级别的块大小
+		static size_t round_up(const size_t memory_size)
+		{
+			return get_class_size(get_index(memory_size));
+		}
+
+		//能满足 alignment 对齐的最小级别，alignment 是 2 的幂且不超过一页，memory_size 不超过 MAX_CACHED_UNIT_SIZE
+		//span 的起始地址按页对齐，块大小是 alignment 的整数倍时切出来的每一块都自然对齐
+		//没有这样的级别时返回 SIZE_CLASS_COUNT
+		static size_t get_aligned_index(const size_t memory_size, const size_t alignment)
+		{
+			assert(alignment <= PAGE_SIZE && (alignment & (alignment - 1)) == 0);
+			size_t index = get_index(memory_size);
+			while (index < SIZE_CLASS_COUNT && get_class_size(index) % alignment != 0)
+			{
+				++index;
+			}
+			return index;
+		}
+
+		//该级一个 span 占多少页
+		static size_t get_span_pages(const size_t index)
+		{
+			return TABLE.classes[index].span_pages;
+		}
+
+		//该级一次最多搬运多少块
+		static size_t get_batch_count(const size_t index)
+		{
+			return TABLE.classes[index].batch_count;
+		}
+
+	private:
+		//查找表里用一个字节存级别
+		static_assert(SIZE_CLASS_COUNT <= 256, "size class index must fit in the lookup table");
+		static constexpr detail::size_class_table<SIZE_CLASS_COUNT, LOOKUP_MAX_SIZE, PAGE_SIZE> TABLE{};
+	};
+
+
+	//侵入式单向空闲链表
+	//直接把下一个空闲块的地址写在空闲块自身的前8个字节里，不需要额外的链表节点
+	//所以单元大小至少要能放下一个指针（ALIGNMENT = sizeof(void*)，天然满足）
+	class free_list
+	{
+	public:
+		free_list() = default;
+
+		//只允许移动，避免两个链表共享同一串内存块
+		free_list(const free_list&) = delete;
+		free_list& operator=(const free_list&) = delete;
+
+		free_list(free_list&& other) noexcept :m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size)
+		{
+			other.reset();
+		}
+
+		free_list& operator=(free_list&& other) noexcept
+		{
+			if (this != &other)
+			{
+				m_head = other.m_head;
+				m_tail = other.m_tail;
+				m_size = other.m_size;
+				other.reset();
+			}
+			return *this;
+		}
+
+		//取出空闲块中保存的下一个节点
+		static void*& next_of(void* block)
+		{
+			return *static_cast<void**>(block);
 		}
+
+		bool empty() const
+		{
+			return m_head == nullptr;
+		}
+
+		//O(1)的长度
+		size_t size() const
+		{
+			return m_size;
+		}
+
+		//第一块和最后一块，最后一块保存的下一个节点总是 nullptr
+		void* front() const
+		{
+			return m_head;
+		}
+
+		void* back() const
+		{
+			return m_tail;
+		}
+
+		void push(void* block)
+		{
+			next_of(block) = m_head;
+			if (m_head == nullptr)
+				m_tail = block;
+			m_head = block;
+			++m_size;
+		}
+
+		void* pop()
+		{
+			assert(m_head != nullptr);
+			void* block = m_head;
+			m_head = next_of(block);
+			if (m_head == nullptr)
+				m_tail = nullptr;
+			--m_size;
+			return block;
+		}
+
+		//把[start, end]这一串共count个块整体接到表头
+		void push_range(void* start, void* end, size_t count)
+		{
+			if (count == 0)
+				return;
+			next_of(end) = m_head;
+			if (m_head == nullptr)
+				m_tail = end;
+			m_head = start;
+			m_size += count;
+		}
+
+		//从表头摘下count个块，组成一个新的链表
+		free_list pop_range(size_t count)
+		{
+			assert(count <= m_size);
+			free_list result;
+			if (count == 0)
+				return result;
+			void* end = m_head;
+			for (size_t i = 1; i < count; ++i)
+			{
+				end = next_of(end);
+			}
+			result.m_head = m_head;
+			result.m_tail = end;
+			result.m_size = count;
+			m_head = next_of(end);
+			if (m_head == nullptr)
+				m_tail = nullptr;
+			m_size -= count;
+			next_of(end) = nullptr;
+			return result;
+		}
+
+		//整体接入另一个链表，other会被清空，O(1)
+		void splice(free_list& other)
+		{
+			if (other.empty())
+				return;
+			push_range(other.m_head, other.m_tail, other.m_size);
+			other.reset();
+		}
+
+	private:
+		void reset()
+		{
+			m_head = nullptr;
+			m_tail = nullptr;
+			m_size = 0;
+		}
+
+		void* m_head = nullptr;
+		void* m_tail = nullptr;
+		size_t m_size = 0;
 	};
 
 
-	//PageCacheзڴ棨ٵTreadCacheCentralCache
+	//管理从PageCache中分配下来的内存（跟踪到TreadCache和CentralCache）
 	class page_span
 	{
 	public:
-		//һڴҳжٿ
+		//一个内存页最多能切多少块
 		static constexpr size_t MAX_UNIT_COUNT = size_utils::PAGE_SIZE / size_utils::ALIGNMENT;
-		//ʼpage_span
-		page_span(const mystl::span<mystl::byte> span, const size_t unit_size) :m_memory(span), m_unit_size(unit_size) {};
+		//每一级的 span 切出来的块数都不能超过位图的容量
+		static_assert(detail::compute_max_units_per_span(size_utils::SIZE_CLASS_COUNT, size_utils::PAGE_SIZE) <= MAX_UNIT_COUNT,
+			"a size class span has more units than page_span can track");
+		//初始化page_span，node 是这段页面所属的 NUMA 节点
+		page_span(const mystl::span<mystl::byte> span, const size_t unit_size, const size_t node = 0) :m_memory(span), m_unit_size(unit_size), m_node(node) {};
 
-		//ǰҳǲȫûб
+		//当前页面是不是全部没有被分配
 		bool is_empty()
 		{
-			return m_allocated_map.none();
+			return m_allocated_count == 0;
+		}
+
+		//是不是所有的块都已经分配出去了
+		bool is_full()
+		{
+			return m_allocated_count == unit_count();
 		}
 
-		//ҳڴ
+		//能切出来的块数，末尾放不下一整块的部分不算
+		size_t unit_count()
+		{
+			return m_memory.size() / m_unit_size;
+		}
+
+		//已经分配出去的块数
+		size_t allocated_count()
+		{
+			return m_allocated_count;
+		}
+
+		//取出一个空闲块：先取归还回来的，没有时从还没切过的部分按地址顺序切一块
+		//还没切过的块不用写链表指针，新申请的页面直到真正交给用户才会被访问
+		void* pop_free();
+
+		//把一个块放回这个页面自己的空闲链表
+		void push_free(void* block);
+
+		//从页面申请内存
 		void allocate(mystl::span<mystl::byte> memory);
 
-		//һڴ黹ҳ
+		//把这一块内存归还给页面
 		void deallocate(mystl::span<mystl::byte> memory);
 
-		//жĳһοռǲǱpage_span
+		//判断某一段空间是不是被这个page_span所管理的
 		bool is_valid_unit_span(mystl::span<mystl::byte> memory);
 
-		//ڴ泤
+		//管理的内存长度
 		inline size_t size()
 		{
 			return m_memory.size();
 		}
 
-		//ʼַ
+		//起始地址
 		mystl::byte* data()
 		{
 			return m_memory.data();
 		}
 
-		//άĳ
+		//维护的长度
 		size_t unit_size()
 		{
 			return m_unit_size;
 		}
 
-		//άĵַ
+		//获得这个所维护的地址
 		mystl::span<mystl::byte> get_memory_span()
 		{
 			return m_memory;
 		}
 
+		//页面从哪个节点的 PageCache 申请，回收时要还给同一个节点
+		size_t node() const
+		{
+			return m_node;
+		}
+
 	private:
-		//page_spanĿռС
+		//这个page_span管理的空间大小
 		const mystl::span<mystl::byte> m_memory;
-		//һ䵥λĴС
+		//一个分配单位的大小
 		const size_t m_unit_size;
-		//ڹĿǰҳķ
+		//所属的 NUMA 节点
+		const size_t m_node;
+		//用于管理目前页面的分配情况
 		mystl::bitset<MAX_UNIT_COUNT> m_allocated_map;
+		//已经分配出去的块数
+		size_t m_allocated_count = 0;
+		//已经切过的块数，之后的部分还没有被访问过
+		size_t m_carved_count = 0;
+		//归还回来的块，链表指针就存放在块里
+		free_list m_free_blocks;
 	};
 }
\ No newline at end of file
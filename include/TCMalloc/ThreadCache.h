@@ -3,13 +3,15 @@
 //#include "../set.h"
 //#include "../unordered_map.h"
 #include <optional>
+#include <thread>
 #include "TCMallocutils.h"
 #include "../span.h"
 
 namespace mystl
 {
-	//PIMPLʵǰ
+	//PIMPL实现类的前向声明
 	class ThreadCacheImpl;
+	struct allocator_stats;
 
 	class thread_cache
 	{
@@ -20,38 +22,96 @@ namespace mystl
 			return instance;
 		}
 
-		//ڴһڴ
+		//向内存池申请一块内存
 		std::optional<void*> allocate(size_t memory_size);
 
-		//ڴع黹һƬռ
+		//申请一块起始地址按 alignment 对齐的内存，alignment 必须是 2 的幂
+		//不超过一页的对齐挑一个块大小是 alignment 倍数的级别，更大的对齐直接从页面缓存切
+		//得到的块可能比 memory_size 所在的级别大，归还时要用不带大小的 deallocate
+		std::optional<void*> allocate_aligned(size_t memory_size, size_t alignment);
+
+		//申请一块全是零的内存（calloc），和 allocate 一样参与采样
+		//大块的整段页面确定是零（刚映射、还没访问过）时不再清零，避免提前补页
+		std::optional<void*> allocate_zeroed(size_t memory_size);
+
+		//把 start_p 指向的块调整到 new_size 字节，old_size 是块里需要保留的字节数
+		//新大小仍然落在原来的级别里时返回原指针；大块尽量原地扩展或缩小（见 page_cache::reallocate_unit）；
+		//都不行时申请新块、按字节复制再归还旧块，所以只能用于可以逐字节搬移的数据
+		//失败时返回 nullopt，原来的块保持不变；实现就是 tcmalloc_reallocate，这里只转换返回值
+		std::optional<void*> reallocate(void* start_p, size_t old_size, size_t new_size);
+
+		//向内存池归还一片空间
 		void deallocate(void* start_p, size_t memory_size);
 
+		//不带大小的归还，通过 page_map 找到所属的 page_span 来恢复块的大小
+		//用于对接 ::operator delete(void*) 这类拿不到原始大小的接口
+		void deallocate(void* start_p);
+
+		//立即把本线程缓存的所有内存块还给下层
+		void flush();
+
+		//让指定线程在下一次调用分配器时清空自己的缓存，找不到这个线程返回false
+		//线程缓存没有加锁，只能由所属的线程自己操作，所以这里只是发出请求
+		static bool request_flush(std::thread::id thread_id);
+
+		//让所有线程在下一次调用分配器时清空自己的缓存，当前线程立即清空
+		//按CPU的缓存和各节点 TransferCache 里的块也立即还给下层
+		static void request_flush_all();
+
+		//统计所有线程缓存的字节数
+		static void collect_stats(allocator_stats& stats);
+
+		//所有线程缓存加起来的字节数预算
+		static void set_total_cache_budget(size_t total_bytes);
+		static size_t get_total_cache_budget();
+
+		//所有线程缓存加起来默认最多32MB
+		static constexpr size_t DEFAULT_TOTAL_CACHE_BYTES = 32 * 1024 * 1024;
+		//每个线程至少、至多能缓存的字节数
+		static constexpr size_t MIN_CACHE_BYTES_PER_THREAD = 512 * 1024;
+		static constexpr size_t MAX_CACHE_BYTES_PER_THREAD = 4 * 1024 * 1024;
+		//一次扩大额度的字节数
+		static constexpr size_t STEAL_BYTES = 64 * 1024;
+
 		~thread_cache();
 
 	private:
 		thread_cache();
 
-		//CentralCacheһռ
+		//向CentralCache层申请一块空间，优先使用TransferCache中现成的整批内存块
 		std::optional<span<byte>> allocate_from_central_cache(size_t memory_size);
 		
-		//̬ڴ
+		//不经过采样的分配
+		std::optional<void*> allocate_unsampled(size_t memory_size);
+
+		//到了采样点的分配，分配完以后交给 heap_profiler 记录
+		std::optional<void*> allocate_sampled(size_t memory_size);
+
+		//不经过 allocate 直接向页面缓存申请的大块（calloc、大的对齐申请）在分配完以后补上采样
+		void sample_large_allocation(void* address, size_t requested_size, size_t allocated_size);
+
+		//动态分配内存
 		size_t compute_allocate_count(size_t memory_size);
 
+		//缓存超过本线程的额度时，把各个链表里长期没用到的块还回去
+		void scavenge();
+
+		//从全局预算或者其它线程那里多要一些额度，全局锁被占用时直接放弃这一次
+		void increase_cache_limit();
+
 		/*
-		//
-		list<span<byte>> m_free_cache[size_utils::CACHE_LINE_SIZE];
+		//空闲链表
+		free_list m_free_cache[size_utils::SIZE_CLASS_COUNT];
 
-		//ڱʾһָСڴʱ뼸ڴ
-		size_t m_next_allocate_count[size_utils::CACHE_LINE_SIZE];
+		//用于表示下一次再申请指定大小的内存时会申请几个内存
+		size_t m_next_allocate_count[size_utils::SIZE_CLASS_COUNT];
 		*/
 
-		//ָԱ
+		//指针成员
 		ThreadCacheImpl* pimpl;
 
-		// ÿбΪ256KB16KBĶΪ 256KB / 16KB = 16
-		// ֵҪõķȽ
-		// ֻ뼸̶СĿռ䣬ֵõĴһЩ
-		// ڴռĴСܸӣҪõСһЩȻܻõ̵߳Ŀռռù
+		// 单个列表一次申请的参考上限为256KB（对于16KB的对象即为 256KB / 16KB = 16个）
+		// 什么时候回收不再看单个列表，而是看整个线程缓存有没有超过额度
 		static constexpr size_t MAX_FREE_BYTES_PER_LISTS = 256 * 1024;
 
 	};
@@ -0,0 +1,91 @@
+#pragma once
+#include <optional>
+#include <utility>
+#include "TCMallocutils.h"
+#include "NumaTopology.h"
+namespace mystl
+{
+	//PIMPL实现类的前向声明
+	class TransferCacheImpl;
+	struct allocator_stats;
+
+	//位于ThreadCache和CentralCache之间的中转层
+	//每一级保存若干条已经凑好的整批空闲链表，线程之间直接交换整批内存块
+	//只用一个很短的自旋锁保护一次链表头的交换，不会碰到CentralCache的span记录
+	class transfer_cache
+	{
+	public:
+		//每一级最多缓存多少批
+		static constexpr size_t MAX_BATCHES_PER_CLASS = 64;
+		//每一级缓存的总字节数上限，大块的级别缓存的批数会相应减少
+		static constexpr size_t MAX_BYTES_PER_CLASS = 1024 * 1024;
+
+		//每个 NUMA 节点一个，缓存的都是这个节点的内存块
+		static transfer_cache& get_instance(size_t node)
+		{
+			assert(node < numa_topology::MAX_NODES);
+			return instances(std::make_index_sequence<numa_topology::MAX_NODES>())[node];
+		}
+
+		//当前线程所在节点的中转层
+		static transfer_cache& get_instance()
+		{
+			return get_instance(numa_topology::current_node());
+		}
+
+		//放入一批内存块，块数必须正好是这一级的搬运批量
+		//放满了返回false，链表原样留在调用方手里
+		bool insert(size_t index, free_list& batch);
+
+		//从最上面那批取出至多 block_count 个内存块，那批比 block_count 多时只切走一部分，剩下的继续缓存
+		//所以缓存里可能有凑不满的批，它们和整批一样参与衰减和回收
+		std::optional<free_list> remove(size_t index, size_t block_count);
+
+		//这一级最多缓存多少批
+		static size_t get_capacity(size_t index);
+
+		//前端缓存向下申请block_count个内存块：有现成的批就从里面取，否则向CentralCache申请
+		std::optional<free_list> allocate(size_t memory_size, size_t block_count);
+
+		//前端缓存向下归还内存块：切成整批放进中转层，放不下的和凑不满一批的才还给CentralCache
+		//多节点时先挑出属于别的节点的块，直接挂到那个节点CentralCache的远程回收队列上
+		void deallocate(free_list memories, size_t memory_size);
+
+		//把所有缓存的整批内存块还给CentralCache，空出来的span随之回到PageCache，返回还回去的字节数
+		//page_cache::release_free_memory 和 thread_cache::request_flush_all 会调用它
+		size_t drain();
+
+		//统计每一级缓存的块数和搬运次数
+		void collect_stats(allocator_stats& stats);
+
+		~transfer_cache();
+
+	private:
+		explicit transfer_cache(size_t node);
+
+		//所有节点的中转层，只有编号小于 node_count() 的会真正创建内部数据
+		template<size_t... Nodes>
+		static transfer_cache* instances(std::index_sequence<Nodes...>)
+		{
+			static transfer_cache result[] = { transfer_cache(Nodes)... };
+			return result;
+		}
+
+		//空闲衰减：把上一次衰减以来一直没有被取走的批的一半还给CentralCache
+		//前端缓存回收时送来凑不满一批的链表，说明这一级已经冷下来了，这时顺便衰减
+		void decay(size_t index);
+
+		/*
+		free_list m_batches[size_utils::SIZE_CLASS_COUNT][MAX_BATCHES_PER_CLASS];
+		size_t m_used[size_utils::SIZE_CLASS_COUNT];
+		size_t m_low_water[size_utils::SIZE_CLASS_COUNT];
+		std::atomic_flag m_status[size_utils::SIZE_CLASS_COUNT];
+		*/
+
+		//指针成员
+		TransferCacheImpl* pimpl;
+
+		//所属的 NUMA 节点
+		size_t m_node;
+	};
+}
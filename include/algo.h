@@ -1,10 +1,10 @@
 #pragma once
 #include "iterator.h"
-// ͷļһϵбȽϸӵ㷨
+// 这个头文件包含了一系列比较复杂的算法
 namespace mystl
 {
 	//all_of
-	//[first,last)ǷȫԪضһԪunary_predΪtrue򷵻 true
+	//检查[first,last)内是否全部元素都满足一元操作unary_pred为true的情况，满足则返回 true
 	template<class InputIter, class UnaryPredicate>
 	bool all_of(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -17,7 +17,7 @@ namespace mystl
 	}
 
 	//any_of
-	//[first, last)ǷĳԪһԪunary_predΪtrue 򷵻 true
+	//检查[first, last)内是否存在某个元素满足一元操作unary_pred为true 的情况，满足则返回 true
 	template <class InputIter, class UnaryPredicate>
 	bool any_of(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -30,7 +30,7 @@ namespace mystl
 	}
 
 	// none_of
-	// [first, last)ǷȫԪضһԪ unary_pred Ϊ true 򷵻 true
+	// 检查[first, last)内是否全部元素都不满足一元操作 unary_pred 为 true 的情况，满足则返回 true
 	template <class InputIter, class UnaryPredicate>
 	bool none_of(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -43,7 +43,7 @@ namespace mystl
 	}
 
 	//count
-	//[first, last)ڵԪֵбȽϣȱʡʹ operator==Ԫȵĸ
+	//对[first, last)区间内的元素与给定值进行比较，缺省使用 operator==，返回元素相等的个数
 	template <class InputIter, class T>
 	size_t count(InputIter first, InputIter last, const T& value)
 	{
@@ -57,7 +57,7 @@ namespace mystl
 	}
 
 	// count_if
-	// [first, last)ڵÿԪضһԪ unary_pred ؽΪ true ĸ
+	// 对[first, last)区间内的每个元素都进行一元 unary_pred 操作，返回结果为 true 的个数
 	template <class InputIter, class UnaryPredicate>
 	size_t count_if(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -70,7 +70,7 @@ namespace mystl
 		return n;
 	}
 	// find
-	// [first, last)ҵ value ԪأָԪصĵ
+	// 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
 	template<class InputIter, class T>
 	InputIter find(InputIter first, InputIter last, const T& value)
 	{
@@ -80,7 +80,7 @@ namespace mystl
 	}
 
 	//find_if
-	//[first, last)ҵһһԪ unary_pred Ϊ true ԪزָԪصĵ
+	//在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
 	template <class InputIter, class UnaryPredicate>
 	InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -90,7 +90,7 @@ namespace mystl
 	}
 
 	// find_if_not
-	// [first, last)ҵһһԪ unary_pred Ϊ false ԪزָԪصĵ
+	// 在[first, last)区间内找到第一个令一元操作 unary_pred 为 false 的元素并返回指向该元素的迭代器
 	template <class InputIter, class UnaryPredicate>
 	InputIter find_if_not(InputIter first, InputIter last, UnaryPredicate unary_pred)
 	{
@@ -100,7 +100,7 @@ namespace mystl
 	}
 
 	// search
-	// [first1, last1)в[first2, last2)״γֵ
+	// 在[first1, last1)中查找[first2, last2)的首次出现点
 	template<class ForwardIter1, class ForwardIter2>
 	ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2)
 	{
@@ -134,7 +134,7 @@ namespace mystl
 		return first1;
 	}
 
-	// ذ汾ʹԶ庯 comp Ƚϲ
+	// 重载版本使用自定义函数对象 comp 代替比较操作
 	template <class ForwardIter1, class ForwardIter2, class Compared>
 	ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2, Compared comp)
 	{
@@ -169,7 +169,7 @@ namespace mystl
 	}
 
 	//lower_bound
-	//[first, last)вҵһС value Ԫأָĵû򷵻 last
+	//在[first, last)中查找第一个不小于 value 的元素，并返回指向它的迭代器，若没有则返回 last
 	template<class ForwardIter, class T>
 	ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last, const T& value, forward_iterator_tag)
 	{
@@ -180,16 +180,16 @@ namespace mystl
 		{
 			half = len >> 1;
 			middle = first;
-			mystl::advance(middle, half);//middlemiddle
+			mystl::advance(middle, half);//middle真正变成middle
 			if (*middle < value)
 			{
 				first = middle;
 				first++;
-				len = len - half - 1;//ǰ벿
+				len = len - half - 1;//在前半部分找
 			}
 			else
 			{
-				len = half;//ں벿
+				len = half;//在后半部分找
 			}
 		}
 		return first;
@@ -226,29 +226,29 @@ namespace mystl
 
 
 	//reverse
-	//[first,last)ڵԪطתҿ
+	//将[first,last)区间内的元素反转（左闭右开）
 
-	//reverse_dispatch˫汾
+	//reverse_dispatch的双向迭代器版本
 	template <class BidirectionalIter>
 	void reverse_dispatch(BidirectionalIter first, BidirectionalIter last,
 		bidirectional_iterator_tag)
 	{
 		while (true)
 		{
-			if (first == last || first == --last)//--lastΪҿ
+			if (first == last || first == --last)//这里--last是因为右开
 				return;
-			mystl::iter_swap(first++, last);//first++Ϊ
+			mystl::iter_swap(first++, last);//first++是因为左闭
 		}
 	}
-	//ʵ汾
+	//随机访问迭代器版本
 	template<class RandomIter>
 	void reverse_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag)
 	{
-		while (first < last)//ʵ֧<ķ
+		while (first < last)//随机访问迭代器支持<带来的方便
 			mystl::iter_swap(first++, --last);
 	}
 
-	//
+	//整合
 	template <class BidirectionalIter>
 	void reverse(BidirectionalIter first, BidirectionalIter last)
 	{
@@ -257,7 +257,7 @@ namespace mystl
 
 
 	//is_permutation
-	//ж[first1,last1)ǷΪ[first2,last2)
+	//判断[first1,last1)是否为[first2,last2)的排列组合
 	template <class ForwardIter1, class ForwardIter2, class BinaryPred>
 	bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1,
 		ForwardIter2 first2, ForwardIter2 last2,
@@ -273,7 +273,7 @@ namespace mystl
 				return false;
 		}
 
-		// ҳͬǰ׺
+		// 先找出相同的前缀段
 		for (; first1 != last1 && first2 != last2; ++first1, (void) ++first2)
 		{
 			if (!pred(*first1, *first2))
@@ -294,7 +294,7 @@ namespace mystl
 				return false;
 		}
 
-		// жʣಿ
+		// 判断剩余部分
 		for (auto i = first1; i != last1; ++i)
 		{
 			bool is_repeated = false;
@@ -309,7 +309,7 @@ namespace mystl
 
 			if (!is_repeated)
 			{
-				//  *i  [first2, last2) Ŀ
+				// 计算 *i 在 [first2, last2) 的数目
 				auto c2 = 0;
 				for (auto j = first2; j != last2; ++j)
 				{
@@ -319,7 +319,7 @@ namespace mystl
 				if (c2 == 0)
 					return false;
 
-				//  *i  [first1, last1) Ŀ
+				// 计算 *i 在 [first1, last1) 的数目
 				auto c1 = 1;
 				auto j = i;
 				for (++j; j != last1; ++j)
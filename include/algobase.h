@@ -2,7 +2,7 @@
 #include <cstring>
 #include "iterator.h"
 #include "utils.h"
-//ļʵֵһЩȽϻ㷨
+//这个文件实现的是一些比较基础的算法
 namespace mystl
 {
 	//max
@@ -12,7 +12,7 @@ namespace mystl
 		return lhs < rhs ? rhs : lhs;
 	}
 
-	//ԶȽϺ
+	//自定义比较函数
 	template<class T, class Compare>
 	const T& max(const T& lhs, const T& rhs, Compare cmp)
 	{
@@ -35,7 +35,7 @@ namespace mystl
 
 
 	//iter_swap
-	//ָĶԵ
+	//将两个迭代器所指的对象对调
 	template<class FIter1, class FIter2>
 	void iter_swap(FIter1 lhs, FIter2 rhs)
 	{
@@ -43,9 +43,9 @@ namespace mystl
 	}
 
 	//copy
-	//  [first, last)ڵԪؿ [result, result + (last - first))
+	// 把 [first, last)区间内的元素拷贝到 [result, result + (last - first))内
 
-	//input_iterator_tag汾
+	//input_iterator_tag版本
 	template<class InputIter, class OutputIter>
 	OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag)
 	{
@@ -56,7 +56,7 @@ namespace mystl
 		return result;
 	}
 
-	//ramdom_access_iterator_tag汾
+	//ramdom_access_iterator_tag版本
 	template <class RandomIter, class OutputIter>
 	OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result,
 		mystl::random_access_iterator_tag)
@@ -74,7 +74,7 @@ namespace mystl
 		return unchecked_copy_cat(first, last, result, iterator_category(first));
 	}
 
-	// Ϊ֧ƽṩػ汾
+	// 为支持平凡拷贝的类型提供特化版本
 	template <class Tp, class Up>
 	typename mystl::enable_if<
 		mystl::is_same<typename mystl::remove_const<Tp>::type, Up>::value&&
@@ -84,9 +84,9 @@ namespace mystl
 	{
 		const auto n = static_cast<size_t>(last - first);
 		if (n != 0)
-			//ƽֱӰֽڸ
-			std::memmove(result, first, n * sizeof(Up));//firstָڴ鸴n*sizeof(Up)ֽڵresult
-		return result + n;//Ŀڴĩβһλãʽ
+			//平凡类型允许直接按字节复制
+			std::memmove(result, first, n * sizeof(Up));//从first指向的内存块复制n*sizeof(Up)字节到result
+		return result + n;//返回目标内存块末尾的下一个位置，方便链式操作
 	}
 
 	template <class InputIter, class OutputIter>
@@ -96,14 +96,14 @@ namespace mystl
 	}
 
 	//copy_backward
-	// [first, last)ڵԪؿ [result - (last - first), result)
+	//将 [first, last)区间内的元素拷贝到 [result - (last - first), result)内
 	template<class BidirectionalIter1, class BidirectionalIter2>
 	BidirectionalIter2
 		unchecked_copy_backward_cat(BidirectionalIter1 first, BidirectionalIter2 last,
 			BidirectionalIter2 result, mystl::bidirectional_iterator_tag)
 	{
 		while (first != last)
-			*--result = *--last;//Ӻǰ
+			*--result = *--last;//从后往前拷贝
 		return result;
 	}
 
@@ -126,7 +126,7 @@ namespace mystl
 			iterator_category(first));
 	}
 
-	// Ϊ trivially_copy_assignable ṩػ汾
+	// 为 trivially_copy_assignable 类型提供特化版本
 	template <class Tp, class Up>
 	typename mystl::enable_if<
 		mystl::is_same<typename mystl::remove_const<Tp>::type, Up>::value&&
@@ -151,8 +151,8 @@ namespace mystl
 	}
 
 	// copy_n
-	//  [first, first + n)ϵԪؿ [result, result + n)
-	// һ pair ֱָ򿽱β
+	// 把 [first, first + n)区间上的元素拷贝到 [result, result + n)上
+	// 返回一个 pair 分别指向拷贝结束的尾部
 	template <class InputIter, class Size, class OutputIter>
 	mystl::pair<InputIter, OutputIter>
 		unchecked_copy_n(InputIter first, Size n, OutputIter result, mystl::input_iterator_tag)
@@ -181,11 +181,11 @@ namespace mystl
 	}
 
 	//move
-	//[first,last)ڵԪƶ[result, result + (last - first))
+	//把[first,last)区间内的元素移动到[result, result + (last - first))内
 	template<class InputIter, class OutputIter>
 	OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag)
 	{
-		for (; first != last; first++, result++)//ͬ汾Ҫѭ
+		for (; first != last; first++, result++)//不同版本区别主要在于循环条件
 		{
 			*result = mystl::move(*first);
 		}
@@ -207,15 +207,15 @@ namespace mystl
 	{
 		return unchecked_move_cat(first, last, result, iterator_category(first));
 	}
-	//Կƽƶ
-	//ͨڴ漶memmoveԪصƶԴ
+	//针对可以平凡移动的类型
+	//通过内存级别的批量操作memmove替代逐元素的移动，以大幅提升性能
 	template<class Tp, class Up>
 	typename mystl::enable_if<mystl::is_same<typename mystl::remove_const<Tp>::type, Up>::value&&
 		mystl::is_trivially_move_assignable<Up>::value, Up*>::type
-		//std::enable_if÷볣ģĬֵʽֱֵͬͨʹSFINAE
-		//˴std::enable_if ֵ͵һ֣ģĬֵ
-		//Ϊʱstd::enable_if<Condition, Up*>::typeȼUp*
-		//Ϊʱstd::enable_iftypeԱģ滻ʧܣúؼб޳SFINAE
+		//这里std::enable_if的用法与常见的模板参数默认值方式不同，它直接通过返回值类型触发SFINAE机制
+		//此处的std::enable_if被用作 返回值类型的一部分，而非模板参数的默认值
+		//条件为真时：std::enable_if<Condition, Up*>::type等价于Up*，函数正常存在
+		//条件为假时：std::enable_if无type成员，导致模板替换失败，该函数从重载集中被剔除（SFINAE）
 		unchecked_move(Tp* first, Tp* last, Up* result)
 	{
 		const size_t n = static_cast<size_t>(last - first);
@@ -231,7 +231,7 @@ namespace mystl
 	}
 
 	//move_back
-	// [first, last)ڵԪƶ [result - (last - first), result)
+	//将 [first, last)区间内的元素移动到 [result - (last - first), result)内
 	template <class BidirectionalIter1, class BidirectionalIter2>
 	BidirectionalIter2
 		unchecked_move_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,
@@ -242,7 +242,7 @@ namespace mystl
 		return result;
 	}
 
-	// random_access_iterator_tag 汾
+	// random_access_iterator_tag 版本
 	template <class RandomIter1, class RandomIter2>
 	RandomIter2
 		unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,
@@ -262,7 +262,7 @@ namespace mystl
 			iterator_category(first));
 	}
 
-	// Ϊ trivially_copy_assignable ṩػ汾
+	// 为 trivially_copy_assignable 类型提供特化版本
 	template <class Tp, class Up>
 	typename mystl::enable_if<
 		mystl::is_same<typename mystl::remove_const<Tp>::type, Up>::value&&
@@ -278,10 +278,10 @@ namespace mystl
 		}
 		return result;
 	}
-	//memmoveC++׼еһڴ
-	//ڽһڴݴԴַƵĿַ(memmove ֱӲڴ棬ù캯)
-	//ĺصǰȫڴص(memcpyͬ,ѡӺǰƣȷȷ)Ҫڴ渴Ƶĳ
-	//ԴĿڴܴصʱ.
+	//memmove是C++标准库中的一个内存操作函数
+	//用于将一段内存数据从源地址复制到目标地址(memmove 直接操作内存，不会调用构造函数或析构函数)
+	//它的核心特点是安全处理内存重叠(与memcpy不同,选择从后向前复制，确保正确结果)，适用于需要内存复制的场景
+	//尤其是在源和目标内存区域可能存在重叠时.
 
 	template <class BidirectionalIter1, class BidirectionalIter2>
 	BidirectionalIter2
@@ -291,7 +291,7 @@ namespace mystl
 	}
 
 	//equal
-	//Ƚϵһ [first, last)ϵԪֵǷ͵ڶ
+	//比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 	template<class InputIter1, class InputIter2>
 	bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
 	{
@@ -303,7 +303,7 @@ namespace mystl
 		return true;
 	}
 
-	// ذ汾ʹԶȽϺ comp Ƚϲ
+	// 重载版本使用自定义比较函数对象 comp 代替比较操作
 	template <class InputIter1, class InputIter2, class Compared>
 	bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
 	{
@@ -316,7 +316,7 @@ namespace mystl
 	}
 
 	// fill_n
-	//  first λÿʼ n ֵ
+	// 从 first 位置开始填充 n 个值
 	template <class OutputIter, class Size, class T>
 	OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value)
 	{
@@ -327,11 +327,11 @@ namespace mystl
 		return first;
 	}
 
-	// Ϊ one-byte ṩػ汾
+	// 为 one-byte 类型提供特化版本
 	template <class Tp, class Size, class Up>
 	typename mystl::enable_if<
 		mystl::is_integral<Tp>::value && sizeof(Tp) == 1 &&
-		!mystl::is_same<Tp, bool>::value&&//ųbool
+		!mystl::is_same<Tp, bool>::value&&//排除bool
 		mystl::is_integral<Up>::value && sizeof(Up) == 1,
 		Tp*>::type
 		unchecked_fill_n(Tp* first, Size n, Up value)
@@ -352,7 +352,7 @@ namespace mystl
 
 
 	// fill
-	// Ϊ [first, last)ڵԪֵ
+	// 为 [first, last)区间内的所有元素填充新值
 	template <class ForwardIter, class T>
 	void fill_cat(ForwardIter first, ForwardIter last, const T& value,
 		mystl::forward_iterator_tag)
@@ -377,11 +377,11 @@ namespace mystl
 	}
 
 	// lexicographical_compare
-	// ֵжнбȽϣĳλ÷ֵһ鲻Ԫʱм
-	// (1)һеԪؽС true 򷵻 false
-	// (2) last1 δ last2  true
-	// (3) last2 δ last1  false
-	// (4)ͬʱ last1  last2  false
+	// 以字典序排列对两个序列进行比较，当在某个位置发现第一组不相等元素时，有下列几种情况：
+	// (1)如果第一序列的元素较小，返回 true ，否则返回 false
+	// (2)如果到达 last1 而尚未到达 last2 返回 true
+	// (3)如果到达 last2 而尚未到达 last1 返回 false
+	// (4)如果同时到达 last1 和 last2 返回 false
 	template<class InputIter1, class InputIter2>
 	inline bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2)
 	{
@@ -408,7 +408,7 @@ namespace mystl
 		return first1 == last1 && first2 != last2;
 	}
 
-	//  const unsigned char* ػ汾
+	// 针对 const unsigned char* 的特化版本
 	inline bool lexicographical_compare(const unsigned char* first1,
 		const unsigned char* last1,
 		const unsigned char* first2,
@@ -416,9 +416,9 @@ namespace mystl
 	{
 		const auto len1 = last1 - first1;
 		const auto len2 = last2 - first2;
-		// ȱȽͬȵĲ
+		// 先比较相同长度的部分
 		const auto result = std::memcmp(first1, first2, mystl::min(len1, len2));
-		// ȣȽϳıȽϴ
+		// 若相等，长度较长的比较大
 		return result != 0 ? result < 0 : len1 < len2;
 	}
 
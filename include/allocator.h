@@ -1,14 +1,15 @@
 #pragma once
 #include "construct.h"
-#include "utils.h" // ȷ utils.h ṩ mystl::move  mystl::forward
-//TCMalloc
-#include "TCMalloc/ThreadCache.h"
-#include "TCMalloc/PageCache.h"
-#include "TCMalloc/TCMallocBootstrap.h"
+#include "utils.h" // 确保 utils.h 提供了 mystl::move 和 mystl::forward
+#include <cstring>
+#include <new>
+//接入TCMalloc
+//定义 MYSTL_ALLOCATOR_USE_TCMALLOC 后 allocator 改为从 TCMalloc 层申请内存，所有容器都跟着切换，不需要改容器的代码
+#include "TCMalloc/TCMallocAllocator.h"
 namespace mystl
 {
-    // ģallocator
-    // 򵥵Ŀռ
+    // 模板类allocator
+    // 简单的空间配置器
     template <class T>
     class allocator
     {
@@ -21,22 +22,26 @@ namespace mystl
         typedef size_t      size_type;
         typedef ptrdiff_t   difference_type;
 
-        // 
+        // 函数声明
         static pointer allocate();
         static pointer allocate(size_type n);
 
         static void deallocate(pointer ptr);
-        static void deallocate(pointer ptr, size_type n); // ݱ׼ӿ
+        static void deallocate(pointer ptr, size_type n); // 兼容标准容器接口
 
-        // ת mystl::construct
+        // 把 ptr 指向的空间调整为 new_n 个元素，保留前 old_n 个元素的字节
+        // 内容按字节搬移，只能用于可平凡复制的类型；ptr 为空时等同于 allocate(new_n)
+        static pointer reallocate(pointer ptr, size_type old_n, size_type new_n);
+
+        // 构造对象，转发到 mystl::construct
         static void construct(pointer ptr);
         static void construct(pointer ptr, const_reference value);
-        static void construct(pointer ptr, value_type&& value); // C++11 ֵ
+        static void construct(pointer ptr, value_type&& value); // C++11 右值引用
 
         template <class... Args>
-        static void construct(pointer ptr, Args&& ...args); // C++11 ɱģ壬ת
+        static void construct(pointer ptr, Args&& ...args); // C++11 可变参数模板，完美转发
 
-        // ٶת mystl::destroy
+        // 销毁对象，转发到 mystl::destroy
         static void destroy(pointer ptr);
         static void destroy(pointer first, pointer last);
 
@@ -46,105 +51,101 @@ namespace mystl
         };
     };
 
-    // ʵ
+    // 函数实现
 
-    
-    //ԭʼallocator
-    // δʼڴ棬ָڴָ
+#if defined(MYSTL_ALLOCATOR_USE_TCMALLOC)
+    //接入TCMalloc
     template<class T>
     typename allocator<T>::pointer allocator<T>::allocate()
     {
-        return static_cast<typename allocator<T>::pointer>(::operator new(sizeof(T)));
+        return allocate(1);
     }
-    //Ϊʲôʹtypename allocator<T>::pointerֱʹT*
-    //Ϊ˷ͱ
 
     template<class T>
     typename allocator<T>::pointer allocator<T>::allocate(typename allocator<T>::size_type n)
     {
         if (n == 0)
-            return static_cast<typename allocator<T>::pointer>(nullptr); // ȷ nullptr
+            return static_cast<typename allocator<T>::pointer>(nullptr); // 明确返回 nullptr
 
-        return static_cast<typename allocator<T>::pointer>(::operator new(n * sizeof(T)));
+        // 小内存走 ThreadCache，大内存直接向 PageCache 申请；分配器自身重入时交给 ::operator new
+        void* result = tcmalloc_allocate(n * sizeof(T));
+        if (result == nullptr)
+            throw std::bad_alloc();
+        return static_cast<pointer>(result);
     }
-    
-    /*
-    //TCMalloc
+
     template<class T>
-    typename allocator<T>::pointer allocator<T>::allocate()
+    void allocator<T>::deallocate(typename allocator<T>::pointer ptr)
     {
-        return allocate(1);
+        // 块的真实大小和来源都从 page_map 中查，不依赖调用者给的个数
+        tcmalloc_deallocate(ptr);
     }
 
     template<class T>
-    typename allocator<T>::pointer allocator<T>::allocate(typename allocator<T>::size_type n)
+    void allocator<T>::deallocate(typename allocator<T>::pointer ptr, typename allocator<T>::size_type /*n*/)
     {
-        if (n == 0)
-            return static_cast<typename allocator<T>::pointer>(nullptr); // ȷ nullptr
-
-        size_t total_size = n * sizeof(T);
-        void* result = nullptr;
-
-        //ڹ׶  Ǵڴʱ
-        if (g_is_allocator_constructing || total_size > size_utils::MAX_CACHED_UNIT_SIZE)
-        {
-            //ڴֱӽ
-            std::optional<span<byte>> page = page_cache::allocate_unit(total_size);
-            if (page)
-            {
-                result = page->data();
-            }
-        }
-        else
-        {
-            //СڴThreadCache
-            result = thread_cache::get_instance().allocate(total_size).value_or(nullptr);
-        }
+        deallocate(ptr);
+    }
 
+    template<class T>
+    typename allocator<T>::pointer allocator<T>::reallocate(typename allocator<T>::pointer ptr,
+        typename allocator<T>::size_type old_n, typename allocator<T>::size_type new_n)
+    {
+        // 同一级别内直接返回原指针，大块尽量原地扩展，都不行时由 thread_cache 复制
+        void* result = tcmalloc_reallocate(ptr, old_n * sizeof(T), new_n * sizeof(T));
+        if (result == nullptr)
+            throw std::bad_alloc();
         return static_cast<pointer>(result);
     }
-    //
-    */
-    //ԭʼallocatorʵ
+    //接入结束
+#else
+    //原始allocator
+    // 分配未初始化的内存，返回指向内存块的指针
     template<class T>
-    void allocator<T>::deallocate(typename allocator<T>::pointer ptr)
+    typename allocator<T>::pointer allocator<T>::allocate()
     {
-        // operator delete ѾԴ nullptr 
-        ::operator delete(ptr);
+        return static_cast<typename allocator<T>::pointer>(::operator new(sizeof(T)));
     }
+    //为什么使用typename allocator<T>::pointer而不直接使用T*
+    //为了泛型编程
 
     template<class T>
-    void allocator<T>::deallocate(typename allocator<T>::pointer ptr, typename allocator<T>::size_type n)// nδʹãɼע
+    typename allocator<T>::pointer allocator<T>::allocate(typename allocator<T>::size_type n)
     {
-        deallocate(ptr); // ڲԵõ汾
+        if (n == 0)
+            return static_cast<typename allocator<T>::pointer>(nullptr); // 明确返回 nullptr
+
+        return static_cast<typename allocator<T>::pointer>(::operator new(n * sizeof(T)));
     }
 
-    /*
-    //TCMalloc
+    //原始allocator实现
     template<class T>
-    void allocator<T>::deallocate(typename allocator<T>::pointer ptr)
+    typename allocator<T>::pointer allocator<T>::reallocate(typename allocator<T>::pointer ptr,
+        typename allocator<T>::size_type old_n, typename allocator<T>::size_type new_n)
     {
-        deallocate(ptr, 1);
+        if (ptr == nullptr)
+            return allocate(new_n);
+        // operator new 没有原地扩展的能力，只能重新申请再复制
+        pointer result = allocate(new_n);
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr), (old_n < new_n ? old_n : new_n) * sizeof(T));
+        deallocate(ptr, old_n);
+        return result;
     }
 
     template<class T>
-    void allocator<T>::deallocate(typename allocator<T>::pointer ptr, typename allocator<T>::size_type n)
+    void allocator<T>::deallocate(typename allocator<T>::pointer ptr)
     {
-        if (!ptr) return;
-
-        size_t total_size = n * sizeof(T);
+        // operator delete 已经可以处理 nullptr 了
+        ::operator delete(ptr);
+    }
 
-        if (total_size > size_utils::MAX_CACHED_UNIT_SIZE)
-        {
-            page_cache::deallocate_unit(mystl::span<byte>(reinterpret_cast<byte*>(ptr), total_size));
-        }
-        else
-        {
-            thread_cache::get_instance().deallocate(ptr, total_size);
-        }
+    template<class T>
+    void allocator<T>::deallocate(typename allocator<T>::pointer ptr, typename allocator<T>::size_type /*n*/)// 参数n未使用
+    {
+        deallocate(ptr); // 内部仍调用单参数版本
     }
-    //
-    */
+#endif
+
     template<class T>
     void allocator<T>::construct(typename allocator<T>::pointer ptr)
     {
@@ -160,14 +161,14 @@ namespace mystl
     template<class T>
     void allocator<T>::construct(typename allocator<T>::pointer ptr, typename allocator<T>::value_type&& value)
     {
-        mystl::construct(ptr, mystl::move(value)); // ʹ mystl::move
+        mystl::construct(ptr, mystl::move(value)); // 使用 mystl::move
     }
 
     template<class T>
-    template<class ...Args> //  template ؼֻڲԱģ
-    void allocator<T>::construct(typename allocator<T>::pointer ptr, Args&&...args) // תֵ
+    template<class ...Args> // 这里的 template 关键字只作用于内层成员函数模板
+    void allocator<T>::construct(typename allocator<T>::pointer ptr, Args&&...args) // 完美转发，左右值都行
     {
-        mystl::construct(ptr, mystl::forward<Args>(args)...); // ʹ mystl::forward
+        mystl::construct(ptr, mystl::forward<Args>(args)...); // 使用 mystl::forward
     }
 
     template <class T>
@@ -182,12 +183,12 @@ namespace mystl
         mystl::destroy(first, last);
     }
 
-    // destroydeallocate
-    // destroy
-    // ս᣺ö,ͷŶռõķڴԴļ̬Ӷȣ
-    // ͷڴ棺ڴ鱾ԱɸûԺͨ deallocate ͷţ
-    // deallocateڴͷ
-    // ڴԴգͷallocateԭʼڴ飬黹ϵͳڴ
-    // ڴ棬ڴеĶ״̬δdestroyֱ deallocateᵼԴй©
+    // destroy和deallocate的区别
+    // destroy：对象析构
+    // 对象生命周期终结：调用对象的析构函数,释放对象占用的非内存资源（如文件句柄、锁、动态分配的子对象等）
+    // 不释放内存：仅析构对象，内存块本身仍保留（可复用或稍后通过 deallocate 释放）
+    // deallocate：内存释放
+    // 内存资源回收：释放由allocate分配的原始内存块，归还给系统或内存池
+    // 不调用析构函数：仅操作内存，不关心内存中的对象状态（若对象未析构destroy直接 deallocate，会导致资源泄漏）
 
 } // namespace mystl
\ No newline at end of file
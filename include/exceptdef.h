@@ -1,5 +1,5 @@
 #pragma once
-//쳣ߣú쳣׳͵Զ
+//定义异常处理工具，利用宏简化异常抛出和调试断言
 #include <stdexcept>
 #include <cassert>
 
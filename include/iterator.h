@@ -2,64 +2,64 @@
 #include "type_traits.h"
 #include <cstddef> //ptrdiff_t
 namespace mystl {
-	//ֵͱǩ
-	struct input_iterator_tag {};//ֻα
-	struct output_iterator_tag {};//ֻдα
-	struct forward_iterator_tag : public input_iterator_tag {};//ǰɶдֶ֧α
-	struct bidirectional_iterator_tag : public forward_iterator_tag {};//˫֧ǰͺƶ
-	struct random_access_iterator_tag : public bidirectional_iterator_tag {};//ʵָ֧ it + n
-	//̳йϵ
-	//롢->ǰ->˫->ӴС
-	//㷨Уδػĳ͵ʵ֣ؼ̳ϲƥͨð汾
-
-	//iteratorģ
+	//五种迭代器类型标签
+	struct input_iterator_tag {};//输入迭代器（只读，单次遍历）
+	struct output_iterator_tag {};//输出迭代器（只写，单次遍历）
+	struct forward_iterator_tag : public input_iterator_tag {};//前向迭代器（可读写，支持多次遍历）
+	struct bidirectional_iterator_tag : public forward_iterator_tag {};//双向迭代器（支持前向和后向移动）
+	struct random_access_iterator_tag : public bidirectional_iterator_tag {};//随机访问迭代器（支持指针算术，如 it + n）
+	//继承关系：
+	//输入、输出->前向->双向->随机（从大到小）
+	//在算法中，若未特化某迭代器类型的实现，编译器会沿继承链向上查找匹配的通用版本
+
+	//iterator模板
 	template<class Category, class T, class Distance = ptrdiff_t,
 		class Pointer = T*, class Reference = T&>
 	struct iterator
 	{
-		// ͬһ͸
-		using iterator_category		= Category;// 
-		using value_type			= T;// ָ
-		using difference_type		= Distance;// ʾ֮ľ룬Ҳʾһ
-		using pointer				= Pointer;// Ԫصָ
-		using reference				= Reference;// Ԫص
+		// 让同一别名穿透多层
+		using iterator_category		= Category;// 迭代器类别
+		using value_type			= T;// 迭代器所指对象的类型
+		using difference_type		= Distance;// 表示两个迭代器之间的距离，也可以用来表示一个容器的最大容量
+		using pointer				= Pointer;// 元素的指针类型
+		using reference				= Reference;// 元素的引用类型
 	};
 
-	//ȡʵ
+	//迭代器特性萃取实现
 
-	//TǷiterator_categoryͳԱ
+	//检测类型T是否包含iterator_category类型成员
 	namespace detail
 	{
 		template<class T>
 		struct has_iterator_cat_impl
 		{
 		private:
-			struct two { char a; char b; };//ֲͬصռλ
-			//SFINAE滻ʧܷǴ󣩻
+			struct two { char a; char b; };//用于区分不同重载的占位类型
+			//SFINAE（替换失败非错误）机制
 			template<class U>
-			static two test(...) {};//ͨû˰汾twoֽͣڴСΪ2
-			//{}ᱨVCR001
-			//ʵϲҲνΪʹģԪ̣sizeofʵʵú
+			static two test(...) { return two(); }//通用回退版本，返回two类型，字节大小为2
+			//若不加上函数体会报警告VCR001，函数体里没有 return 又会报 -Wreturn-type
+			//但实际上不会被调用，因为我们这里使用了模板元编程，sizeof操作符并不会实际调用函数
 
 			template<class U>
-			static char test(typename U::iterator_category* = 0) {};//ƥ汾charֽͣڴСΪ1
+			static char test(typename U::iterator_category* = 0) { return 0; }//条件匹配版本，返回char类型，字节大小为1
 		public:
-			static const bool value = sizeof(test<T>(0)) == sizeof(char);//ͨ鷵ֵĴСж
+			static const bool value = sizeof(test<T>(0)) == sizeof(char);//通过检查返回值的大小进行判断
 		};
 	}
 
-	//has_iterator_cat_impl<T>::valueΪtrueʱ˵Titerator_categoryԱ
+	//has_iterator_cat_impl<T>::value为true时，说明T包含iterator_category成员
 	template<class T>
 	struct has_iterator_cat: public integral_constant<bool, detail::has_iterator_cat_impl<T>::value>{ };
 
-	//ȡԵģ
+	//萃取迭代器特性的主模板
 	template <class Iterator, bool has_cat = has_iterator_cat<Iterator>::value>
 	struct iterator_traits_base {}; // default empty (for non-iterators or types without iterator_category)
 
 	template <class Iterator>
 	struct iterator_traits_base<Iterator, true>
 	{
-		// ֻе Iterator  iterator_category ʱȡڲ
+		// 只有当 Iterator 有 iterator_category 时，才提取其内部类型
 		using iterator_category	= typename Iterator::iterator_category;
 		using value_type		= typename Iterator::value_type;
 		using pointer			= typename Iterator::pointer;
@@ -67,19 +67,19 @@ namespace mystl {
 		using difference_type	= typename Iterator::difference_type;
 	};
 	
-	// Ҫ iterator_traits ģ
+	// 主要的 iterator_traits 模板
 	template <class Iterator>
 	struct iterator_traits : public iterator_traits_base<Iterator> {};
 
-	// ԭָػ汾
+	// 针对原生指针的特化版本
 	template <class T>
 	struct iterator_traits<T*>
 	{
-		using iterator_category = random_access_iterator_tag; // ԭָ뱻Ϊʵ
-		using value_type		= T; // ָָ 
-		using pointer			= T*; // ָ
-		using reference			= T&; // 
-		using difference_type	= ptrdiff_t; // ֵָ
+		using iterator_category = random_access_iterator_tag; // 原生指针被视为随机访问迭代
+		using value_type		= T; // 指针指向的类型 
+		using pointer			= T*; // 指针类型
+		using reference			= T&; // 引用类型
+		using difference_type	= ptrdiff_t; // 指针差值类型
 	};
 
 	template <class T>
@@ -92,19 +92,19 @@ namespace mystl {
 		using difference_type	= ptrdiff_t;
 	};
 
-	//Titerator_categoryǷʽתΪָU
-	//жTǷU
+	//检测迭代器T的iterator_category是否可隐式转换为指定类型U
+	//即判断T是否属于U或其派生类
 	template <class T, class U, bool IsIterator = has_iterator_cat<iterator_traits<T> >::value>
 	struct has_iterator_cat_of : public integral_constant<bool, false> {};
-	//has_iterator_cat<iterator_traits<T>>::valueȷֻеTǺϷ iterator_categoryʱŽк顣
+	//has_iterator_cat<iterator_traits<T>>::value确保只有当T是合法迭代器（定义了 iterator_category）时，才进行后续检查。
 
 	template <class T, class U>
 	struct has_iterator_cat_of<T, U, true> : public integral_constant<bool,
 		mystl::is_convertible<typename iterator_traits<T>::iterator_category, U>::value> {};
 
 
-	//ػж
-	//ϿֻҪעһ¾
+	//特化判断
+	//理论上可以随便填，只要来这里注册一下就行
 	template <class Iter>
 	struct is_input_iterator : public has_iterator_cat_of<Iter, input_iterator_tag> {};
 
@@ -120,15 +120,15 @@ namespace mystl {
 	template <class Iter>
 	struct is_random_access_iterator : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
-	//жǲǵ
+	//判断是不是迭代器
 	template <class Iterator>
 	struct is_iterator :
 		public integral_constant<bool, is_input_iterator<Iterator>::value || is_output_iterator<Iterator>::value>
 	{
 	};
-	//ĸնinputoutput
+	//无论哪个最终都是input、output的派生
 
-	//ȡĳcategory
+	//提取某个迭代器的category
 	template <class Iterator>
 	inline typename iterator_traits<Iterator>::iterator_category iterator_category(const Iterator&)
 	{
@@ -136,16 +136,16 @@ namespace mystl {
 		return Category();
 	}
 
-	//ȡĳvalue_type
-	//һָ룬Ƶ
+	//提取某个迭代器的value_type
+	//返回一个空指针，用于类型推导
 	template <class Iterator>
 	inline typename iterator_traits<Iterator>::value_type* value_type(const Iterator&)
 	{
 		return static_cast<typename iterator_traits<Iterator>::value_type*>(0);
 	}
 
-	//distance ľ
-	//input_iterator_tag汾(ͨã forward  bidirectional)
+	//distance 计算迭代器间的距离
+	//input_iterator_tag版本(最通用，包括 forward 和 bidirectional)
 	template <class InputIterator>
 	inline typename iterator_traits<InputIterator>::difference_type distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag)
 	{
@@ -158,7 +158,7 @@ namespace mystl {
 		return n;
 	}
 
-	//random_access_iterator_tag汾
+	//random_access_iterator_tag版本
 	template <class RandomIter>
 	inline typename iterator_traits<RandomIter>::difference_type distance_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag)
 	{
@@ -168,19 +168,19 @@ namespace mystl {
 	template <class InputIterator>
 	inline typename iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last)
 	{
-		//ͳһ
+		//统一
 		return distance_dispatch(first, last, iterator_category(first));
 	}
 
-	//advance õǰn
-	//input_iterator_tag汾 (ͨã forward  bidirectional)
+	//advance 让迭代器前进n个距离
+	//input_iterator_tag版本 (最通用，包括 forward 和 bidirectional)
 	template <class InputIterator, class Distance>
 	inline void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag)
 	{
 		while (n--)
 			++i;
 	}
-	//random_access_iterator_tag汾
+	//random_access_iterator_tag版本
 	template <class RandomIter, class Distance>
 	inline void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag)
 	{
@@ -190,22 +190,22 @@ namespace mystl {
 	template <class InputIterator, class Distance>
 	inline void advance(InputIterator& i, Distance n)
 	{
-		//ͳһ
+		//统一
 		advance_dispatch(i, n, iterator_category(i));
 	}
 
 
 
-	//ģࣺreverse_iterator
-	//ǰΪˣΪǰ
-	//
+	//模板类：reverse_iterator反向迭代器
+	//前进为后退，后退为前进
+	//依赖正向迭代器
 	template<class Iterator>
 	class reverse_iterator
 	{
 	private:
-		Iterator current;//Ӧ
+		Iterator current;//对应的正向迭代器
 	public:
-		//Ӧͱ
+		//反向迭代器的五种相应型别
 		using iterator_category = typename iterator_traits<Iterator>::iterator_category;
 		using value_type		= typename iterator_traits<Iterator>::value_type;
 		using difference_type	= typename iterator_traits<Iterator>::difference_type;
@@ -215,21 +215,21 @@ namespace mystl {
 		using iterator_type		= Iterator;
 		using self				= reverse_iterator<Iterator>;
 
-		//캯
-		reverse_iterator():current() {}//c++11ʽĬϹ
+		//构造函数
+		reverse_iterator():current() {}//c++11允许显式默认构造
 		explicit reverse_iterator(iterator_type i) :current(i) {}
 		reverse_iterator(const self& rhs) :current(rhs.current) {}
 
-		//ȡӦ
+		//取出对应的正向迭代器
 		iterator_type base() const
 		{
 			return current;
 		}
 
-		//ز
-		//γԱԲ߽紦
+		//重载操作符
+		//信任程序员，所以不会做边界处理
 		reference operator*() const
-		{ // ʵʶӦǰһλ
+		{ // 实际对应正向迭代器的前一个位置
 			auto tmp = current;
 			return *--tmp;
 		}
@@ -237,19 +237,19 @@ namespace mystl {
 		{
 			return &(operator*());
 		}
-		// ǰ(++)Ϊ(--)
-		self& operator++()//ǰ
+		// 前进(++)变为后退(--)
+		self& operator++()//前置
 		{
 			--current;
 			return *this;
 		}
-		self operator++(int)//
+		self operator++(int)//后置
 		{
 			self tmp = *this;
 			--current;
 			return tmp;
 		}
-		// (--)Ϊǰ(++)
+		// 后退(--)变为前进(++)
 		self& operator--()
 		{
 			++current;
@@ -287,9 +287,9 @@ namespace mystl {
 		}
 	};
 
-	//ͬͱȽ
-	// operator-
-	//ǳԱ
+	//同类型比较
+	//重载 operator-
+	//非成员函数
 	template <class Iterator>
 	typename reverse_iterator<Iterator>::difference_type
 		operator-(const reverse_iterator<Iterator>& lhs,
@@ -298,16 +298,16 @@ namespace mystl {
 		return rhs.base() - lhs.base();
 	}
 
-	//رȽϲ
-	//ʵھ.h
+	//重载比较操作符
+	//具体实现是在具体的容器.h中
 
-	//칹ͬʹͬһȽϰ汾
+	//异构和同构使用同一个比较版本
 	template <class Iterator1, class Iterator2>
 	bool operator==(const mystl::reverse_iterator<Iterator1>& lhs,
 		const mystl::reverse_iterator<Iterator2>& rhs)
 	{
-		// ȽǵĻ
-		// ʽڵײ֮ǿɱȽϵ
+		// 比较它们的基迭代器
+		// 这里隐式地依赖于底层迭代器类型之间是可比较的
 		return lhs.base() == rhs.base();
 	}
 
@@ -1,12 +1,12 @@
 #pragma once
-// ͷļģ map  multimap
-// map      : ӳ䣬ԪؾмֵʵֵݼֵСԶ򣬼ֵظ
-// multimap : ӳ䣬ԪؾмֵʵֵݼֵСԶ򣬼ֵظ
+// 这个头文件包含了两个模板类 map 和 multimap
+// map      : 映射，元素具有键值和实值，会根据键值大小自动排序，键值不允许重复
+// multimap : 映射，元素具有键值和实值，会根据键值大小自动排序，键值允许重复
 
 // notes:
 //
-// 쳣֤
-// mystl::map<Key, T> / mystl::multimap<Key, T> 쳣֤µȺǿ쳣ȫ֤
+// 异常保证：
+// mystl::map<Key, T> / mystl::multimap<Key, T> 满足基本异常保证，对以下等函数做强异常安全保证：
 //   * emplace
 //   * emplace_hint
 //   * insert
@@ -16,19 +16,19 @@
 namespace mystl
 {
 
-    // ģ mapֵظ
-    // һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+    // 模板类 map，键值不允许重复
+    // 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
     template <class Key, class T, class Compare = mystl::less<Key>>
     class map
     {
     public:
-        // map Ƕͱ
+        // map 的嵌套型别定义
         using key_type      = Key;
         using mapped_type   = T;
         using value_type    = mystl::pair<const Key, T>;
         using key_compare   = Compare;
 
-        // һ functorԪرȽ
+        // 定义一个 functor，用来进行元素比较
         class value_compare : public binary_function <value_type, value_type, bool>
         {
             friend class map<Key, T, Compare>;
@@ -38,17 +38,17 @@ namespace mystl
         public:
             bool operator()(const value_type& lhs, const value_type& rhs) const
             {
-                return comp(lhs.first, rhs.first);  // ȽϼֵĴС
+                return comp(lhs.first, rhs.first);  // 比较键值的大小
             }
         };
 
     private:
-        //  mystl::rb_tree Ϊײ
+        // 以 mystl::rb_tree 作为底层机制
         typedef mystl::rb_tree<value_type, key_compare>  base_type;
         base_type tree_;
 
     public:
-        // ʹ rb_tree ͱ
+        // 使用 rb_tree 的型别
         using node_type                 = typename base_type::node_type;
         using pointer                   = typename base_type::pointer;
         using const_pointer             = typename base_type::const_pointer;
@@ -63,7 +63,7 @@ namespace mystl
         using allocator_type            = typename base_type::allocator_type;
 
     public:
-        // 졢ơƶֵ
+        // 构造、复制、移动、赋值函数
 
         map() = default;
 
@@ -107,13 +107,13 @@ namespace mystl
             return *this;
         }
 
-        // ؽӿ
+        // 相关接口
 
         key_compare            key_comp()      const { return tree_.key_comp(); }
         value_compare          value_comp()    const { return value_compare(tree_.key_comp()); }
         allocator_type         get_allocator() const { return tree_.get_allocator(); }
 
-        // 
+        // 迭代器相关
 
         iterator               begin()         noexcept
         {
@@ -166,14 +166,14 @@ namespace mystl
             return rend();
         }
 
-        // 
+        // 容量相关
         bool                   empty()    const noexcept { return tree_.empty(); }
         size_type              size()     const noexcept { return tree_.size(); }
         size_type              max_size() const noexcept { return tree_.max_size(); }
 
-        // Ԫ
+        // 访问元素相关
 
-        // ֵڣat ׳һ쳣
+        // 若键值不存在，at 会抛出一个异常
         mapped_type& at(const key_type& key)
         {
             iterator it = lower_bound(key);
@@ -208,7 +208,7 @@ namespace mystl
             return it->second;
         }
 
-        // ɾ
+        // 插入删除相关
 
         template <class ...Args>
         pair<iterator, bool> emplace(Args&& ...args)
@@ -252,7 +252,7 @@ namespace mystl
 
         void      clear() { tree_.clear(); }
 
-        // map ز
+        // map 相关操作
 
         iterator       find(const key_type& key) { return tree_.find(key); }
         const_iterator find(const key_type& key)        const { return tree_.find(key); }
@@ -287,7 +287,7 @@ namespace mystl
         friend bool operator< (const map& lhs, const map& rhs) { return lhs.tree_ < rhs.tree_; }
     };
 
-    // رȽϲ
+    // 重载比较操作符
     template <class Key, class T, class Compare>
     bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
     {
@@ -324,7 +324,7 @@ namespace mystl
         return !(lhs < rhs);
     }
 
-    //  mystl  swap
+    // 重载 mystl 的 swap
     template <class Key, class T, class Compare>
     void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
     {
@@ -333,19 +333,19 @@ namespace mystl
 
     /*****************************************************************************************/
 
-    // ģ multimapֵظ
-    // һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+    // 模板类 multimap，键值允许重复
+    // 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
     template <class Key, class T, class Compare = mystl::less<Key>>
     class multimap
     {
     public:
-        // multimap ͱ
+        // multimap 的型别定义
         using key_type      = Key;
         using mapped_type   = T;
         using value_type    = mystl::pair<const Key, T>;
         using key_compare   = Compare;
 
-        // һ functorԪرȽ
+        // 定义一个 functor，用来进行元素比较
         class value_compare : public binary_function <value_type, value_type, bool>
         {
             friend class multimap<Key, T, Compare>;
@@ -360,12 +360,12 @@ namespace mystl
         };
 
     private:
-        //  mystl::rb_tree Ϊײ
+        // 用 mystl::rb_tree 作为底层机制
         typedef mystl::rb_tree<value_type, key_compare>  base_type;
         base_type tree_;
 
     public:
-        // ʹ rb_tree ͱ
+        // 使用 rb_tree 的型别
         using node_type                 = typename base_type::node_type;
         using pointer                   = typename base_type::pointer;
         using const_pointer             = typename base_type::const_pointer;
@@ -380,7 +380,7 @@ namespace mystl
         using allocator_type            = typename base_type::allocator_type;
 
     public:
-        // 졢ơƶ
+        // 构造、复制、移动函数
 
         multimap() = default;
 
@@ -423,13 +423,13 @@ namespace mystl
             return *this;
         }
 
-        // ؽӿ
+        // 相关接口
 
         key_compare            key_comp()      const { return tree_.key_comp(); }
         value_compare          value_comp()    const { return value_compare(tree_.key_comp()); }
         allocator_type         get_allocator() const { return tree_.get_allocator(); }
 
-        // 
+        // 迭代器相关
 
         iterator               begin()         noexcept
         {
@@ -482,12 +482,12 @@ namespace mystl
             return rend();
         }
 
-        // 
+        // 容量相关
         bool                   empty()    const noexcept { return tree_.empty(); }
         size_type              size()     const noexcept { return tree_.size(); }
         size_type              max_size() const noexcept { return tree_.max_size(); }
 
-        // ɾ
+        // 插入删除操作
 
         template <class ...Args>
         iterator emplace(Args&& ...args)
@@ -531,7 +531,7 @@ namespace mystl
 
         void           clear() { tree_.clear(); }
 
-        // multimap ز
+        // multimap 相关操作
 
         iterator       find(const key_type& key) { return tree_.find(key); }
         const_iterator find(const key_type& key)        const { return tree_.find(key); }
@@ -566,7 +566,7 @@ namespace mystl
         friend bool operator< (const multimap& lhs, const multimap& rhs) { return lhs.tree_ < rhs.tree_; }
     };
 
-    // رȽϲ
+    // 重载比较操作符
     template <class Key, class T, class Compare>
     bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
     {
@@ -603,7 +603,7 @@ namespace mystl
         return !(lhs < rhs);
     }
 
-    //  mystl  swap
+    // 重载 mystl 的 swap
     template <class Key, class T, class Compare>
     void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept
     {
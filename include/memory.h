@@ -1,33 +1,33 @@
 #pragma once
-//STLڴĺĲ֣߼Ķ̬ڴ
-//ռδʼĴռԼָ unique_ptr
-#include <cstddef>//ṩڴ沼صĻͺͳ
-#include <cstdlib>//ṩ C ׼ڴmalloc\free\realloc
-#include <climits>//صļֵ
+//STL内存管理的核心部分，负责更高级的动态内存管理
+//包含基本函数、空间配置器、未初始化的储存空间管理，以及智能指针 unique_ptr
+#include <cstddef>//提供与内存布局相关的基础类型和常量
+#include <cstdlib>//提供 C 标准库的内存管理函数malloc\free\realloc
+#include <climits>//定义与整数类型相关的极限值
 
-#include "utils.h"//ʹmove swap
+#include "utils.h"//使用move swap
 #include "allocator.h"
 #include "construct.h"
 #include "uninitialized.h"
 #include "iterator.h"
 namespace mystl
 {
-	// ȡ / ͷ ʱ
+	// 获取 / 释放 临时缓冲区
 
 	template <class T>
 	pair<T*, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T*)
 	{
-		//len * sizeof(T)  INT_MAX
-		//static_cast<ptrdiff_t>ǿתΪзƥ len
+		//len * sizeof(T) 不超过 INT_MAX，避免溢出
+		//static_cast<ptrdiff_t>将计算结果强制转换为有符号类型以匹配 len
 		if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
 			len = INT_MAX / sizeof(T);
 		while (len > 0)
 		{
 			T* tmp = static_cast<T*>(malloc(static_cast<size_t>(len) * sizeof(T)));
 			if (tmp)
-				//طڴָʵʳɹĳ
+				//返回分配的内存指针和实际成功分配的长度
 				return pair<T*, ptrdiff_t>(tmp, len);
-			len /= 2;  // ʧʱ len ĴС
+			len /= 2;  // 申请失败时减少 len 的大小
 		}
 		return pair<T*, ptrdiff_t>(nullptr, 0);
 	}
@@ -50,17 +50,17 @@ namespace mystl
 		free(ptr);
 	}
 
-	// ģ : temporary_buffer
-	// ʱͷ
+	// 类模板 : temporary_buffer
+	// 进行临时缓冲区的申请与释放
 	template<class T>
 	class temporary_buffer
 	{
 	private:
-		ptrdiff_t	original_len;	//ĴС
-		ptrdiff_t	len;			//ʵʵĴС
-		T* buffer;			//ָ򻺳ָ
+		ptrdiff_t	original_len;	//缓冲区申请的大小
+		ptrdiff_t	len;			//缓冲区实际的大小
+		T* buffer;			//指向缓冲区的指针
 	public:
-		//졢
+		//构造、析构函数
 		template<class ForwardIterator>
 		temporary_buffer(ForwardIterator first, ForwardIterator last);
 
@@ -78,15 +78,15 @@ namespace mystl
 		T* begin()                noexcept { return buffer; }
 		T* end()                  noexcept { return buffer + len; }
 
-		// ÿͿֵ
-		temporary_buffer(const temporary_buffer&) = delete;//ֹǳµԴظͷ
+		// 禁用拷贝构造和拷贝赋值
+		temporary_buffer(const temporary_buffer&) = delete;//防止浅拷贝导致的资源重复释放
 		temporary_buffer& operator=(const temporary_buffer&) = delete;
 
 	private:
 		void allocate_buffer();
 	};
 
-	//캯
+	//构造函数
 	template<class T>
 	template<class ForwardIterator>
 	temporary_buffer<T>::temporary_buffer(ForwardIterator first, ForwardIterator last)
@@ -104,7 +104,7 @@ namespace mystl
 		catch (...)
 		{
 			if (buffer) {
-				mystl::destroy(buffer, buffer + len);  // ѹĶ
+				mystl::destroy(buffer, buffer + len);  // 销毁已构造的对象
 				free(buffer);
 			}
 			buffer = nullptr;
@@ -113,7 +113,7 @@ namespace mystl
 		}
 	}
 
-	// allocate_buffer 
+	// allocate_buffer 函数
 	template <class T>
 	void temporary_buffer<T>::allocate_buffer()
 	{
@@ -132,7 +132,7 @@ namespace mystl
 			{
 				break;
 			}
-			len /= 2;  // ʧʱռС
+			len /= 2;  // 申请失败时减少申请空间大小
 		}
 		if (len == 0)
 		{
@@ -141,38 +141,38 @@ namespace mystl
 	}
 
 	// uninitialized_value_construct_n
-	//  [first, first + n) ڽֵʼ
+	// 在 [first, first + n) 区间内进行值初始化
 	template <class ForwardIter>
 	void unchecked_value_construct_n_aux(ForwardIter first, size_t n, std::false_type)
 	{
 		ForwardIter current = first;
 		try {
 			for (; n > 0; --n, ++current) {
-				// ÿԪصĬϹ캯 T()
+				// 对每个元素调用默认构造函数 T()
 				mystl::construct(mystl::addressof(*current));
 			}
 		}
 		catch (...) {
-			// ׳쳣ѳɹĶ
+			// 如果构造过程中抛出异常，则销毁所有已成功构造的对象
 			mystl::destroy(first, current);
-			throw; // ׳쳣
+			throw; // 重新抛出异常
 		}
 	}
 
-	// ڲ (ƽͰ汾) - ·
+	// 内部辅助函数 (平凡类型版本) - 快速路径
 	template <class ForwardIter>
 	void unchecked_value_construct_n_aux(ForwardIter first, size_t n, std::true_type)
 	{
-		//  POD (Plain Old Data) ֵͣʼͬʼ
-		// ʹ fill_n Чʸ
+		// 对于 POD (Plain Old Data) 类型，值初始化等同于零初始化
+		// 使用 fill_n 效率更高
 		mystl::fill_n(first, n, typename iterator_traits<ForwardIter>::value_type());
 	}
 
 	template <class ForwardIter>
 	void uninitialized_value_construct_n(ForwardIter first, size_t n)
 	{
-		// ͨ is_trivially_default_constructible зַ
-		//  T һҪ(trivial)ĬϹ캯ǾͿԽŻ
+		// 通过 is_trivially_default_constructible 进行分发
+		// 如果类型 T 有一个不重要的(trivial)默认构造函数，我们就可以进行优化
 		unchecked_value_construct_n_aux(first, n,
 			std::is_trivially_default_constructible<
 			typename iterator_traits<ForwardIter>::value_type
@@ -180,8 +180,8 @@ namespace mystl
 	}
 
 	//unique_ptr
-	//޸auto_ptrȱ
-	//:ռȨԴȫ⿪
+	//修复了auto_ptr的设计缺陷
+	//设计理念:独占所有权、资源安全管理、零额外开销
 
 	template<class T>
 	class unique_ptr
@@ -189,31 +189,31 @@ namespace mystl
 	public:
 		typedef T	element_type;
 	private:
-		T* m_ptr;	//ʵָ
+		T* m_ptr;	//实际指针
 	public:
-		//ĬϹ캯
+		//默认构造函数
 		explicit unique_ptr(T* p = nullptr)noexcept :m_ptr(p) {}
-		//ɾ캯
+		//删除拷贝构造函数
 		unique_ptr(const unique_ptr&) = delete;
-		//ƶ캯
+		//移动构造函数
 		unique_ptr(unique_ptr&& rhs)noexcept :m_ptr(rhs.release()) {}
-		//ģƶ캯֧ൽת
+		//模板移动构造函数（支持派生类到基类的转换）
 		template<class U>
 		unique_ptr(unique_ptr<U>&& rhs)noexcept :m_ptr(rhs.release()) {}
-		//
+		//析构函数
 		~unique_ptr() { reset(); }
 
-		//ɾֵ
+		//删除拷贝赋值
 		unique_ptr& operator=(const unique_ptr&) = delete;
 
-		//ƶֵ
+		//移动赋值操作符
 		unique_ptr& operator=(unique_ptr&& rhs)noexcept
 		{
 			reset(rhs.release());
 			return *this;
 		}
 
-		//ģƶֵ֧ൽת
+		//模板移动赋值（支持派生类到基类的转换）
 		template<class U>
 		unique_ptr& operator=(unique_ptr<U>&& rhs)noexcept
 		{
@@ -221,7 +221,7 @@ namespace mystl
 			return *this;
 		}
 
-		//ָ
+		//重载指针操作符
 		T& operator*() const noexcept
 		{
 			return *m_ptr;
@@ -231,13 +231,13 @@ namespace mystl
 			return m_ptr;
 		}
 
-		//ȡԭʼָ
+		//获取原始指针
 		T* get()const noexcept
 		{
 			return m_ptr;
 		}
 
-		//ͷȨ
+		//释放所有权
 		T* release()noexcept
 		{
 			T* ret = m_ptr;
@@ -245,7 +245,7 @@ namespace mystl
 			return ret;
 		}
 
-		//ָ
+		//重置指针
 		void reset(T* ptr = nullptr)noexcept
 		{
 			T* old = m_ptr;
@@ -254,14 +254,14 @@ namespace mystl
 				delete old;
 		}
 
-		//ָ
+		//交换指针
 		void swap(unique_ptr& other)noexcept
 		{
 			using mystl::swap;
 			swap(m_ptr, other.m_ptr);
 		}
 	};
-	//ػ
+	//交换特化
 	template<class T>
 	void swap(unique_ptr<T>& lhs, unique_ptr<T>& rhs)noexcept
 	{
@@ -1,6 +1,6 @@
 #pragma once
 //rb_tree
-// ο: http://blog.csdn.net/v_JULY_v/article/details/6105630
+// 参考博客: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
 
 #include "iterator.h"
@@ -10,27 +10,27 @@
 #include "utils.h"
 namespace mystl
 {
-	//rb_tree ڵɫ
+	//rb_tree 节点颜色的类型
 	using rb_tree_color_type = bool;
 
 	static constexpr rb_tree_color_type rb_tree_red = false;
 	static constexpr rb_tree_color_type rb_tree_black = true;
 
-	//ǰ
-	template<class T>struct rb_tree_node_base;//ڵ࣬ӹϵ
-	template<class T>struct rb_tree_node;//࣬value
+	//前向声明
+	template<class T>struct rb_tree_node_base;//节点基类，管理树的链接关系
+	template<class T>struct rb_tree_node;//派生类，添加value
 
-	template<class T>struct rb_tree_iterator;//
+	template<class T>struct rb_tree_iterator;//迭代器
 	template<class T> struct rb_tree_const_iterator;
 
 	//rb tree value_traits
 	template<class T, bool>
-	//ĬϿTpairʱ
+	//默认款用于T不是pair类型时
 	struct rb_tree_value_traits_imp
 	{
-		using key_type		= T;//=T
-		using mapped_type	= T;//ӳ=Tڴ˽ռλʵã
-		using value_type	= T;//ֵ=T
+		using key_type		= T;//键类型=T
+		using mapped_type	= T;//映射类型=T（在此仅占位，无实际作用）
+		using value_type	= T;//值类型=T
 
 		template<class Ty>
 		static const key_type& get_key(const Ty& value)
@@ -45,22 +45,22 @@ namespace mystl
 		}
 	};
 
-	//ػpair(true)
+	//特化适用于pair类型(true)
 	template<class T>
 	struct rb_tree_value_traits_imp<T, true>
 	{
-		using key_type		= typename mystl::remove_cv<typename T::first_type>::type;//=pair::first
-		using mapped_type	= typename T::second_type;//ӳֵ=pair::second
-		using value_type	= T;//ֵ=pair
+		using key_type		= typename mystl::remove_cv<typename T::first_type>::type;//键类型=pair::first
+		using mapped_type	= typename T::second_type;//映射值类型=pair::second
+		using value_type	= T;//值类型=pair
 
-		// ȡ pairfirst
+		// 提取键：返回 pair的first
 		template <class Ty>
 		static const key_type& get_key(const Ty& value)
 		{
 			return value.first;
 		}
 
-		// ȡֵpair
+		// 提取值：返回pair本身
 		template <class Ty>
 		static const value_type& get_value(const Ty& value)
 		{
@@ -68,7 +68,7 @@ namespace mystl
 		}
 	};
 
-	//ⲿװ
+	//外部封装
 	template<class T>
 	struct rb_tree_value_traits
 	{
@@ -92,7 +92,7 @@ namespace mystl
 		}
 	};
 
-	//ڵע
+	//节点的特性注册
 	template <class T>
 	struct rb_tree_node_traits
 	{
@@ -107,7 +107,7 @@ namespace mystl
 		using node_ptr		= rb_tree_node<T>*;
 	};
 
-	// rb tree Ľڵ
+	// rb tree 的节点设计
 	template <class T>
 	struct rb_tree_node_base
 	{
@@ -115,10 +115,10 @@ namespace mystl
 		using base_ptr		= rb_tree_node_base<T>*;
 		using node_ptr		= rb_tree_node<T>*;
 
-		base_ptr   parent;  // ڵ
-		base_ptr   left;    // ӽڵ
-		base_ptr   right;   // ӽڵ
-		color_type color;   // ڵɫ
+		base_ptr   parent;  // 父节点
+		base_ptr   left;    // 左子节点
+		base_ptr   right;   // 右子节点
+		color_type color;   // 节点颜色
 
 		base_ptr get_base_ptr()
 		{
@@ -142,7 +142,7 @@ namespace mystl
 
 
 
-	//ע
+	//迭代器的特性注册
 	template <class T>
 	struct rb_tree_traits
 	{
@@ -164,29 +164,29 @@ namespace mystl
 		using node_ptr			= node_type*;
 	};
 
-	// rb_treeĵ
+	// rb_tree的迭代器设计
 	template<class T>
 	struct rb_tree_iterator_base :public mystl::iterator<mystl::bidirectional_iterator_tag, T>
 	{
 		typedef typename rb_tree_traits<T>::base_ptr base_ptr;
 
-		base_ptr node;//ָǰڵ㱾
+		base_ptr node;//指向当前节点本身
 
 		rb_tree_iterator_base() :node(nullptr) {}
 
-		//ǰ
-		//ĺ̲ңң
+		//迭代器前进
+		//中序遍历的后继查找（左中右）
 		void inc()
 		{
 			if (node->right != nullptr)
 			{
-				node = rb_tree_min(node->right);//ڵ
+				node = rb_tree_min(node->right);//返回右子树的最左节点
 			}
-			else//ûӽڵ
+			else//没有右子节点
 			{
-				//ҵһȽڵʹõǰڵȽڵ
+				//找到第一个祖先节点使得当前节点在祖先节点的左子树中
 				auto y = node->parent;
-				while (y->right == node)//ǰڵ丸ڵӽڵʱ
+				while (y->right == node)//当当前节点是其父节点的右子节点时，继续向上
 				{
 					node = y;
 					y = y->parent;
@@ -198,22 +198,22 @@ namespace mystl
 			}
 		}
 
-		//
-		//Ϊң˺
+		//迭代器后退
+		//中续遍历为左中右，退后即找右
 		void dec()
 		{
 			if (node->parent->parent == node && rb_tree_is_red(node))
 			{
-				//nodeǸڵ
-				node = node->right;//ָmaxڵ
+				//如果node是根节点
+				node = node->right;//指向整棵树的max节点
 			}
 			else if (node->left != nullptr)
 			{
-				node = rb_tree_max(node->left);//ҽڵ
+				node = rb_tree_max(node->left);//左子树的最右节点
 			}
 			else
 			{
-				//ǸڵҲûӽڵ
+				//不是根节点也没有左子节点
 				auto y = node->parent;
 				while (node == y->left)
 				{
@@ -245,14 +245,14 @@ namespace mystl
 
 		using rb_tree_iterator_base<T>::node;
 
-		// 캯
+		// 构造函数
 		rb_tree_iterator() {}
 		rb_tree_iterator(base_ptr x) { node = x; }
 		rb_tree_iterator(node_ptr x) { node = x; }
 		rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
 		rb_tree_iterator(const const_iterator& rhs) { node = rhs.node; }
 
-		// ز
+		// 重载操作符
 		reference operator*()  const { return node->get_node_ptr()->value; }
 		pointer   operator->() const { return &(operator*()); }
 
@@ -297,14 +297,14 @@ namespace mystl
 
 		using rb_tree_iterator_base<T>::node;
 
-		// 캯
+		// 构造函数
 		rb_tree_const_iterator() {}
 		rb_tree_const_iterator(base_ptr x) { node = x; }
 		rb_tree_const_iterator(node_ptr x) { node = x; }
 		rb_tree_const_iterator(const iterator& rhs) { node = rhs.node; }
 		rb_tree_const_iterator(const const_iterator& rhs) { node = rhs.node; }
 
-		// ز
+		// 重载操作符
 		reference operator*()  const { return node->get_node_ptr()->value; }
 		pointer   operator->() const { return &(operator*()); }
 
@@ -332,10 +332,10 @@ namespace mystl
 		}
 	};
 
-	//ؼ㷨߼
+	//关键在于下面的算法逻辑
 	//tree algorithm
 
-	//ҵСڵ
+	//找到子树最小节点
 	template<class NodePtr>
 	NodePtr rb_tree_min(NodePtr x)noexcept
 	{
@@ -345,7 +345,7 @@ namespace mystl
 		}
 		return x;
 	}
-	//ҵڵ
+	//找到子树最大节点
 	template<class NodePtr>
 	NodePtr rb_tree_max(NodePtr x)noexcept
 	{
@@ -355,25 +355,25 @@ namespace mystl
 		}
 		return x;
 	}
-	//ڵǶӽڵ
+	//节点是都是左子节点
 	template<class NodePtr>
 	bool rb_tree_is_lchild(NodePtr node)noexcept
 	{
 		return node == node->parent->left;
 	}
-	//ڵɫǷΪɫ
+	//节点颜色是否为红色
 	template<class NodePtr>
 	bool rb_tree_is_red(NodePtr node)noexcept
 	{
 		return node != nullptr && node->color == rb_tree_red;
 	}
-	//ڵɫǷΪɫ
+	//节点颜色是否为黑色
 	template <class NodePtr>
 	bool rb_tree_is_black(NodePtr& node) noexcept
 	{
 		return node->color == rb_tree_black;
 	}
-	//ɫ
+	//设置颜色
 	template <class NodePtr>
 	void rb_tree_set_black(NodePtr& node) noexcept
 	{
@@ -385,7 +385,7 @@ namespace mystl
 		node->color = rb_tree_red;
 	}
 
-	//ҵһȵǰڵĽڵ
+	//找到下一个比当前节点大的节点
 	template<class NodePtr>
 	NodePtr rb_tree_next(NodePtr node)noexcept
 	{
@@ -406,25 +406,25 @@ namespace mystl
 	|      / \                   / \          |
 	|     b   c                 a   b         |
 	\*---------------------------------------*/
-	//һΪ㣬Ϊڵ
+	//左旋，参数一为左旋点，参数二为根节点
 	template<class NodePtr>
 	void rb_tree_rotate_left(NodePtr x, NodePtr& root)noexcept
 	{
 		auto y = x->right;
 		x->right = y->left;
 		if (y->left != nullptr)
-			y->left->parent = x;//ȷ
+			y->left->parent = x;//正确绑定
 		y->parent = x->parent;
 
-		if (x == root)//xΪڵ㣬yxΪڵ
+		if (x == root)//如果x为根节点，让y顶替x成为根节点
 		{
 			root = y;
 		}
-		else if (rb_tree_is_lchild(x))//xӽڵ
+		else if (rb_tree_is_lchild(x))//如果x是左子节点
 		{
 			x->parent->left = y;
 		}
-		else//xӽڵ
+		else//如果x是右子节点
 		{
 			x->parent->right = y;
 		}
@@ -442,7 +442,7 @@ namespace mystl
 	|    / \                           / \     |
 	|   b   c                         c   a    |
 	\*----------------------------------------*/
-	// һΪ㣬Ϊڵ
+	// 右旋，参数一为右旋点，参数二为根节点
 	template<class NodePtr>
 	void rb_tree_rotate_right(NodePtr x, NodePtr& root)noexcept
 	{
@@ -452,59 +452,59 @@ namespace mystl
 			y->right->parent = x;
 		y->parent = x->parent;
 		if (x == root)
-		{ //  x Ϊڵ㣬 y  x Ϊڵ
+		{ // 如果 x 为根节点，让 y 顶替 x 成为根节点
 			root = y;
 		}
 		else if (rb_tree_is_lchild(x))
-		{ //  x ӽڵ
+		{ // 如果 x 是右子节点
 			x->parent->left = y;
 		}
 		else
-		{ //  x ӽڵ
+		{ // 如果 x 是左子节点
 			x->parent->right = y;
 		}
-		//  x  y Ĺϵ
+		// 调整 x 与 y 的关系
 		y->right = x;
 		x->parent = y;
 	}
 
-	//ڵҪʹƽ⣬һΪѾնĹ뵫δ½ڵ㣬Ϊڵ
+	//插入节点后需要使红黑树重新平衡，参数一为已经按照二叉搜索树的规则插入但未调整的新节点，参数二为根节点
 
 	template<class NodePtr>
 	void rb_tree_insert_rebalance(NodePtr x, NodePtr& root)noexcept
 	{
-		rb_tree_set_red(x);//ĬڵΪɫ
-		while (x != root && rb_tree_is_red(x->parent))//ڵͻ
+		rb_tree_set_red(x);//默认新增节点为红色
+		while (x != root && rb_tree_is_red(x->parent))//连续红节点冲突
 		{
-			if (rb_tree_is_lchild(x->parent))//ڵӽڵ
+			if (rb_tree_is_lchild(x->parent))//如果父节点是左子节点
 			{
 				auto uncle = x->parent->right;
 				if (uncle != nullptr && rb_tree_is_red(uncle))
 				{
-					//ڵڵΪɫ
+					//父节点与叔叔节点均为红色
 					rb_tree_set_black(x->parent);
 					rb_tree_set_black(uncle);
 					x = x->parent->parent;
 					rb_tree_set_red(x);
-					// ʱ游ڵΪ죬ܻƻʣ
+					// 此时祖父节点为红，可能会破坏红黑树的性质，继续处理
 				}
 				else
 				{
-					//ڵڵΪ
+					//无叔叔节点或叔叔节点为黑
 					if (!rb_tree_is_lchild(x))
 					{
-						//ǰڵΪӽڵ
+						//当前节点为右子节点
 						x = x->parent;
 						rb_tree_rotate_left(x, root);
 					}
-					//תΪǰڵΪӽڵ
+					//都转变为当前节点为左子节点的情况
 					rb_tree_set_black(x->parent);
 					rb_tree_set_red(x->parent->parent);
 					rb_tree_rotate_right(x->parent->parent, root);
 					break;
 				}
 			}
-			else//ڵҽڵ㣬Գƴ
+			else//父节点是右节点，对称处理
 			{
 				auto uncle = x->parent->left;
 				if (uncle != nullptr && rb_tree_is_red(uncle))
@@ -528,33 +528,33 @@ namespace mystl
 				}
 			}
 		}
-		rb_tree_set_black(root);  // ڵԶΪ
+		rb_tree_set_black(root);  // 根节点永远为黑
 	}
 
 
 	template<class NodePtr>
 	NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, NodePtr& rightmost)
 	{
-		//ڵ滻
-		//yǿܵ滻ڵ㣬ָҪɾĽڵ
+		//节点替换部分
+		//y是可能的替换节点，指向最终要物理删除的节点
 		auto y = (z->left == nullptr || z->right == nullptr) ? z : rb_tree_next(z);
 
-		//xyһӽڵNILڵ
+		//x是y的一个独子节点或NIL节点
 		auto x = y->left != nullptr ? y->left : y->right;
 
-		//xĸڵ
+		//x的父节点
 		NodePtr xp = nullptr;
 
-		//ǿӽڵ㣬yzֱӺ̣ڵ㣬xyӽڵ
-		//yzλãxyλãyָz
+		//有两个非空子节点，y是z的直接后继，即右子树的最左节点，x是y的右子节点
+		//用y顶替z的位置，用x顶替y的位置，最后用y指向z
 		if (y != z)
 		{
-			//yӽڵ
+			//处理y的左子节点
 			z->left->parent = y;
 			y->left = z->left;
 
-			//yӽڵ
-			//yzӽڵ㣬ôzӽڵһ
+			//处理y的右子节点
+			//如果y不是z的右子节点，那么z的右子节点一定有左孩子
 			if (y != z->right)
 			{
 				xp = y->parent;
@@ -562,16 +562,16 @@ namespace mystl
 				{
 					x->parent = y->parent;
 				}
-				y->parent->left = x;//xyλ
+				y->parent->left = x;//x顶替y的位置
 				y->right = z->right;
 				z->right->parent = y;
 			}
-			else//yzֱӽڵ,Ҫ⴦y->parent->left
+			else//y是z的直接右子节点,这种情况不需要特殊处理y->parent->left
 			{
 				xp = y;
 			}
 
-			//yzĸڵ
+			//处理y与z的父节点链接
 			if (root == z)
 				root = y;
 			else if (rb_tree_is_lchild(z))
@@ -582,15 +582,15 @@ namespace mystl
 			mystl::swap(y->color, z->color);
 			y = z;
 		}
-		//zֻһ
-		//ʱzǸɾĽڵ
+		//z至多只有一个孩子
+		//此时z就是那个将被物理删除的节点
 		else
 		{
 			xp = y->parent;
 			if (x)
 				x->parent = y->parent;
 
-			//  x  z ĸڵ
+			// 连接 x 与 z 的父节点
 			if (root == z)
 				root = x;
 			else if (rb_tree_is_lchild(z))
@@ -598,31 +598,31 @@ namespace mystl
 			else
 				z->parent->right = x;
 
-			// ʱ z пڵҽڵ㣬
+			// 此时 z 有可能是最左节点或最右节点，更新数据
 			if (leftmost == z)
 				leftmost = x == nullptr ? xp : rb_tree_min(x);
 			if (rightmost == z)
 				rightmost = x == nullptr ? xp : rb_tree_max(x);
 		}
-		// ˣz y 滻 zٽ y Ϊ zָҪɾĽڵ㡣
-		// x ָ滻 z ԭλõĽڵ㣨 z ֻһӽڵ㣬x ӽڵ㣬 x  nullptr
+		// 至此，z（或被 y 替换的 z，再将 y 设为 z）指向了要被物理删除的节点。
+		// x 指向了替换 z 原位置的节点（或者如果 z 只有一个子节点，x 就是这个子节点，或者 x 是 nullptr）。
 
 
-		//ƽ
-		// ʱy ָҪɾĽڵ㣬x Ϊڵ㣬 x ڵ㿪ʼ
-		// ɾĽڵΪɫûбƻx ΪӽڵΪ
-		// case 1: ֵܽڵΪɫڵΪ죬ֵܽڵΪڣң
-		// case 2: ֵܽڵΪɫӽڵ㶼Ϊɫ NILֵܽڵΪ죬ڵΪǰڵ㣬
-		// case 3: ֵܽڵΪɫӽڵΪɫ NILӽڵΪɫ NIL
-		//         ֵܽڵΪ죬ֵܽڵӽڵΪڣֵܽڵΪ֧ң
-		// case 4: ֵܽڵΪɫӽڵΪɫֵܽڵΪڵɫڵΪɫֵܽڵӽڵ
-		//         ΪɫԸڵΪ֧ңʵɣ㷨
+		//再平衡策略
+		// 此时，y 指向要删除的节点，x 为替代节点，从 x 节点开始调整。
+		// 如果删除的节点为红色，树的性质没有被破坏，否则按照以下情况调整（x 为左子节点为例）：
+		// case 1: 兄弟节点为红色，令父节点为红，兄弟节点为黑，进行左（右）旋，继续处理
+		// case 2: 兄弟节点为黑色，且两个子节点都为黑色或 NIL，令兄弟节点为红，父节点成为当前节点，继续处理
+		// case 3: 兄弟节点为黑色，左子节点为红色或 NIL，右子节点为黑色或 NIL，
+		//         令兄弟节点为红，兄弟节点的左子节点为黑，以兄弟节点为支点右（左）旋，继续处理
+		// case 4: 兄弟节点为黑色，右子节点为红色，令兄弟节点为父节点的颜色，父节点为黑色，兄弟节点的右子节点
+		//         为黑色，以父节点为支点左（右）旋，树的性质调整完成，算法结束
 		if (!rb_tree_is_red(y))
-		{ // x Ϊɫʱֱӽ x Ϊɫ
+		{ // x 为黑色时，调整，否则直接将 x 变为黑色即可
 			while (x != root && (x == nullptr || !rb_tree_is_red(x)))
 			{
 				if (x == xp->left)
-				{ //  x Ϊӽڵ
+				{ // 如果 x 为左子节点
 					auto brother = xp->right;
 					if (rb_tree_is_red(brother))
 					{ // case 1
@@ -631,7 +631,7 @@ namespace mystl
 						rb_tree_rotate_left(xp, root);
 						brother = xp->right;
 					}
-					// case 1 תΪΪ case 234 еһ
+					// case 1 转为为了 case 2、3、4 中的一种
 					if (brother == nullptr)
 					{
 						x = xp;
@@ -654,7 +654,7 @@ namespace mystl
 							rb_tree_rotate_right(brother, root);
 							brother = xp->right;
 						}
-						// תΪ case 4
+						// 转为 case 4
 						brother->color = xp->color;
 						rb_tree_set_black(xp);
 						if (brother->right != nullptr)
@@ -663,7 +663,7 @@ namespace mystl
 						break;
 					}
 				}
-				else  // x Ϊӽڵ㣬Գƴ
+				else  // x 为右子节点，对称处理
 				{
 					auto brother = xp->left;
 					if (rb_tree_is_red(brother))
@@ -695,7 +695,7 @@ namespace mystl
 							rb_tree_rotate_left(brother, root);
 							brother = xp->left;
 						}
-						// תΪ case 4
+						// 转为 case 4
 						brother->color = xp->color;
 						rb_tree_set_black(xp);
 						if (brother->left != nullptr)
@@ -711,8 +711,8 @@ namespace mystl
 		return y;
 	}
 
-	//ģrb_tree
-	//CompareֵȽ
+	//模板类rb_tree
+	//Compare代表键值比较类型
 	template<class T,class Compare>
 	class rb_tree
 	{
@@ -750,19 +750,19 @@ namespace mystl
 		key_compare    key_comp()      const { return key_comp_; }
 
 	private:
-		//ݳԱ
-		base_ptr    header_;      // ڵ㣬ڵ㻥ΪԷĸڵ,ҷֱָСڵ
-		size_type   node_count_;  // ڵ
-		key_compare key_comp_;    // ڵֵȽϵ׼
+		//数据成员
+		base_ptr    header_;      // 特殊节点，与根节点互为对方的父节点,其左右分别指向最小和最大节点
+		size_type   node_count_;  // 节点数
+		key_compare key_comp_;    // 节点键值比较的准则
 
 	private:
-		// ȡøڵ㣬Сڵڵ
+		// 以下三个函数用于取得根节点，最小节点和最大节点
 		base_ptr& root()      const { return header_->parent; }
 		base_ptr& leftmost()  const { return header_->left; }
 		base_ptr& rightmost() const { return header_->right; }
 
 	public:
-		// 졢ơ
+		// 构造、复制、析构函数
 		rb_tree() { rb_tree_init(); }
 
 		rb_tree(const rb_tree& rhs);
@@ -774,7 +774,7 @@ namespace mystl
 		~rb_tree() { clear(); }
 
 	public:
-		// ز
+		// 迭代器相关操作
 
 		iterator               begin()         noexcept
 		{return leftmost();}
@@ -803,12 +803,12 @@ namespace mystl
 		const_reverse_iterator crend()   const noexcept
 		{return rend();}
 
-		// ز
+		// 容量相关操作
 		bool      empty()    const noexcept { return node_count_ == 0; }
 		size_type size()     const noexcept { return node_count_; }
 		size_type max_size() const noexcept { return static_cast<size_type>(-1); }
 
-		// ɾز
+		// 插入删除相关操作
 
 		 // emplace
 		template <class ...Args>
@@ -883,7 +883,7 @@ namespace mystl
 
 		void      clear();
 
-		// rb_tree ز
+		// rb_tree 相关操作
 
 		iterator       find(const key_type& key);
 		const_iterator find(const key_type& key) const;
@@ -959,7 +959,7 @@ namespace mystl
 	};
 
 
-	// ƹ캯
+	// 复制构造函数
 	template <class T, class Compare>
 	rb_tree<T, Compare>::rb_tree(const rb_tree& rhs)
 	{
@@ -974,7 +974,7 @@ namespace mystl
 		key_comp_ = rhs.key_comp_;
 	}
 
-	//ƶ캯
+	//移动构造函数
 	template <class T, class Compare>
 	rb_tree<T, Compare>::rb_tree(rb_tree&& rhs) noexcept
 		:header_(mystl::move(rhs.header_)),
@@ -984,7 +984,7 @@ namespace mystl
 		rhs.reset();
 	}
 
-	// Ƹֵ
+	// 复制赋值操作符
 	template <class T, class Compare>
 	rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(const rb_tree& rhs)
 	{
@@ -1005,7 +1005,7 @@ namespace mystl
 		return *this;
 	}
 
-	// ƶֵ
+	// 移动赋值操作符
 	template <class T, class Compare>
 	rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(rb_tree&& rhs)
 	{
@@ -1013,11 +1013,11 @@ namespace mystl
 		header_ = mystl::move(rhs.header_);
 		node_count_ = rhs.node_count_;
 		key_comp_ = rhs.key_comp_;
-		rhs.reset();//עⲻclear
+		rhs.reset();//注意不是clear
 		return *this;
 	}
 
-	// ͵زԪأֵظ
+	// 就地插入元素，键值允许重复
 	template <class T, class Compare>
 	template <class ...Args>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::emplace_multi(Args&& ...args)
@@ -1028,7 +1028,7 @@ namespace mystl
 		return insert_node_at(res.first, np, res.second);
 	}
 
-	// ͵زԪأֵظ
+	// 就地插入元素，键值不允许重复
 	template <class T, class Compare>
 	template <class ...Args>
 	mystl::pair<typename rb_tree<T, Compare>::iterator, bool> rb_tree<T, Compare>::emplace_unique(Args&& ...args)
@@ -1037,14 +1037,14 @@ namespace mystl
 		node_ptr np = create_node(mystl::forward<Args>(args)...);
 		auto res = get_insert_unique_pos(value_traits::get_key(np->value));
 		if (res.second)
-		{ // ɹ
+		{ // 插入成功
 			return mystl::make_pair(insert_node_at(res.first.first, np, res.first.second), true);
 		}
 		destroy_node(np);
-		return mystl::make_pair(iterator(res.first.first), false);//Ѿ
+		return mystl::make_pair(iterator(res.first.first), false);//已经存在了
 	}
 
-	// ͵زԪأֵظ hint λλýӽʱʱ临ӶȿԽ
+	// 就地插入元素，键值允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
 	template <class T, class Compare>
 	template <class ...Args>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::emplace_multi_use_hint(iterator hint, Args&& ...args)
@@ -1057,7 +1057,7 @@ namespace mystl
 		}
 		key_type key = value_traits::get_key(np->value);
 		if (hint == begin())
-		{ // λ begin 
+		{ // 位于 begin 处
 			if (key_comp_(key, value_traits::get_key(*hint)))
 			{
 				return insert_node_at(hint.node, np, true);
@@ -1069,7 +1069,7 @@ namespace mystl
 			}
 		}
 		else if (hint == end())
-		{ // λ end 
+		{ // 位于 end 处
 			if (!key_comp_(key, value_traits::get_key(rightmost()->get_node_ptr()->value)))
 			{
 				return insert_node_at(rightmost(), np, false);
@@ -1083,7 +1083,7 @@ namespace mystl
 		return insert_multi_use_hint(hint, key, np);
 	}
 
-	// ͵زԪأֵظ hint λλýӽʱʱ临ӶȿԽ
+	// 就地插入元素，键值不允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
 	template<class T, class Compare>
 	template<class ...Args>
 	typename rb_tree<T, Compare>::iterator
@@ -1098,7 +1098,7 @@ namespace mystl
 		}
 		key_type key = value_traits::get_key(np->value);
 		if (hint == begin())
-		{ // λ begin 
+		{ // 位于 begin 处
 			if (key_comp_(key, value_traits::get_key(*hint)))
 			{
 				return insert_node_at(hint.node, np, true);
@@ -1115,7 +1115,7 @@ namespace mystl
 			}
 		}
 		else if (hint == end())
-		{ // λ end 
+		{ // 位于 end 处
 			if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key))
 			{
 				return insert_node_at(rightmost(), np, false);
@@ -1135,7 +1135,7 @@ namespace mystl
 	}
 
 
-	// Ԫأڵֵظ
+	// 插入元素，节点键值允许重复
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_multi(const value_type& value)
 	{
@@ -1144,21 +1144,21 @@ namespace mystl
 		return insert_value_at(res.first, value, res.second);
 	}
 
-	// ֵڵֵظһ pairɹpair ĵڶΪ trueΪ false
+	// 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
 	template <class T, class Compare>
 	mystl::pair<typename rb_tree<T, Compare>::iterator, bool> rb_tree<T, Compare>::insert_unique(const value_type& value)
 	{
 		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
 		auto res = get_insert_unique_pos(value_traits::get_key(value));
 		if (res.second)
-		{ // ɹ
+		{ // 插入成功
 			return mystl::make_pair(insert_value_at(res.first.first, value, res.first.second), true);
 		}
 		return mystl::make_pair(res.first.first, false);
 	}
 
 
-	// ɾ hint λõĽڵ
+	// 删除 hint 位置的节点
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::erase(iterator hint)
 	{
@@ -1172,7 +1172,7 @@ namespace mystl
 		return next;
 	}
 
-	// ɾֵ key Ԫأɾĸ
+	// 删除键值等于 key 的元素，返回删除的个数
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::size_type rb_tree<T, Compare>::erase_multi(const key_type& key)
 	{
@@ -1182,7 +1182,7 @@ namespace mystl
 		return n;
 	}
 
-	// ɾֵ key Ԫأɾĸ
+	// 删除键值等于 key 的元素，返回删除的个数
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::size_type rb_tree<T, Compare>::erase_unique(const key_type& key)
 	{
@@ -1195,7 +1195,7 @@ namespace mystl
 		return 0;
 	}
 
-	// ɾ[first, last)ڵԪ
+	// 删除[first, last)区间内的元素
 	template <class T, class Compare>
 	void rb_tree<T, Compare>:: erase(iterator first, iterator last)
 	{
@@ -1210,7 +1210,7 @@ namespace mystl
 		}
 	}
 
-	//  rb tree
+	// 清空 rb tree
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::clear()
 	{
@@ -1224,20 +1224,20 @@ namespace mystl
 		}
 	}
 
-	// ҼֵΪ k Ľڵ㣬ָĵ
+	// 查找键值为 k 的节点，返回指向它的迭代器
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::find(const key_type& key)
 	{
-		auto y = header_;  // һС key Ľڵ
+		auto y = header_;  // 最后一个不小于 key 的节点
 		auto x = root();
 		while (x != nullptr)
 		{
 			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-			{ // key Сڵ x ֵ
+			{ // key 小于等于 x 键值，向左走
 				y = x, x = x->left;
 			}
 			else
-			{ // key  x ֵ
+			{ // key 大于 x 键值，向右走
 				x = x->right;
 			}
 		}
@@ -1248,16 +1248,16 @@ namespace mystl
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::find(const key_type& key) const
 	{
-		auto y = header_;  // һС key Ľڵ
+		auto y = header_;  // 最后一个不小于 key 的节点
 		auto x = root();
 		while (x != nullptr)
 		{
 			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-			{ // key Сڵ x ֵ
+			{ // key 小于等于 x 键值，向左走
 				y = x, x = x->left;
 			}
 			else
-			{ // key  x ֵ
+			{ // key 大于 x 键值，向右走
 				x = x->right;
 			}
 		}
@@ -1265,7 +1265,7 @@ namespace mystl
 		return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 	}
 
-	// ֵС key ĵһλ
+	// 键值不小于 key 的第一个位置
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::lower_bound(const key_type& key)
 	{
@@ -1304,7 +1304,7 @@ namespace mystl
 		return const_iterator(y);
 	}
 
-	// ֵС key һλ
+	// 键值不小于 key 的最后一个位置
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::upper_bound(const key_type& key)
 	{
@@ -1343,7 +1343,7 @@ namespace mystl
 		return const_iterator(y);
 	}
 
-	//  rb tree
+	// 交换 rb tree
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept
 	{
@@ -1358,7 +1358,7 @@ namespace mystl
 
 	// helper function
 
-	// һ
+	// 创建一个结点
 	template <class T, class Compare>
 	template <class ...Args>
 	typename rb_tree<T, Compare>::node_ptr rb_tree<T, Compare>::create_node(Args&&... args)
@@ -1379,7 +1379,7 @@ namespace mystl
 		return tmp;
 	}
 
-	// һ
+	// 复制一个结点
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::node_ptr rb_tree<T, Compare>::clone_node(base_ptr x)
 	{
@@ -1390,7 +1390,7 @@ namespace mystl
 		return tmp;
 	}
 
-	// һ
+	// 销毁一个结点
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::destroy_node(node_ptr p)
 	{
@@ -1398,20 +1398,20 @@ namespace mystl
 		node_allocator::deallocate(p);
 	}
 
-	// ʼ
+	// 初始化容器
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::rb_tree_init()
 	{
 		header_ = base_allocator::allocate(1);
-		header_->color = rb_tree_red;  // header_ ڵɫΪ죬 root 
+		header_->color = rb_tree_red;  // header_ 节点颜色为红，与 root 区分
 		root() = nullptr;
 		leftmost() = header_;
 		rightmost() = header_;
 		node_count_ = 0;
 	}
 
-	// reset 
-	//עclear
+	// reset 函数
+	//注意是弱化的clear
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::reset()
 	{
@@ -1419,7 +1419,7 @@ namespace mystl
 		node_count_ = 0;
 	}
 
-	// get_insert_multi_pos 
+	// get_insert_multi_pos 函数
 	template <class T, class Compare>
 	mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>
 		rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key)
@@ -1430,50 +1430,50 @@ namespace mystl
 		while (x != nullptr)
 		{
 			y = x;
-			//ظkeyڵxΪfalse
+			//由于允许重复，所以key大于等于x就为false
 			add_to_left = key_comp_(key, value_traits::get_key(x->get_node_ptr()->value));
 			x = add_to_left ? x->left : x->right;
 		}
 		return mystl::make_pair(y, add_to_left);
 	}
 
-	// get_insert_unique_pos 
+	// get_insert_unique_pos 函数
 	template <class T, class Compare>
 	mystl::pair<mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
 		rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
-	{ // һ pairһֵΪһ pairĸڵһ bool ʾǷ߲룬
-	  // ڶֵΪһ boolʾǷɹ
+	{ // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
+	  // 第二个值为一个 bool，表示是否插入成功
 		auto x = root();
 		auto y = header_;
-		bool add_to_left = true;  // ΪʱҲ header_ ߲
+		bool add_to_left = true;  // 树为空时也在 header_ 左边插入
 		while (x != nullptr)
 		{
 			y = x;
 			add_to_left = key_comp_(key, value_traits::get_key(x->get_node_ptr()->value));
 			x = add_to_left ? x->left : x->right;
 		}
-		iterator j = iterator(y);  // ʱ y Ϊĸڵ
+		iterator j = iterator(y);  // 此时 y 为插入点的父节点
 		if (add_to_left)
 		{
 			if (y == header_ || j == begin())
-			{ // Ϊڵ㴦϶ԲµĽڵ
+			{ // 如果树为空树或插入点在最左节点处，肯定可以插入新的节点
 				return mystl::make_pair(mystl::make_pair(y, true), true);
 			}
 			else
-			{ // ظڵ㣬ô --j ظֵ
+			{ // 否则，如果存在重复节点，那么 --j 就是重复的值
 				--j;
 			}
 		}
 		if (key_comp_(value_traits::get_key(*j), key))
-		{ // ½ڵûظ
+		{ // 表明新节点没有重复
 			return mystl::make_pair(mystl::make_pair(y, add_to_left), true);
 		}
-		// ˣʾ½ڵнڵֵظ
+		// 进行至此，表示新节点与现有节点键值重复
 		return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
 	}
 
-	// insert_value_at 
-	// x Ϊĸڵ㣬 value ΪҪֵadd_to_left ʾǷ߲
+	// insert_value_at 函数
+	// x 为插入点的父节点， value 为要插入的值，add_to_left 表示是否在左边插入
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator
 		rb_tree<T, Compare>::
@@ -1505,8 +1505,8 @@ namespace mystl
 		return iterator(node);
 	}
 
-	//  x ڵ㴦µĽڵ
-	// x Ϊĸڵ㣬 node ΪҪĽڵ㣬add_to_left ʾǷ߲
+	// 在 x 节点处插入新的节点
+	// x 为插入点的父节点， node 为要插入的节点，add_to_left 表示是否在左边插入
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator
 		rb_tree<T, Compare>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
@@ -1536,12 +1536,12 @@ namespace mystl
 		return iterator(node);
 	}
 
-	// Ԫأֵظʹ hint
+	// 插入元素，键值允许重复，使用 hint
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator
 		rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
 	{
-		//  hint Ѱҿɲλ
+		// 在 hint 附近寻找可插入的位置
 		auto np = hint.node;
 		auto before = hint;
 		--before;
@@ -1562,12 +1562,12 @@ namespace mystl
 		return insert_node_at(pos.first, node, pos.second);
 	}
 
-	// Ԫأֵظʹ hint
+	// 插入元素，键值不允许重复，使用 hint
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::iterator
 		rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
 	{
-		//  hint Ѱҿɲλ
+		// 在 hint 附近寻找可插入的位置
 		auto np = hint.node;
 		auto before = hint;
 		--before;
@@ -1593,8 +1593,8 @@ namespace mystl
 		return insert_node_at(pos.first.first, node, pos.first.second);
 	}
 
-	// copy_from 
-	// ݹ鸴һڵ x ʼp Ϊ x ĸڵ
+	// copy_from 函数
+	// 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
 	template <class T, class Compare>
 	typename rb_tree<T, Compare>::base_ptr
 		rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
@@ -1626,8 +1626,8 @@ namespace mystl
 		return top;
 	}
 
-	// erase_since 
-	//  x ڵ㿪ʼɾýڵ㼰
+	// erase_since 函数
+	// 从 x 节点开始删除该节点及其子树
 	template <class T, class Compare>
 	void rb_tree<T, Compare>::erase_since(base_ptr x)
 	{
@@ -1640,7 +1640,7 @@ namespace mystl
 		}
 	}
 
-	// رȽϲ
+	// 重载比较操作符
 	template <class T, class Compare>
 	bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
 	{
@@ -1677,7 +1677,7 @@ namespace mystl
 		return !(lhs < rhs);
 	}
 
-	//  mystl  swap
+	// 重载 mystl 的 swap
 	template <class T, class Compare>
 	void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept
 	{
@@ -1,12 +1,12 @@
 #pragma once
-// ͷļģ set  multiset
-// set      : ϣֵʵֵԪػԶ򣬼ֵظ
-// multiset : ϣֵʵֵԪػԶ򣬼ֵظ
+// 这个头文件包含两个模板类 set 和 multiset
+// set      : 集合，键值即实值，集合内元素会自动排序，键值不允许重复
+// multiset : 集合，键值即实值，集合内元素会自动排序，键值允许重复
 
 // notes:
 //
-// 쳣֤
-// mystl::set<Key> / mystl::multiset<Key> 쳣֤µȺǿ쳣ȫ֤
+// 异常保证：
+// mystl::set<Key> / mystl::multiset<Key> 满足基本异常保证，对以下等函数做强异常安全保证：
 //   * emplace
 //   * emplace_hint
 //   * insert
@@ -15,8 +15,8 @@
 
 namespace mystl
 {
-    // ģ setֵظ
-    // һֵֵͣȽϷʽȱʡʹ mystl::less 
+    // 模板类 set，键值不允许重复
+    // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less 
     template <class Key, class Compare = mystl::less<Key>>
     class set
     {
@@ -27,12 +27,12 @@ namespace mystl
         typedef Compare    value_compare;
 
     private:
-        //  mystl::rb_tree Ϊײ
+        // 以 mystl::rb_tree 作为底层机制
         typedef mystl::rb_tree<value_type, key_compare>  base_type;
         base_type tree_;
 
     public:
-        // ʹ rb_tree ͱ
+        // 使用 rb_tree 定义的型别
         typedef typename base_type::node_type              node_type;
         typedef typename base_type::const_pointer          pointer;
         typedef typename base_type::const_pointer          const_pointer;
@@ -47,7 +47,7 @@ namespace mystl
         typedef typename base_type::allocator_type         allocator_type;
 
     public:
-        // 졢ơƶ
+        // 构造、复制、移动函数
         set() = default;
 
         template <class InputIterator>
@@ -88,13 +88,13 @@ namespace mystl
             return *this;
         }
 
-        // ؽӿ
+        // 相关接口
 
         key_compare      key_comp()      const { return tree_.key_comp(); }
         value_compare    value_comp()    const { return tree_.key_comp(); }
         allocator_type   get_allocator() const { return tree_.get_allocator(); }
 
-        // 
+        // 迭代器相关
 
         iterator               begin()         noexcept
         {
@@ -147,12 +147,12 @@ namespace mystl
             return rend();
         }
 
-        // 
+        // 容量相关
         bool                   empty()    const noexcept { return tree_.empty(); }
         size_type              size()     const noexcept { return tree_.size(); }
         size_type              max_size() const noexcept { return tree_.max_size(); }
 
-        // ɾ
+        // 插入删除操作
 
         template <class ...Args>
         pair<iterator, bool> emplace(Args&& ...args)
@@ -196,7 +196,7 @@ namespace mystl
 
         void      clear() { tree_.clear(); }
 
-        // set ز
+        // set 相关操作
 
         iterator       find(const key_type& key) { return tree_.find(key); }
         const_iterator find(const key_type& key)        const { return tree_.find(key); }
@@ -231,7 +231,7 @@ namespace mystl
         friend bool operator< (const set& lhs, const set& rhs) { return lhs.tree_ < rhs.tree_; }
     };
 
-    // رȽϲ
+    // 重载比较操作符
     template <class Key, class Compare>
     bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
     {
@@ -268,7 +268,7 @@ namespace mystl
         return !(lhs < rhs);
     }
 
-    //  mystl  swap
+    // 重载 mystl 的 swap
     template <class Key, class Compare>
     void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
     {
@@ -277,8 +277,8 @@ namespace mystl
 
     /*****************************************************************************************/
 
-    // ģ multisetֵظ
-    // һֵֵͣȽϷʽȱʡʹ mystl::less 
+    // 模板类 multiset，键值允许重复
+    // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less 
     template <class Key, class Compare = mystl::less<Key>>
     class multiset
     {
@@ -289,12 +289,12 @@ namespace mystl
         typedef Compare    value_compare;
 
     private:
-        //  mystl::rb_tree Ϊײ
+        // 以 mystl::rb_tree 作为底层机制
         typedef mystl::rb_tree<value_type, key_compare>  base_type;
-        base_type tree_;  //  rb_tree  multiset
+        base_type tree_;  // 以 rb_tree 表现 multiset
 
     public:
-        // ʹ rb_tree ͱ
+        // 使用 rb_tree 定义的型别
         typedef typename base_type::node_type              node_type;
         typedef typename base_type::const_pointer          pointer;
         typedef typename base_type::const_pointer          const_pointer;
@@ -309,7 +309,7 @@ namespace mystl
         typedef typename base_type::allocator_type         allocator_type;
 
     public:
-        // 졢ơƶ
+        // 构造、复制、移动函数
         multiset() = default;
 
         template <class InputIterator>
@@ -350,13 +350,13 @@ namespace mystl
             return *this;
         }
 
-        // ؽӿ
+        // 相关接口
 
         key_compare      key_comp()      const { return tree_.key_comp(); }
         value_compare    value_comp()    const { return tree_.key_comp(); }
         allocator_type   get_allocator() const { return tree_.get_allocator(); }
 
-        // 
+        // 迭代器相关
 
         iterator               begin()         noexcept
         {
@@ -409,12 +409,12 @@ namespace mystl
             return rend();
         }
 
-        // 
+        // 容量相关
         bool                   empty()    const noexcept { return tree_.empty(); }
         size_type              size()     const noexcept { return tree_.size(); }
         size_type              max_size() const noexcept { return tree_.max_size(); }
 
-        // ɾ
+        // 插入删除操作
 
         template <class ...Args>
         iterator emplace(Args&& ...args)
@@ -458,7 +458,7 @@ namespace mystl
 
         void           clear() { tree_.clear(); }
 
-        // multiset ز
+        // multiset 相关操作
 
         iterator       find(const key_type& key) { return tree_.find(key); }
         const_iterator find(const key_type& key)        const { return tree_.find(key); }
@@ -493,7 +493,7 @@ namespace mystl
         friend bool operator< (const multiset& lhs, const multiset& rhs) { return lhs.tree_ < rhs.tree_; }
     };
 
-    // رȽϲ
+    // 重载比较操作符
     template <class Key, class Compare>
     bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
     {
@@ -530,7 +530,7 @@ namespace mystl
         return !(lhs < rhs);
     }
 
-    //  mystl  swap
+    // 重载 mystl 的 swap
     template <class Key, class Compare>
     void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept
     {
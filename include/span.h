@@ -20,22 +20,22 @@ namespace mystl
 		using reference			= T&;
 		using const_reference	= const T&;
 
-		//
+		//迭代器相关
 		using iterator = pointer;
 		using const_iterator = const_pointer;
-		//
+		//反向迭代器
 		using reverse_iterator = mystl::reverse_iterator<iterator>;
 		using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
 
-		//캯
-		//ĬϹ캯ExtentΪ0ʱ̬Сʱ
+		//构造函数
+		//默认构造函数，仅允许在Extent为0时或动态大小时可用
 		constexpr span() noexcept :m_ptr(nullptr), m_size(0)
 		{
 			static_assert(Extent == static_cast<size_t>(-1) || Extent == 0,
 				"A default-constructed span can only have an extent of 0 or be dynamic/zero.");
 		}	
 
-		//ָͳȹ캯
+		//指针和长度构造函数
 		constexpr span(pointer ptr, size_type count) noexcept
 			: m_ptr(ptr), m_size(count)
 		{
@@ -43,13 +43,13 @@ namespace mystl
 				"Static extent must match provided count or be dynamic.");
 		}
 		
-		//Χ캯
+		//迭代器范围构造函数
 		template<typename It,
 			typename End,
 			typename =typename mystl::enable_if<
-			//ȷͿתΪelement_type
+			//确保迭代类型可以转换为element_type
 			mystl::is_convertible<decltype(*mystl::declval<It>()),element_type>::value &&
-			//֤ʱʵ
+			//保证迭代器时随机访问迭代器
 			mystl::is_same<typename mystl::iterator_traits<It>::iterator_category, mystl::random_access_iterator_tag>::value
 			>::type>
 		constexpr span(It first, End last) noexcept
@@ -61,10 +61,10 @@ namespace mystl
 		}
 		
 
-		//鹹캯
+		//数组构造函数
 		template <size_t N,
 			typename = typename mystl::enable_if<
-			// ȷԪͿתΪ span Ԫ
+			// 确保数组元素类型可转换为 span 的元素类型
 			mystl::is_convertible<element_type(*)[], T(*)[]>::value
 			>::type>
 			constexpr span(element_type(&arr)[N]) noexcept
@@ -74,13 +74,13 @@ namespace mystl
 				"Static extent must match array size or be dynamic.");
 		}
 
-		//캯 ( array, vector )
-		//Ҫ data()  size() ԱֵͿתΪ span Ԫ
+		//容器构造函数 (从 array, vector 等容器构造)
+		//需要满足容器有 data() 和 size() 成员函数，且其值类型可转换为 span 的元素类型
 		template <typename Container,
 			typename = typename mystl::enable_if<
-			//  data()  size() Ա
-			!mystl::is_array<Container>::value && // ųC飬鹹캯ͻ
-			!mystl::is_array<Container>::value &&//ųֱתΪָ
+			// 容器必须有 data() 和 size() 成员函数
+			!mystl::is_array<Container>::value && // 排除C风格数组，避免与上面的数组构造函数冲突
+			!mystl::is_array<Container>::value &&//排除直接转换为指针的情况
 			!mystl::is_convertible<Container, pointer>::value &&
 			mystl::is_convertible<decltype(mystl::declval<Container>().data()), pointer>::value &&
 			mystl::is_convertible<decltype(mystl::declval<Container>().size()), size_type>::value
@@ -92,23 +92,23 @@ namespace mystl
 				"Static extent must match container size or be dynamic.");
 		}
 
-		//ʽת캯 (ӲͬͻͬExtentspanת)
+		//隐式转换构造函数 (允许从不同类型或不同Extent的span转换)
 		template <typename U, size_t N,
 			typename =typename mystl::enable_if<
-			(Extent == static_cast<size_t>(-1) || Extent == N) && // ĿspanǶ̬ģextentƥ
-			mystl::is_convertible<U(*)[], T(*)[]>::value // U תΪ T  ( const ת)
+			(Extent == static_cast<size_t>(-1) || Extent == N) && // 目标span是动态的，或者extent匹配
+			mystl::is_convertible<U(*)[], T(*)[]>::value // U 的数组可转换为 T 的数组 (处理 const 转换)
 			>::type>
 			constexpr span(const span<U, N>& s) noexcept
 			: m_ptr(s.data()), m_size(s.size())
 		{}
 
 
-		// 캯͸ֵĬΪǳ
+		// 拷贝构造函数和赋值运算符（默认为浅拷贝）
 		constexpr span(const span& other) noexcept = default;
 		constexpr span& operator=(const span& other) noexcept = default;
 
 	public:
-		// Ԫط
+		// 元素访问
 		constexpr reference operator[](size_type idx) const noexcept
 		{
 			assert(idx < m_size && "span index out of bounds");
@@ -118,7 +118,7 @@ namespace mystl
 		constexpr reference at(size_type idx) const
 		{
 			if (idx >= m_size) {
-				// ʵSTLл׳std::out_of_rangeΪassert
+				// 在实际STL中会抛出std::out_of_range，这里简化为assert
 				assert(false && "span::at index out of range");
 			}
 			return m_ptr[idx];
@@ -138,14 +138,14 @@ namespace mystl
 
 		constexpr pointer data() const noexcept { return m_ptr; }
 
-		// С
+		// 大小和容量
 		constexpr size_type size() const noexcept { return m_size; }
 		constexpr size_type size_bytes() const noexcept { return m_size * sizeof(element_type); }
 		constexpr bool empty() const noexcept { return m_size == 0; }
 		constexpr static size_type extent() noexcept { return Extent; }
 
-		// ͼ
-		// ȡǰNԪصspan
+		// 子视图
+		// 获取前N个元素的子span
 		template <size_type Count>
 		constexpr span<T, Count> first() const noexcept
 		{
@@ -155,7 +155,7 @@ namespace mystl
 			return mystl::span<T, Count>(m_ptr, Count);
 		}
 
-		// ȡNԪصspan
+		// 获取后N个元素的子span
 		template <size_type Count>
 		constexpr span<T, Count> last() const noexcept
 		{
@@ -165,7 +165,7 @@ namespace mystl
 			return mystl::span<T, Count>(m_ptr + (m_size - Count), Count);
 		}
 
-		// ȡOffsetʼCountԪصspan
+		// 获取从Offset开始，Count个元素的子span
 		template <size_type Offset, size_type Count = static_cast<size_t>(-1)>
 		constexpr auto subspan() const noexcept
 		{
@@ -183,7 +183,7 @@ namespace mystl
 				(Count == static_cast<size_t>(-1)) ? (m_size - Offset) : Count);
 		}
 
-		// ʱ汾subspan
+		// 运行时版本的subspan
 		constexpr span<T, static_cast<size_t>(-1)> subspan(size_type offset, size_type count = static_cast<size_t>(-1)) const noexcept
 		{
 			assert(offset <= m_size && "Offset exceeds span size.");
@@ -194,7 +194,7 @@ namespace mystl
 		}
 
 	public:
-		// ֧
+		// 迭代器支持
 		constexpr iterator begin() const noexcept { return m_ptr; }
 		constexpr iterator end() const noexcept { return m_ptr + m_size; }
 
@@ -208,8 +208,8 @@ namespace mystl
 		constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
 
 	private:
-		pointer m_ptr; // ָݵָ
-		size_type m_size; // ݵĴС
+		pointer m_ptr; // 指向数据的指针
+		size_type m_size; // 数据的大小
 	};
 
 	template <typename T, size_t Extent, typename U, size_t N>
@@ -226,35 +226,35 @@ namespace mystl
 		return true;
 	}
 
-	// Ⱥ
+	// 不等号
 	template <typename T, size_t Extent, typename U, size_t N>
 	constexpr bool operator!=(const span<T, Extent>& lhs, const span<U, N>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	// Сں (ģֵȽ)
+	// 小于号 (核心：字典序比较)
 	template <typename T, size_t Extent, typename U, size_t N>
 	constexpr bool operator<(const span<T, Extent>& lhs, const span<U, N>& rhs)
 	{
 		return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	// ں
+	// 大于号
 	template <typename T, size_t Extent, typename U, size_t N>
 	constexpr bool operator>(const span<T, Extent>& lhs, const span<U, N>& rhs)
 	{
 		return rhs < lhs;
 	}
 
-	// Сڵں
+	// 小于等于号
 	template <typename T, size_t Extent, typename U, size_t N>
 	constexpr bool operator<=(const span<T, Extent>& lhs, const span<U, N>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	// ڵں
+	// 大于等于号
 	template <typename T, size_t Extent, typename U, size_t N>
 	constexpr bool operator>=(const span<T, Extent>& lhs, const span<U, N>& rhs)
 	{
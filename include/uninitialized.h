@@ -1,5 +1,5 @@
 #pragma once
-//ͷļڶδʼռ乹Ԫ
+//这个头文件用于对于未初始化空间构造元素
 #include "algobase.h"
 #include "construct.h"
 #include "iterator.h"
@@ -8,7 +8,7 @@
 namespace mystl
 {
 	// uninitialized_copy
-	//  [first, last) ϵݸƵ result ΪʼĿռ䣬ظƽλ
+	// 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 	template<class InputIter, class ForwardIter>
 	ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::true_type)
 	{
@@ -30,7 +30,7 @@ namespace mystl
 		{
 			for (; result != cur; cur--)
 			{
-				mystl::destroy(&*cur);//
+				mystl::destroy(&*cur);//撤回
 			}
 		}
 		return cur;
@@ -42,11 +42,11 @@ namespace mystl
 		return mystl::unchecked_uninit_copy(first, last, result,
 			std::is_trivially_copy_constructible<
 			typename iterator_traits<ForwardIter>::
-			value_type>{});//Ƿƽ
+			value_type>{});//是否可平凡拷贝
 	}
 
 	// uninitialized_copy_n
-	//  [first, first + n) ϵݸƵ result ΪʼĿռ䣬ظƽλ
+	// 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 	template <class InputIter, class Size, class ForwardIter>
 	ForwardIter
 		unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::true_type)
@@ -84,7 +84,7 @@ namespace mystl
 	}
 
 	// uninitialized_fill
-	//  [first, last) Ԫֵ
+	// 在 [first, last) 区间内填充元素值
 	template <class ForwardIter, class T>
 	void
 		unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type)
@@ -121,7 +121,7 @@ namespace mystl
 	}
 
 	// uninitialized_fill_n
-	//  first λÿʼ n Ԫֵλ
+	// 从 first 位置开始，填充 n 个元素值，返回填充结束的位置
 	template <class ForwardIter, class Size, class T>
 	ForwardIter
 		unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type)
@@ -159,7 +159,7 @@ namespace mystl
 	}
 
 	// uninitialized_move
-	// [first, last)ϵƶ result ΪʼĿռ䣬ƶλ
+	// 把[first, last)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 	template <class InputIter, class ForwardIter>
 	ForwardIter
 		unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::true_type)
@@ -196,7 +196,7 @@ namespace mystl
 	}
 
 	// uninitialized_move_n
-	// [first, first + n)ϵƶ result ΪʼĿռ䣬ƶλ
+	// 把[first, first + n)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 	template <class InputIter, class Size, class ForwardIter>
 	ForwardIter
 		unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::true_type)
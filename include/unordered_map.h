@@ -1,26 +1,26 @@
 #pragma once
-#include"hashtable.h"//ײǹϣ
+#include"hashtable.h"//底层是哈希表
 
-// ͷļģ unordered_map  unordered_multimap
-// ÷ map  multimap 
-// ͬʹ hashtable ΪײʵֻƣڵԪزԶ
-//ûʲôÿģƤhashtable
+// 这个头文件包含两个模板类 unordered_map 和 unordered_multimap
+// 功能与用法与 map 和 multimap 类似
+// 不同的是使用 hashtable 作为底层实现机制，容器内的元素不会自动排序
+//没什么好看的，套皮hashtable
 
 namespace mystl
 {
-	//unordered_mapֵظԶظ
-	//һֵͣʵֵͣϣȱʡʹmystl::hash
-	//ĴֵȽϷʽȱʡʹ mystl::equal_to
+	//unordered_map，键值不允许重复，不自动重复
+	//参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用mystl::hash
+	//参数四代表键值比较方式，缺省使用 mystl::equal_to
 	template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
 	class unordered_map
 	{
 	private:
-		//ʹhashtableΪײʵ
+		//使用hashtable作为底层实现
 		typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual> base_type;
 		base_type ht_;
 
 	public:
-		// ʹ hashtable ͱ  
+		// 使用 hashtable 的型别  
 
 		typedef typename base_type::allocator_type       allocator_type;
 		typedef typename base_type::key_type             key_type;
@@ -44,8 +44,8 @@ namespace mystl
 		allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 	public:
-		//졢ơƶ
-		unordered_map() :ht_(100, Hash(), KeyEqual())//ʼͰ100
+		//构造、复制、移动、析构函数
+		unordered_map() :ht_(100, Hash(), KeyEqual())//初始桶数100
 		{
 		}
 
@@ -95,18 +95,18 @@ namespace mystl
 			return *this;
 		}
 
-		unordered_map& operator=(std::initializer_list<value_type> ilist)//бʼ
+		unordered_map& operator=(std::initializer_list<value_type> ilist)//列表初始化
 		{
 			ht_.clear();
 			ht_.reserve(ilist.size());
 			for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
-				ht_.insert_unique_noresize(*first);//rehash
+				ht_.insert_unique_noresize(*first);//不触发rehash
 			return *this;
 		}
 
 		~unordered_map() = default;
 
-		// 
+		// 迭代器相关
 
 		iterator       begin()        noexcept
 		{
@@ -134,13 +134,13 @@ namespace mystl
 			return ht_.cend();
 		}
 
-		// 
+		// 容量相关
 
 		bool      empty()    const noexcept { return ht_.empty(); }
 		size_type size()     const noexcept { return ht_.size(); }
 		size_type max_size() const noexcept { return ht_.max_size(); }
 
-		// ޸
+		// 修改容器操作
 
 		// empalce / empalce_hint
 
@@ -208,7 +208,7 @@ namespace mystl
 			ht_.swap(other.ht_);
 		}
 
-		// 
+		// 查找相关
 
 		mapped_type& at(const key_type& key)
 		{
@@ -331,7 +331,7 @@ namespace mystl
 		}
 	};
 
-	// رȽϲ
+	// 重载比较操作符
 	template <class Key, class T, class Hash, class KeyEqual>
 	bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
 		const unordered_map<Key, T, Hash, KeyEqual>& rhs)
@@ -346,7 +346,7 @@ namespace mystl
 		return lhs != rhs;
 	}
 
-	//  mystl  swap
+	// 重载 mystl 的 swap
 	template <class Key, class T, class Hash, class KeyEqual>
 	void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
 		unordered_map<Key, T, Hash, KeyEqual>& rhs)
@@ -354,19 +354,19 @@ namespace mystl
 		lhs.swap(rhs);
 	}
 
-	// ģ unordered_multimapֵظ
-// һֵͣʵֵͣϣȱʡʹ mystl::hash
-// ĴֵȽϷʽȱʡʹ mystl::equal_to
+	// 模板类 unordered_multimap，键值允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mystl::hash
+// 参数四代表键值比较方式，缺省使用 mystl::equal_to
 	template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
 	class unordered_multimap
 	{
 	private:
-		// ʹ hashtable Ϊײ
+		// 使用 hashtable 作为底层机制
 		typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
 		base_type ht_;
 
 	public:
-		// ʹ hashtable ͱ
+		// 使用 hashtable 的型别
 		typedef typename base_type::allocator_type       allocator_type;
 		typedef typename base_type::key_type             key_type;
 		typedef typename base_type::mapped_type          mapped_type;
@@ -389,7 +389,7 @@ namespace mystl
 		allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 	public:
-		// 졢ơƶ
+		// 构造、复制、移动函数
 
 		unordered_multimap()
 			:ht_(100, Hash(), KeyEqual())
@@ -455,7 +455,7 @@ namespace mystl
 
 		~unordered_multimap() = default;
 
-		// 
+		// 迭代器相关
 
 		iterator       begin()        noexcept
 		{
@@ -483,13 +483,13 @@ namespace mystl
 			return ht_.cend();
 		}
 
-		// 
+		// 容量相关
 
 		bool      empty()    const noexcept { return ht_.empty(); }
 		size_type size()     const noexcept { return ht_.size(); }
 		size_type max_size() const noexcept { return ht_.max_size(); }
 
-		// ޸
+		// 修改容器相关
 
 		// emplace / emplace_hint
 
@@ -557,7 +557,7 @@ namespace mystl
 			ht_.swap(other.ht_);
 		}
 
-		// 
+		// 查找相关
 
 		size_type      count(const key_type& key) const
 		{
@@ -652,7 +652,7 @@ namespace mystl
 		}
 	};
 
-	// رȽϲ
+	// 重载比较操作符
 	template <class Key, class T, class Hash, class KeyEqual>
 	bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
 		const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
@@ -667,7 +667,7 @@ namespace mystl
 		return lhs != rhs;
 	}
 
-	//  mystl  swap
+	// 重载 mystl 的 swap
 	template <class Key, class T, class Hash, class KeyEqual>
 	void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
 		unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
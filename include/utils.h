@@ -1,18 +1,18 @@
 #pragma once
 #include "type_traits.h" 
-//ļһЩͨùߣ move, forward, swap ȺԼ pair  
+//这个文件包含一些通用工具，包括 move, forward, swap 等函数，以及 pair 等 
 namespace mystl
 {
 	// --------------------------------------------------------------------------------------
 	//                                     mem Function
 	// --------------------------------------------------------------------------------------
-	//Щǵײڴ
-	//ָڴֵָ
-	//destָҪõڴʼַָ룬valҪֵֻǰλᱻ䣩
-	//bytesҪõֽ
+	//这些都是底层内存操作函数
+	//将指定内存区域连续填充指定值
+	//dest：指向要设置的内存块的起始地址的指针，val：要用来填充的值（只有它的前八位会被用来填充）
+	//bytes：要设置的字节数
 	inline void* memset(void* dest, int val, size_t bytes)noexcept
 	{
-		unsigned char* d = static_cast<unsigned char*>(dest);//ÿԪضһֽ
+		unsigned char* d = static_cast<unsigned char*>(dest);//每个元素都是一个字节
 		for (size_t i = 0; i < bytes; i++)
 		{
 			d[i] = static_cast<unsigned char>(val);
@@ -20,7 +20,7 @@ namespace mystl
 		return dest;
 	}
 
-	//ԴڴݸƵĿڴ򣨲ص
+	//将源内存区域的内容复制到目标内存区域（不处理重叠）
 	inline void* memcpy(void* dest, const void* src, size_t bytes)noexcept
 	{
 		unsigned char* d = static_cast<unsigned char*>(dest);
@@ -31,19 +31,19 @@ namespace mystl
 		return dest;
 	}
 
-	//ԴڴƶĿڴ (ȫص)
+	//将源内存区域的内容移动到目标内存区域 (安全处理重叠)
 	inline void* memmove(void* dest, const void* src, size_t bytes) noexcept
 	{
 		unsigned char* d = static_cast<unsigned char*>(dest);
 		const unsigned char* s = static_cast<const unsigned char*>(src);
 
-		if (d < s) { // ǰ
+		if (d < s) { // 从前往后复制
 			for (size_t i = 0; i < bytes; ++i) {
 				d[i] = s[i];
 			}
 		}
-		else if (d > s) { // Ӻǰ
-			for (size_t i = bytes; i-- > 0;) { // עѭ͵ݼ
+		else if (d > s) { // 从后往前复制
+			for (size_t i = bytes; i-- > 0;) { // 注意循环条件和递减
 				d[i] = s[i];
 			}
 		}
@@ -54,9 +54,9 @@ namespace mystl
 	// --------------------------------------------------------------------------------------
 	//                                     Move Function
 	// --------------------------------------------------------------------------------------
-	//תΪֵ֧ƶ
+	//将对象转换为右值引用以支持移动语义
 	template<class T>
-	typename mystl::remove_reference<T>::type&& move(T&& arg)noexcept//T&&ֵܰҲֵܰ
+	typename mystl::remove_reference<T>::type&& move(T&& arg)noexcept//T&&既能绑定左值也能绑定右值
 	{
 		return static_cast<typename mystl::remove_reference<T>::type&&>(arg);
 	}
@@ -68,14 +68,14 @@ namespace mystl
 	void swap(T& lhs, T& rhs)
 	{
 		auto tmp(mystl::move(lhs));
-		lhs = mystl::move(rhs);//Tʵƶ/ƶֵԴЧתƣ˵
+		lhs = mystl::move(rhs);//若T实现了移动构造/移动赋值，则资源高效转移；否则回退到拷贝操作
 		rhs = mystl::move(tmp);
 	}
 
-	template<class ForwardIter1, class ForwardIter2>//ǰ
+	template<class ForwardIter1, class ForwardIter2>//前向迭代器类型
 	ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
 	{
-		for (; first1 != last1; first1++, (void)first2++)//ҿ䣬ʹvoidʽfirst2++ķֵΪѭжδʹã
+		for (; first1 != last1; first1++, (void)first2++)//左闭右开区间，使用void显式忽略first2++的返回值（因为其在循环判断中未使用）
 			mystl::swap(*first1, *first2);
 		return first2;
 	}
@@ -90,36 +90,36 @@ namespace mystl
 	//                                     Forward Function
 	// --------------------------------------------------------------------------------------
 
-	//forwardת
-	//תͨ (T&& + Ƶ)
-	//Ŀģֲֵֵֵڷͱнԭⲻشݸ
-	//ԭͣ
-	//std::remove_reference<T>::typeãƳTη
-	//argǿתΪT&&ʹ۵(C++11)ʵת
-	//۵
+	//forward完美转发
+	//完美转发用于通用引用 (T&& + 类型推导)
+	//目的：保持参数的值类别（左值还是右值），在泛型编程中将参数原封不动地传递给其他函数。
+	//原理解释：
+	//std::remove_reference<T>::type的作用：移除T的所有引用修饰符
+	//将arg强制转换为T&&，使用引用折叠规则(C++11)实现完美转发
+	//引用折叠规则：
 	//T& &->T&
 	//T&& &->T&
 	//T& &&->T&
 	//T&& &&->T&&
 
-	//ע۵ֻģƵУtemplateʹ
-	//д&&ȷֵ
+	//注意折叠规则只适用于模板参数推导中，即template的使用中
+	//如果是写死的&&是明确的右值引用
 
-	//ֵ
+	//处理左值引用
 	template<class T>
 	T&& forward(typename std::remove_reference<T>::type& arg) noexcept
 	{
 		return static_cast<T&&>(arg);
 	}
 
-	//ֵ
+	//处理右值引用
 	template<class T>
 	T&& forward(typename std::remove_reference<T>::type&& arg) noexcept
 	{
-		//T&&һֵãT&&Ϊͨ
-		//ʵͻݴֵֵֵƵΪͬͣ۵
-		//жϣis_lvalue_referenceжÿǷΪֵ
-		//ֹTΪֵֵֹͣתΪֵ
+		//T&&不一定是右值引用，T&&被称为通用
+		//引用它的实际类型会根据传入参数的值类别（左值或右值）被推导为不同的引用类型（满足折叠规则）
+		//断言判断，is_lvalue_reference判断每个类型是否为左值
+		//禁止T为左值引用类型，防止将左值误转为右值
 		static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
 		return static_cast<T&&>(arg);
 	}
@@ -128,7 +128,7 @@ namespace mystl
 	//                                     Pair Function
 	// --------------------------------------------------------------------------------------
 
-	//pair
+	//pair工具类
 	template<class T1, class T2>
 	struct pair
 	{
@@ -137,59 +137,59 @@ namespace mystl
 		first_type first;
 		second_type second;
 
-		//ĬϹ캯
-		//ʹģstd::enable_if루SFINAEɣ
-		//is_default_constructibleT1T2ĬϹʱ
-		//std::enable_ifṩvoidͣȱʧ
+		//默认构造函数
+		//使用匿名模板参数和std::enable_if进行条件编译（SFINAE技巧）
+		//如果is_default_constructible均成立，即T1和T2都可默认构造时
+		//std::enable_if提供void类型，否则缺失参数
 		template< class Other1 = T1, class Other2 = T2,
 			typename = typename std::enable_if<
 			std::is_default_constructible<Other1>::value&&
 			std::is_default_constructible<Other2>::value, void>::type>
 		constexpr pair() :first(), second() {}
 
-		//˫캯
-		//ʽ汾
+		//双参数构造函数
+		//隐式版本
 		template<class U1 = T1, class U2 = T2,
 			typename std::enable_if<
-			std::is_copy_constructible<U1>::value&&//жU1Ƿʽ
+			std::is_copy_constructible<U1>::value&&//判断U1是否可显式拷贝构造
 			std::is_copy_constructible<U2>::value&&
-			std::is_convertible<const U1&, T1>::value&&//жU1ǷʽתΪT1
+			std::is_convertible<const U1&, T1>::value&&//判断U1类型是否能隐式转换为T1
 			std::is_convertible<const U2&, T2>::value, int>::type = 0>
-		constexpr pair(const U1& a, const U2& b) ://ֵ
+		constexpr pair(const U1& a, const U2& b) ://左值引用
 			first(a), second(b) {
 		}
 
-		//ʽ汾
+		//显式版本
 		template<class U1 = T1, class U2 = T2,
 			typename std::enable_if<
 			std::is_copy_constructible<U1>::value&&
 			std::is_copy_constructible<U2>::value &&
 			(!std::is_convertible<const U1&, T1>::value ||
 				!std::is_convertible<const U2&, T2>::value), int>::type = 0>
-		explicit constexpr pair(const U1& a, const U2& b) ://explicitֹʽתȫʽ
+		explicit constexpr pair(const U1& a, const U2& b) ://explicit阻止隐式转换，必须全部显式
 			first(a), second(b) {
 		}
 
-		//ĬϿ죬Ա
+		//默认拷贝构造，逐个成员拷贝
 		pair(const pair& rhs) = default;
-		//Ĭƶ죬Աƶ
+		//默认移动构造，逐个成员移动
 		pair(pair&& rhs) = default;
 
-		//ͨת캯
-		//ʽ汾
+		//通用完美转发构造函数
+		//隐式版本
 		template<class Other1, class Other2,
 			typename std::enable_if<
-			std::is_constructible<T1, Other1&&>::value&&//жT1ǷOther1&&͹
+			std::is_constructible<T1, Other1&&>::value&&//判断T1是否能用Other1&&类型构造
 			std::is_constructible<T2, Other2&&>::value&&
 			std::is_convertible<Other1&&, T1>::value&&
 			std::is_convertible<Other2&&, T2>::value, int>::type = 0>
-		constexpr pair(Other1&& a, Other2&& b) ://ͨ
+		constexpr pair(Other1&& a, Other2&& b) ://通用引用
 			first(mystl::forward<Other1>(a)), second(mystl::forward<Other2>(b)) {
-		}//ת
-		//ͨת캯ʽ캯ͬʱʱʹʽ캯
-		//Ϊʱȸػģ壬ʹĬֵģ
+		}//完美转发
+		//通用转发构造函数与隐式构造函数条件同时满足时使用隐式构造函数
+		//因为重载时优先更特化的模板，在这里是使用了默认值的模板
 
-		//ʽ汾
+		//显式版本
 		template <class Other1, class Other2,
 			typename std::enable_if<
 			std::is_constructible<T1, Other1>::value&&
@@ -200,8 +200,8 @@ namespace mystl
 			first(mystl::forward<Other1>(a)), second(mystl::forward<Other2>(b)) {
 		}
 
-		//͹캯
-		//ֵʽ汾
+		//跨类型构造函数
+		//左值隐式版本
 		template <class Other1, class Other2,
 			typename std::enable_if<
 			std::is_constructible<T1, const Other1&>::value&&
@@ -212,7 +212,7 @@ namespace mystl
 			first(other.first), second(other.second) {
 		}
 
-		//ֵʽ汾
+		//左值显式版本
 		template <class Other1, class Other2,
 			typename std::enable_if<
 			std::is_constructible<T1, const Other1&>::value&&
@@ -223,7 +223,7 @@ namespace mystl
 			first(other.first), second(other.second) {
 		}
 
-		//ֵʽ汾
+		//右值隐式版本
 		template <class Other1, class Other2,
 			typename std::enable_if<
 			std::is_constructible<T1, Other1>::value&&
@@ -235,7 +235,7 @@ namespace mystl
 			second(mystl::forward<Other2>(other.second)) {
 		}
 
-		//ֵʽ汾
+		//右值显式版本
 		template <class Other1, class Other2,
 			typename std::enable_if<
 			std::is_constructible<T1, Other1>::value&&
@@ -247,7 +247,7 @@ namespace mystl
 			second(mystl::forward<Other2>(other.second)) {
 		}
 
-		//
+		//运算符重载
 		pair& operator=(const pair& rhs)
 		{
 			if (this != &rhs)
@@ -262,7 +262,7 @@ namespace mystl
 		{
 			if (this != &rhs)
 			{
-				first = mystl::move(rhs.first);//ǿתΪֵתƸֵ
+				first = mystl::move(rhs.first);//强制转为右值触发转移赋值
 				second = mystl::move(rhs.second);
 			}
 			return *this;
@@ -275,7 +275,7 @@ namespace mystl
 			second = other.second;
 			return *this;
 		}
-		//ⲻǹԲϸǷʽתñ
+		//这不是构造所以不用严格检查是否可以隐式转换，该报错报错
 
 		template <class Other1, class Other2>
 		pair& operator=(pair<Other1, Other2>&& other)
@@ -284,7 +284,7 @@ namespace mystl
 			second = mystl::forward<Other2>(other.second);
 			return *this;
 		}
-		//Ϊʵ֤Other͵ȣҪʹת
+		//因为这里其实并不保证Other不是引用类型等，所以需要使用完美转发
 
 		~pair() = default;
 
@@ -315,7 +315,7 @@ namespace mystl
 	template <class T1, class T2>
 	bool operator<(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
 	{
-		// ֵȽϣȱȽ first first ٱȽ second
+		// 字典序比较：先比较 first，如果 first 相等再比较 second
 		return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
 	}
 
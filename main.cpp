@@ -1,46 +1,89 @@
 #undef value
 #include <iostream>
+#include <cstring>
 #include "test/vector_test.h"
 #include "test/map_test.h"
 #include "test/set_test.h"
 #include "test/list_test.h"
 #include "test/unordered_map_test.h"
-// ļеĺ
+// 声明其他测试文件中的函数
 int test_hash_bucket_main();
 int test_simple_memory_pool_main();
 int test_mutex_main();
 int test_LockFree_main();
 int test_TCMalloc_main();
+int allocator_benchmark_main(int argc, char** argv);
 
-int main() {
-    //std::cout << "Running Combined Memory Pool Tests..." << std::endl;
+// 不带参数时运行的测试；CMake 为每个测试生成的单独可执行文件用它指定各自的测试
+#if !defined(MYSTL_TEST_DEFAULT)
+#define MYSTL_TEST_DEFAULT "vector"
+#endif
 
-    //std::cout << "\n--- Running HashBucketMemoryPool Test ---" << std::endl;
-    //test_hash_bucket_main(); //  HashBucket Ĳ
+namespace {
+    struct test_entry {
+        const char* name;
+        // 返回 0 表示通过
+        int (*run)();
+    };
 
-    //std::cout << "\n--- Running SimpleMemoryPool Test ---" << std::endl;
-    //test_simple_memory_pool_main(); //  SimpleMemoryPool Ĳ
+    // 可以按名字单独运行的测试，CMake 为每一项注册一个 ctest 用例
+    const test_entry TESTS[] = {
+        { "vector", [] { mystl::test::vector_test::vector_test(); return 0; } },
+        { "map", [] { mystl::test::map_test::map_test(); return 0; } },
+        { "multimap", [] { mystl::test::map_test::multimap_test(); return 0; } },
+        { "set", [] { mystl::test::set_test::set_test(); return 0; } },
+        { "multiset", [] { mystl::test::set_test::multiset_test(); return 0; } },
+        { "list", [] { mystl::test::list_test::list_test(); return 0; } },
+        { "unordered_map", [] { mystl::test::unordered_map_test::unordered_map_test(); return 0; } },
+        { "hash_bucket", test_hash_bucket_main },
+        { "simple_memory_pool", test_simple_memory_pool_main },
+        { "mutex_memory_pool", test_mutex_main },
+        { "lockfree_memory_pool", test_LockFree_main },
+        { "tcmalloc", test_TCMalloc_main },
+    };
 
-    //std::cout << "\n--- Running MutexMemoryPool Test ---" << std::endl;
-    //test_mutex_main();
+    // name 为 all 时运行全部测试，找不到这个名字时返回 false；有测试失败时 failed 置为 true
+    bool run_test(const char* name, bool& failed) {
+        bool found = false;
+        for (const test_entry& entry : TESTS) {
+            if (std::strcmp(name, "all") == 0 || std::strcmp(name, entry.name) == 0) {
+                std::cout << "\n--- Running " << entry.name << " Test ---" << std::endl;
+                if (entry.run() != 0) {
+                    std::cerr << entry.name << " test failed" << std::endl;
+                    failed = true;
+                }
+                found = true;
+            }
+        }
+        return found;
+    }
+}
 
-    //std::cout << "\n--- Running LockFreeMemoryPool Test ---" << std::endl;
-    //test_LockFree_main();
+// 用法：
+//   mystl                 运行 MYSTL_TEST_DEFAULT 指定的测试
+//   mystl map list ...    依次运行指定的测试
+//   mystl all             运行全部测试
+//   mystl benchmark ...   运行分配器基准测试，后面的参数交给 allocator_benchmark_main
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "benchmark") == 0) {
+        return allocator_benchmark_main(argc - 1, argv + 1);
+    }
 
-   mystl::test::vector_test::vector_test();
-
-    //mystl::test::map_test::map_test();
-    //mystl::test::map_test::multimap_test();
-
-    //mystl::test::set_test::set_test();
-    //mystl::test::set_test::multiset_test();
-
-    //mystl::test::list_test::list_test();
-
-    //mystl::test::unordered_map_test::unordered_map_test();
-
-    //std::cout << "\n--- Running TCMalloc Test ---" << std::endl;
-    //test_TCMalloc_main();
+    bool failed = false;
+    if (argc == 1 && !run_test(MYSTL_TEST_DEFAULT, failed)) {
+        std::cerr << "unknown test: " << MYSTL_TEST_DEFAULT << std::endl;
+        return 1;
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (!run_test(argv[i], failed)) {
+            std::cerr << "unknown test: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (failed) {
+        std::cerr << "\nSome Tests Failed." << std::endl;
+        return 1;
+    }
     std::cout << "\nAll Tests Finished." << std::endl;
     return 0;
-}
\ No newline at end of file
+}
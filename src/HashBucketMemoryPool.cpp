@@ -6,10 +6,10 @@
 
 namespace HashBucketMemoryPool
 {
-	//_s_pool_instances ָĬϳʼΪ nullptr
+	//_s_pool_instances 数组的指针默认初始化为 nullptr
 	SimpleMemoryPool* HashBucket::_s_pool_instances[static_cast<size_t>(HashBucketConstants::MEMORY_POOL_NUM)] = {};
 	
-	//ȷ HashBucket::initMemoryPools ִֻһεı־
+	//用于确保 HashBucket::initMemoryPools 只被执行一次的标志
 	static std::once_flag hashbucket_init_flag;
 
 
@@ -21,24 +21,24 @@ namespace HashBucketMemoryPool
 
 	size_t HashBucket::getPoolIndex(size_t size)
 	{
-		// Ĺʽ(ȡ(size / SLOT_BASE_SIZE)) - 1
+		// 计算索引的公式：(向上取整(size / SLOT_BASE_SIZE)) - 1
 		return (size + static_cast<size_t>(HashBucketConstants::SLOT_BASE_SIZE) - 1ULL) / static_cast<size_t>(HashBucketConstants::SLOT_BASE_SIZE) - 1ULL;
 	}
 
 	void HashBucket::initMemoryPools()
 	{
-		// ʹ std::call_once ֤ʼ߼ִֻһΣʹ̲߳
+		// 使用 std::call_once 保证初始化逻辑只执行一次，即使多线程并发调用
 		std::call_once(hashbucket_init_flag, []() {
 			for (int i = 0; i < static_cast<int>(HashBucketConstants::MEMORY_POOL_NUM); ++i)
 			{
-				//  new SimpleMemoryPool ʵȷ slotSize
-				// ʹ HashBucketConstants::BLOCK_SIZE_DEFAULT ΪڴС
-				// ÿضӦ slotSizeֱڹ캯
+				// 在这里 new SimpleMemoryPool 实例，并传入正确的 slotSize
+				// 使用 HashBucketConstants::BLOCK_SIZE_DEFAULT 作为大块内存大小
+				// 计算每个池对应的 slotSize，直接在构造函数中设置
 				size_t current_slot_size = (i + 1) * static_cast<size_t>(HashBucketConstants::SLOT_BASE_SIZE);
-				_s_pool_instances[i] = new SimpleMemoryPool(static_cast<size_t>(HashBucketConstants::BLOCK_SIZE_DEFAULT)); // 캯ֻ blockSize
+				_s_pool_instances[i] = new SimpleMemoryPool(static_cast<size_t>(HashBucketConstants::BLOCK_SIZE_DEFAULT)); // 构造函数只接受 blockSize
 
-				// ȷÿ´ĳضȷʼ ( init )
-				_s_pool_instances[i]->init(current_slot_size); // init  slotSize ״̬
+				// 确保每个新创建的池都被正确初始化 (调用其 init 方法)
+				_s_pool_instances[i]->init(current_slot_size); // init 方法设置 slotSize 和重置状态
 			}
 			std::cout << "HashBucket: All SimpleMemoryPools initialized." << std::endl;
 			});
@@ -46,24 +46,24 @@ namespace HashBucketMemoryPool
 
 	void* HashBucket::allocate(size_t size)
 	{
-		// гʼ飺 HashBucket::initMemoryPools() δãδ׼
-		// _s_pool_instances[0] Ӧ initMemoryPools úǷ nullptr
-		// һǷѴΪʼ־
+		// 在这里进行初始化检查：如果 HashBucket::initMemoryPools() 未被调用，池则未准备好
+		// _s_pool_instances[0] 应该在 initMemoryPools 被调用后是非 nullptr。
+		// 检查第一个池是否已创建作为初始化标志。
 		if (_s_pool_instances[0] == nullptr) {
 			std::cerr << "Error: HashBucket::initMemoryPools() not called before allocation! Exiting." << std::endl;
-			exit(1); // 򻯴ʵʿӦ׳쳣
+			exit(1); // 简化处理，实际库中应抛出异常
 		}
 
 		if (size <= 0)
 			return nullptr;
 
-		// С۴С˵ϵͳ malloc
+		// 如果请求大小超过最大槽大小，则回退到系统 malloc
 		if (size > static_cast<size_t>(HashBucketConstants::MAX_SLOT_SIZE))
 		{
-			return malloc(size); // ʹ malloc
+			return malloc(size); // 使用 malloc
 		}
 
-		// ȡӦСڴʵзڴ
+		// 获取对应大小的内存池实例，并从中分配内存
 		size_t index = getPoolIndex(size);
 		assert(index < static_cast<size_t>(HashBucketConstants::MEMORY_POOL_NUM));
 
@@ -72,23 +72,23 @@ namespace HashBucketMemoryPool
 
 	void HashBucket::deallocate(void* ptr, size_t size)
 	{
-		// гʼ
+		// 在这里进行初始化检查
 		if (_s_pool_instances[0] == nullptr) {
 			std::cerr << "Error: HashBucket::initMemoryPools() not called before deallocation!" << std::endl;
-			return; // 򻯴ֱӷ
+			return; // 简化处理，直接返回
 		}
 
 		if (ptr == nullptr)
 			return;
 
-		// Ǵ۴Сڴ棬˵ϵͳ free
+		// 如果是大于最大槽大小的内存，则回退到系统 free
 		if (size > static_cast<size_t>(HashBucketConstants::MAX_SLOT_SIZE))
 		{
-			free(ptr); // ʹ free
+			free(ptr); // 使用 free
 			return;
 		}
 
-		// ȡӦСڴʵ黹ڴ
+		// 获取对应大小的内存池实例，并向其归还内存
 		size_t index = getPoolIndex(size);
 		assert(index < static_cast<size_t>(HashBucketConstants::MEMORY_POOL_NUM));
 
@@ -96,7 +96,7 @@ namespace HashBucketMemoryPool
 	}
 
 
-	//̬Ķ壬ȷڳ˳ʱ
+	//静态清理对象的定义，确保析构函数在程序退出时运行
 	HashBucket::PoolCleaner HashBucket::_s_pool_cleaner;
 
 	HashBucket::PoolCleaner::~PoolCleaner()
@@ -105,34 +105,34 @@ namespace HashBucketMemoryPool
 		{
 			if (_s_pool_instances[i] != nullptr)
 			{
-				delete _s_pool_instances[i];//ͷڴʵ
-				_s_pool_instances[i] = nullptr;//ֹҰָ
+				delete _s_pool_instances[i];//释放内存池实例
+				_s_pool_instances[i] = nullptr;//防止野指针
 			}
 		}
 	}
 
 
-	//SimpleMemoryPoolʵ֣ǽinit
+	//SimpleMemoryPool的实现，但是将init分离出来了
 	SimpleMemoryPool::SimpleMemoryPool(size_t blockSize)
 		:BlockSize_(blockSize),
-		SlotSize_(0),// ʼʱΪ 0ȴ init 
+		SlotSize_(0),// 初始时设置为 0，等待 init 方法设置
 		firstBlock_(nullptr),
 		curSlot_(nullptr),
 		freeList_(nullptr),
 		lastSlot_(nullptr)
 	{
-		// 캯ֻԱʼٽжԻڴ
+		// 构造函数只负责成员初始化，不再进行断言或内存分配
 	}
 
 
 	SimpleMemoryPool::~SimpleMemoryPool()
 	{
-		// ͷдϵͳĴڴ
+		// 遍历并释放所有从系统申请来的大内存块
 		SimpleSlot* currentBlock = firstBlock_;
 		while (currentBlock)
 		{
-			SimpleSlot* nextBlock = currentBlock->next;//һָ
-			free(static_cast<void*>(currentBlock));//ʾתʽתҲǺϷ
+			SimpleSlot* nextBlock = currentBlock->next;//下一个块的指针
+			free(static_cast<void*>(currentBlock));//显示转换，隐式转换也是合法的
 			currentBlock = nextBlock;
 		}
 	}
@@ -140,17 +140,17 @@ namespace HashBucketMemoryPool
 
 	void SimpleMemoryPool::init(size_t slotSize)
 	{
-		assert(slotSize > 0);// ȷ۴СϷ
-		// ȷ slotSize_  SimpleSlot
+		assert(slotSize > 0);// 确保槽大小合法
+		// 确保 slotSize_ 至少能容纳 SimpleSlot
 		SlotSize_ = (slotSize < sizeof(SimpleSlot)) ? sizeof(SimpleSlot) : slotSize;
 
 
-		//֤ڴ
-		assert(SlotSize_ % sizeof(SimpleSlot*) == 0);/// ȷ۴СָСı
-		assert(BlockSize_ >= SlotSize_);//ȷ۴СָСı
+		//保证内存对齐
+		assert(SlotSize_ % sizeof(SimpleSlot*) == 0);/// 确保槽大小是指针大小的倍数
+		assert(BlockSize_ >= SlotSize_);//确保槽大小是指针大小的倍数
 
 
-		//״̬ȷشڸɾĳʼ״̬
+		//重置所有状态，确保池处于干净的初始状态
 		firstBlock_ = nullptr;
 		curSlot_ = nullptr;
 		freeList_ = nullptr;
@@ -158,67 +158,67 @@ namespace HashBucketMemoryPool
 	}
 
 
-	//ָ p ʼֱһalignĵַֽ
+	//计算从指针 p 开始，直到下一个符合align对齐的地址所需的填充字节数
 	size_t SimpleMemoryPool::padPointer(char* p, size_t align)
 	{
 		if (align == 0 || align == 1)
 			return 0;
 
-		//㵱ǰַָ
+		//计算当前指针地址对齐后的余数
 		size_t remainder = reinterpret_cast<size_t>(p) % align;
 
-		//Ϊ 0ʾѶ룬
+		//如果余数为 0，表示已对齐，无需填充
 		if (remainder == 0)
 			return 0;
 
-		//Ҫֽ
+		//返回需要填充的字节数
 		return align - remainder;
 	}
 
 
-	// ϵͳһµڴ
+	// 向系统申请一个新的内存块
 	void SimpleMemoryPool::allocateNewBlock()
 	{
-		//ϵͳһBlockSize_ Сڴ
+		//像系统申请一个BlockSize_ 大小的新内存块
 		void* newBlockRaw = malloc(BlockSize_);
 		if (!newBlockRaw)
 		{
 			std::cerr << "Error: Failed to allocate new block of size" << BlockSize_ << std::endl;
-			// ׳ std::bad_allocΪ exit
+			// 生产级代码会抛出 std::bad_alloc，这里简化为 exit
 			exit(1);
 		}
 
 
-		//¿ӵ firstBlock_ ͷ
+		//将新块添加到 firstBlock_ 链表的头部
 		SimpleSlot* blockHeader = static_cast<SimpleSlot*>(newBlockRaw);
 		blockHeader->next = firstBlock_;
-		firstBlock_ = blockHeader;// ͷΪ¿
+		firstBlock_ = blockHeader;// 更新链表头部为新块
 
 
-		//ʵʿڴʼλ (ͷָĿռ)
+		//计算实际可用内存的起始位置 (跳过块头部用于链表指针的空间)
 		char* blockBody = static_cast<char*>(newBlockRaw) + sizeof(SimpleSlot);
 
-		// blockBody һ slotSize_ ֽ
+		//计算 blockBody 到下一个 slotSize_ 对齐的填充字节
 		size_t paddingSize = padPointer(blockBody, SlotSize_);
 
-		//curSlot_ ָ򾭹ĵһ۵ʼλ
+		//curSlot_ 指向经过对齐填充后的第一个槽的起始位置
 		curSlot_ = blockBody + paddingSize;
 
-		//㵱ǰһ۵Ľ߽
+		//计算当前块中最后一个槽的结束边界
 		lastSlot_ = static_cast<char*>(newBlockRaw) + BlockSize_;
 	}
 
 
 	void* SimpleMemoryPool::allocate()
 	{
-		// ȷ init ѱãSlotSize_ 
+		// 确保 init 方法已被调用，SlotSize_ 已设置
 		if (SlotSize_ == 0) {
 			std::cerr << "Error: SimpleMemoryPool::init() not called or slotSize is 0! Exiting." << std::endl;
 			exit(1);
 		}
 
 
-		//ȴӿȡѻյĲ
+		//优先从空闲链表获取已回收的槽
 		if (freeList_ != nullptr)
 		{
 			SimpleSlot* slot = popFreeList();
@@ -226,17 +226,17 @@ namespace HashBucketMemoryPool
 		}
 
 
-		//Ϊգӵǰڴи²
-		// curSlot_ ǷѳʼǰǷпռ
-		// ֻе curSlot_ Ϊ nullptr (״η) ǰþʱҪ allocateNewBlock
+		//空闲链表为空，从当前大内存块中切割新槽
+		//检查 curSlot_ 是否已初始化或当前块是否还有空间
+		// 只有当 curSlot_ 为 nullptr (首次分配) 或当前块已用尽时，才需要 allocateNewBlock
 		if (curSlot_ == nullptr || (curSlot_ + SlotSize_) > lastSlot_)
 		{
 			allocateNewBlock();
 		}
 
 
-		//ʱ curSlot_ ϶ָ¿ʼ֮ǰʣռ
-		//ж (curSlot_ + SlotSize_) <= lastSlot_ ȻǱҪģԴ allocateNewBlock() շص
+		//此时 curSlot_ 肯定指向新块的起始，或者之前有剩余空间
+		//这行判断 (curSlot_ + SlotSize_) <= lastSlot_ 仍然是必要的，以处理 allocateNewBlock() 刚返回的情况
 		if ((curSlot_ + SlotSize_) <= lastSlot_)
 		{
 			void* slot = curSlot_;
@@ -245,7 +245,7 @@ namespace HashBucketMemoryPool
 		}
 		else
 		{
-			// ʾ allocateNewBlock() Ŀ鼴ʹµģҲ޷һ (BlockSize_ < SlotSize_)
+			// 这表示 allocateNewBlock() 分配的块即使是新的，也无法容纳一个槽 (BlockSize_ < SlotSize_)
 			std::cerr << "Error: Fresh block allocated but cannot fit a slot! Check BlockSize/SlotSize. Exiting." << std::endl;
 			exit(1);
 		}
@@ -253,26 +253,26 @@ namespace HashBucketMemoryPool
 	}
 
 
-	// ͷһڴۣ黹ڴ
+	// 释放一个内存槽，将其归还给内存池
 	void SimpleMemoryPool::deallocate(void* ptr) {
 		if (ptr == nullptr) return;
 
-		// ͷŵڴת SimpleSlot* 
+		// 将释放的内存槽转换回 SimpleSlot* 类型
 		SimpleSlot* slot = static_cast<SimpleSlot*>(ptr);
 
-		// ӵͷ
+		// 将其添加到空闲链表的头部
 		pushFreeList(slot);
 	}
 
 
-	// һͷ
+	// 将一个槽推入空闲链表头部
 	void SimpleMemoryPool::pushFreeList(SimpleSlot* slot) {
 		slot->next = freeList_;
 		freeList_ = slot;
 	}
 
 
-	// ӿͷȡһ
+	// 从空闲链表头部取出一个槽
 	SimpleSlot* SimpleMemoryPool::popFreeList() {
 		SimpleSlot* head = freeList_;
 		if (head != nullptr) {
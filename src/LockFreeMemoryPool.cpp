@@ -215,26 +215,26 @@ namespace LockFreeMemoryPool
 	}
 
 
-	//ʵӲ
+	//实现无锁入队操作
 	bool SimpleMemoryPool::pushFreeList(SimpleSlot* slot) {
 		TagAtomicSlot oldHead;
 		while (true)
 		{
-			//ȡǰͷڵ
+			//获取当前头节点
 			oldHead = freeList_.load(std::memory_order_relaxed);
-			//½ڵnextָǰͷڵ
+			//将新节点的next指向当前头节点
 			slot->next=oldHead.ptr;
 
-			//Խ½ڵΪͷڵ
+			//尝试将新节点设置为头节点
 			if (freeList_.compare_exchange_weak(oldHead,{slot,oldHead.tag+1}, std::memory_order_release, std::memory_order_relaxed))
 			{
 				return true;
 			}
-			//CASʧ
+			//CAS失败则重试
 		}
 	}
 
-	//ʵӲ
+	//实现无锁出队操作
 	SimpleSlot* SimpleMemoryPool::popFreeList() {
 		TagAtomicSlot oldHead;
 		SimpleSlot* result_slot = nullptr;
@@ -243,10 +243,10 @@ namespace LockFreeMemoryPool
 			oldHead = freeList_.load(std::memory_order_relaxed);
 			if (oldHead.ptr== nullptr)
 			{
-				return nullptr;//Ϊ
+				return nullptr;//队列为空
 			}
 
-			// ȡһڵ (ָͨ)
+			// 获取下一个节点 (普通指针)
 			SimpleSlot* newHead = oldHead.ptr->next;
 
 			if (freeList_.compare_exchange_weak(oldHead, { newHead, oldHead.tag + 1 },std::memory_order_release, std::memory_order_relaxed)) 
@@ -101,7 +101,7 @@ namespace MutexMemoryPool
 		freeList_(nullptr),
 		lastSlot_(nullptr)
 	{
-		// 캯ֻԱʼٽжԻڴ
+		// 构造函数只负责成员初始化，不再进行断言或内存分配
 	}
 
 
@@ -185,7 +185,7 @@ namespace MutexMemoryPool
 				SimpleSlot* slot = popFreeList();
 				return slot;
 			}
-		}//ʹ
+		}//使用括号限制所的生命周期
 
 
 		{
@@ -1,46 +1,147 @@
 #include "../../include/TCMalloc/CentralCache.h"
 #include "../../include/TCMalloc/PageCache.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/MetadataArena.h"
 #include "../../include/TCMalloc/TCMallocBootstrap.h"
-#include "../../include/list.h"
-#include "../../include/map.h"
-#include <iostream>
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include "../../include/TCMalloc/TCMallocTrace.h"
+#include <thread>
+#include <type_traits>
 
 namespace mystl
 {
+	namespace
+	{
+		//CentralCache 持有的一个 span，page_map 指向其中的 owner
+		//owner 放在最前面，从 page_map 查到的指针可以直接还原出整条记录
+		struct central_span
+		{
+			page_span owner;
+			//所在的占用率分组，已经分配满的 span 不在任何分组里
+			size_t bucket = 0;
+			central_span* prev = nullptr;
+			central_span* next = nullptr;
+
+			central_span(span<byte> memory, size_t unit_size, size_t node) : owner(memory, unit_size, node) {}
+		};
+		static_assert(std::is_standard_layout_v<central_span>, "central_span must start with its page_span");
+	}
+
 	class CentralCacheImpl
 	{
 	public:
-		// ˽ݳԱƵ
-		list<span<byte>> m_free_array[size_utils::CACHE_LINE_SIZE];
-		std::atomic_flag m_status[size_utils::CACHE_LINE_SIZE];
-		map<byte*, page_span> m_page_set[size_utils::CACHE_LINE_SIZE];
+		//有空闲块的 span 按已分配的比例分成几组，优先从最满的一组分配
+		//这样快空的 span 更容易整个空出来还给 PageCache
+		static constexpr size_t OCCUPANCY_BUCKETS = 8;
+
+		central_span* m_spans[size_utils::SIZE_CLASS_COUNT][OCCUPANCY_BUCKETS] = {};
+		std::atomic_flag m_status[size_utils::SIZE_CLASS_COUNT];
+		//每一级持有的 span 个数和其中的空闲块数
+		size_t m_span_count[size_utils::SIZE_CLASS_COUNT] = {};
+		size_t m_free_count[size_utils::SIZE_CLASS_COUNT] = {};
+		//span 记录从元数据池中申请，每一级一个，由这一级的锁保护
+		metadata_arena<central_span> m_span_arena[size_utils::SIZE_CLASS_COUNT];
+		//别的节点归还的块，每一级一条无锁的单链表，块之间用自身保存的指针串起来
+		std::atomic<void*> m_remote_head[size_utils::SIZE_CLASS_COUNT] = {};
+		std::atomic<size_t> m_remote_count[size_utils::SIZE_CLASS_COUNT] = {};
+
+		static size_t bucket_of(page_span& owner)
+		{
+			assert(!owner.is_full());
+			return owner.allocated_count() * OCCUPANCY_BUCKETS / owner.unit_count();
+		}
+
+		void link(size_t index, central_span* record)
+		{
+			record->bucket = bucket_of(record->owner);
+			central_span*& head = m_spans[index][record->bucket];
+			record->prev = nullptr;
+			record->next = head;
+			if (head != nullptr)
+			{
+				head->prev = record;
+			}
+			head = record;
+		}
+
+		void unlink(size_t index, central_span* record)
+		{
+			if (record->prev != nullptr)
+			{
+				record->prev->next = record->next;
+			}
+			else
+			{
+				m_spans[index][record->bucket] = record->next;
+			}
+			if (record->next != nullptr)
+			{
+				record->next->prev = record->prev;
+			}
+			record->prev = nullptr;
+			record->next = nullptr;
+		}
+
+		//最满的一个还有空闲块的 span，没有时返回 nullptr
+		central_span* fullest(size_t index)
+		{
+			for (size_t bucket = OCCUPANCY_BUCKETS; bucket-- > 0;)
+			{
+				if (m_spans[index][bucket] != nullptr)
+				{
+					return m_spans[index][bucket];
+				}
+			}
+			return nullptr;
+		}
+
+		//从 span 中取出 block_count 个块放进 result，取完后按新的占用率重新分组
+		void take_blocks(size_t index, central_span* record, free_list& result, size_t block_count)
+		{
+			unlink(index, record);
+			while (result.size() < block_count && !record->owner.is_full())
+			{
+				result.push(record->owner.pop_free());
+				--m_free_count[index];
+			}
+			if (!record->owner.is_full())
+			{
+				link(index, record);
+			}
+		}
 	};
-	//ԺʳԱʱͨ pimpl->
+	//以后访问成员时，通过 pimpl->
 
-	central_cache::central_cache(): pimpl(nullptr)
+	central_cache::central_cache(size_t node): pimpl(nullptr), m_node(node)
 	{
-		// ʼ m_status
-		g_is_allocator_constructing = true;
+		//机器上不存在的节点不会被用到，不创建内部数据
+		if (node >= numa_topology::node_count())
+		{
+			return;
+		}
+		// 初始化 m_status
+		allocator_reentry_guard guard;
 		pimpl = new CentralCacheImpl();
-		for (size_t i = 0; i < size_utils::CACHE_LINE_SIZE; ++i) {
+		for (size_t i = 0; i < size_utils::SIZE_CLASS_COUNT; ++i) {
 			pimpl->m_status[i].clear(std::memory_order_release);
 		}
-		g_is_allocator_constructing = false;
 	}
 
 	central_cache::~central_cache()
 	{
+#if !defined(MYSTL_TCMALLOC_IMMORTAL)
 		delete pimpl;
+#endif
 	}
 
 
 
-	std::optional<list<span<byte>>> central_cache::allocate(const size_t memory_size, const size_t block_count)
+	std::optional<free_list> central_cache::allocate(const size_t memory_size, const size_t block_count)
 	{
-		//
+		//对齐检测
 		assert(memory_size % 8 == 0);
-		//һĿռֵС512
-		assert(block_count <= page_span::MAX_UNIT_COUNT);
+		//一次性申请的块数不能超过这一级的搬运上限
+		assert(memory_size > size_utils::MAX_CACHED_UNIT_SIZE || block_count <= size_utils::get_batch_count(size_utils::get_index(memory_size)));
 
 		if (memory_size == 0 || block_count == 0)
 		{
@@ -51,7 +152,9 @@ namespace mystl
 		{
 			auto memory_opt = page_cache::allocate_unit(memory_size);
 			if (memory_opt) {
-				return list<span<byte>>{ *memory_opt };
+				free_list result;
+				result.push(memory_opt->data());
+				return result;
 			}
 			else {
 				return std::nullopt;
@@ -60,217 +163,199 @@ namespace mystl
 
 		const size_t index = size_utils::get_index(memory_size);
 
-		//
+		//自旋锁
 		auto& flag = pimpl->m_status[index];
 		while (flag.test_and_set(std::memory_order_acquire))
 		{
 			std::this_thread::yield();
 		}
 
+		free_list result;
 		try
 		{
-			if (pimpl->m_free_array[index].size() < block_count)
+			drain_remote(index);
+			//一个 span 不够时接着从下一个 span 取，都用完了才向页分配器申请
+			while (result.size() < block_count)
 			{
-				//ǰĸСĿҳ
-				size_t allocate_unit_count = page_span::MAX_UNIT_COUNT;
-				size_t allocate_page_count = size_utils::align(memory_size * allocate_unit_count, size_utils::PAGE_SIZE) / size_utils::PAGE_SIZE;
-				auto ret = get_page_from_page_cache(allocate_page_count);
-				if (!ret.has_value())
-				{
-					pimpl->m_status[index].clear(std::memory_order_release);
-					return std::nullopt;
-				}
-				span<byte> memory = ret.value();
-
-				//ڹҳ
-				page_span page_span(memory, memory_size);
-				for (size_t i = 0; i < allocate_unit_count; i++)
+				central_span* record = pimpl->fullest(index);
+				if (record == nullptr)
 				{
-					span<byte> split_memory = memory.subspan(0, memory_size);
-					memory = memory.subspan(memory_size);
-					pimpl->m_free_array[index].push_back(split_memory);
+					if (!add_span(index))
+					{
+						break;
+					}
+					record = pimpl->fullest(index);
 				}
-
-				auto start_addr = page_span.data();
-				auto [_, succeed] = pimpl->m_page_set[index].emplace(start_addr, move(page_span));
-				assert(succeed == true);
-
+				pimpl->take_blocks(index, record, result, block_count);
 			}
 		}
 		catch(...)
 		{
-			std::cout << "\n>>> DEBUG: Exception caught in central_cache::allocate! Size: " << memory_size << ", Count: " << block_count << std::endl;
+			//页面映射表或元数据的节点申请不到（bad_alloc），和页分配器申请不到一样按失败返回，
+			//异常不能再往上传：上层的 malloc 是 noexcept 的，operator new 也只认 bad_alloc
+			MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, memory_size * block_count);
+			release_blocks(result, index);
 			pimpl->m_status[index].clear(std::memory_order_release);
-			throw std::runtime_error("Memory allocation failed");
-		}
-
-		list<span<byte>> result;
-		for (size_t i = 0; i < block_count; i++) {
-			span<byte> memory = pimpl->m_free_array[index].front();
-			pimpl->m_free_array[index].pop_front();
-			record_allocate_memory_span(memory); // ¼
-			result.push_back(memory);
+			return std::nullopt;
 		}
 
 		pimpl->m_status[index].clear(std::memory_order_release);
+		//页分配器申请不到时，已经取到的块照样交出去
+		if (result.empty())
+		{
+			return std::nullopt;
+		}
 		return result;
 	}
 
-	void central_cache::deallocate(const list<span<byte>> memories)
+	void central_cache::deallocate(free_list memories, const size_t memory_size)
 	{
 		if (memories.empty())
 		{
 			return;
 		}
-		if (memories.begin()->size() > size_utils::MAX_CACHED_UNIT_SIZE)
+		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE)
 		{
-			//ڴ飬ֱӷظpage_cache
-			page_cache::get_instance().deallocate_unit(*memories.begin());
+			//超大内存块，直接返回给page_cache管理
+			while (!memories.empty())
+			{
+				page_cache::deallocate_unit(span<byte>(static_cast<byte*>(memories.pop()), memory_size));
+			}
 			return;
 		}
-		for (auto it = memories.begin(); it != memories.end(); it++)
-		{
-			assert(it->size() == memories.begin()->size());
-		}
 
-		const size_t index = size_utils::get_index(memories.begin()->size());
+		const size_t index = size_utils::get_index(memory_size);
 		auto& flag = pimpl->m_status[index];
 		while (flag.test_and_set(std::memory_order_acquire)) {
 			std::this_thread::yield();
 		}
-
-		for (const auto& memory : memories) {
-			// ȹ黹
-			assert((index + 1) * 8 == memory.size());
-			pimpl->m_free_array[index].push_back(memory);
-			// Ȼٻҳ
-			auto memory_data = memory.data();
-			auto it = pimpl->m_page_set[index].upper_bound(memory_data);
-			assert(it != pimpl->m_page_set[index].begin());
-			--it;
-			it->second.deallocate(memory);
-			// ͬʱж費Ҫظҳ
-			if (it->second.is_empty()) {
-				// Ѿڴˣڴ滹ҳ(page_cache)
-				auto page_start_addr = it->second.data();
-				auto page_end_addr = page_start_addr + it->second.size();
-				assert(it->second.unit_size() == memory.size());
-				auto mem_iter = pimpl->m_free_array[index].begin();
-				// 
-				while (mem_iter != pimpl->m_free_array[index].end()) {
-					auto memory_start_addr = mem_iter->data();
-					auto memory_end_addr = memory_start_addr + mem_iter->size();
-					if (memory_start_addr >= page_start_addr && memory_end_addr <= page_end_addr) {
-						// ڴΧڣ˵ȷ
-						// һҪģ㣬˵д
-						assert(it->second.is_valid_unit_span(*mem_iter));
-						// ָһ
-						mem_iter = pimpl->m_free_array[index].erase(mem_iter);
-					}
-					else {
-						++mem_iter;
-					}
-				}
-				span<byte> page_memory = it->second.get_memory_span();
-				pimpl->m_page_set[index].erase(it);
-				page_cache::get_instance().deallocate_page(page_memory);
-			}
-		}
+		drain_remote(index);
+		release_blocks(memories, index);
 		pimpl->m_status[index].clear(std::memory_order_release);
 	}
 
-	void central_cache::record_allocate_memory_span(span<byte> memory)
+	void central_cache::deallocate_remote(free_list memories, const size_t memory_size)
 	{
-		const size_t index = size_utils::get_index(memory.size());
-		auto it = pimpl->m_page_set[index].upper_bound(memory.data());
-		assert(it != pimpl->m_page_set[index].begin());
-		--it;
-		it->second.allocate(memory);
+		if (memories.empty())
+		{
+			return;
+		}
+		assert(memory_size <= size_utils::MAX_CACHED_UNIT_SIZE);
+		const size_t index = size_utils::get_index(memory_size);
+		//整条链表一次挂到队列头上，最后一块接上原来的队列
+		void* head = memories.front();
+		void* tail = memories.back();
+		pimpl->m_remote_count[index].fetch_add(memories.size(), std::memory_order_relaxed);
+		void* old_head = pimpl->m_remote_head[index].load(std::memory_order_relaxed);
+		do
+		{
+			free_list::next_of(tail) = old_head;
+		} while (!pimpl->m_remote_head[index].compare_exchange_weak(old_head, head, std::memory_order_release, std::memory_order_relaxed));
 	}
 
-
-	std::optional<span<byte>> central_cache::get_page_from_page_cache(size_t page_allocate_count)
+	void central_cache::drain_remote(size_t index)
 	{
-		return page_cache::get_instance().allocate_page(page_allocate_count);
+		if (pimpl->m_remote_head[index].load(std::memory_order_relaxed) == nullptr)
+		{
+			return;
+		}
+		void* block = pimpl->m_remote_head[index].exchange(nullptr, std::memory_order_acquire);
+		free_list memories;
+		while (block != nullptr)
+		{
+			void* next = free_list::next_of(block);
+			memories.push(block);
+			block = next;
+		}
+		pimpl->m_remote_count[index].fetch_sub(memories.size(), std::memory_order_relaxed);
+		release_blocks(memories, index);
 	}
 
-	std::optional<span<byte>> central_cache::allocate_single(size_t memory_size)
+	void central_cache::release_blocks(free_list& memories, size_t index)
 	{
-		// 
-		assert(memory_size % 8 == 0);
-		if (memory_size == 0)
-		{
-			return std::nullopt;
+		page_map& map = page_map::get_instance();
+		while (!memories.empty()) {
+			// 先从侵入式链表上摘下来，然后挂到所属 span 自己的空闲链表上
+			void* block = memories.pop();
+			page_span* owner = map.get(block);
+			assert(owner != nullptr && owner->node() == m_node && owner->unit_size() == size_utils::get_class_size(index));
+			central_span* record = reinterpret_cast<central_span*>(owner);
+			const bool was_full = owner->is_full();
+			if (!was_full) {
+				pimpl->unlink(index, record);
+			}
+			owner->push_free(block);
+			++pimpl->m_free_count[index];
+			if (owner->is_empty()) {
+				// 已经还清内存了，块都在这个 span 自己的链表上，整个 span 直接还给页面管理器(page_cache)
+				span<byte> page_memory = owner->get_memory_span();
+				pimpl->m_free_count[index] -= owner->unit_count();
+				--pimpl->m_span_count[index];
+				map.clear(page_memory);
+				pimpl->m_span_arena[index].destroy(record);
+				page_cache::get_instance(m_node).deallocate_page(page_memory);
+			}
+			else {
+				pimpl->link(index, record);
+			}
 		}
+	}
 
-		// ڳڴ棬ֱ page_cache (Ȼڵǰ̫)
-		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE)
+	bool central_cache::add_span(size_t index)
+	{
+		//每一级的页数由尺寸分级表决定，切完剩下的尾巴不再使用
+		const size_t unit_size = size_utils::get_class_size(index);
+		auto ret = get_page_from_page_cache(size_utils::get_span_pages(index));
+		if (!ret.has_value())
 		{
-			return page_cache::get_instance().allocate_unit(memory_size);
+			return false;
 		}
-
-		const size_t index = size_utils::get_index(memory_size);
-		std::optional<span<byte>> result = std::nullopt;
-
-		// ---  ---
-		auto& flag = pimpl->m_status[index];
-		while (flag.test_and_set(std::memory_order_acquire))
+		central_span* record = pimpl->m_span_arena[index].create(ret.value(), unit_size, m_node);
+		if (record == nullptr)
 		{
-			std::this_thread::yield();
+			page_cache::get_instance(m_node).deallocate_page(ret.value());
+			return false;
 		}
+		//登记到基数树中，之后按地址找所属的 page_span 只需要查表
+		page_map::get_instance().set(record->owner.get_memory_span(), &record->owner);
+		pimpl->m_free_count[index] += record->owner.unit_count();
+		++pimpl->m_span_count[index];
+		pimpl->link(index, record);
+		return true;
+	}
 
-		try
+	std::optional<span<byte>> central_cache::get_page_from_page_cache(size_t page_allocate_count)
+	{
+		return page_cache::get_instance(m_node).allocate_page(page_allocate_count);
+	}
+
+	void central_cache::collect_stats(allocator_stats& stats)
+	{
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
 		{
-			// 1. ȴȡ
-			if (!pimpl->m_free_array[index].empty())
+			auto& flag = pimpl->m_status[index];
+			while (flag.test_and_set(std::memory_order_acquire))
 			{
-				result = pimpl->m_free_array[index].front();
-				pimpl->m_free_array[index].pop_front();
-				record_allocate_memory_span(*result);
+				std::this_thread::yield();
 			}
-			// 2. Ϊգ PageCache ȡҳ
-			else
-			{
-				size_t allocate_unit_count = page_span::MAX_UNIT_COUNT;
-				size_t allocate_page_count = size_utils::align(memory_size * allocate_unit_count, size_utils::PAGE_SIZE) / size_utils::PAGE_SIZE;
-				auto ret = get_page_from_page_cache(allocate_page_count);
-				if (ret.has_value())
-				{
-					span<byte> memory = ret.value();
-
-					//  page_span ҳ
-					page_span page_span(memory, memory_size);
-
-					// ָڴҳһأķ
-					// صһ
-					result = memory.subspan(0, memory_size);
-					page_span.allocate(*result);
-					memory = memory.subspan(memory_size);
-
-					//  page_span ¼
-					auto start_addr = page_span.data();
-					pimpl->m_page_set[index].emplace(start_addr, move(page_span));
-
-					// ʣĿ
-					allocate_unit_count -= 1;
-					for (size_t i = 0; i < allocate_unit_count; i++)
-					{
-						span<byte> split_memory = memory.subspan(0, memory_size);
-						memory = memory.subspan(memory_size);
-						pimpl->m_free_array[index].push_back(split_memory);
-					}
-				}
-			}
-		}
-		catch (...)
-		{
-			std::cout << "\n>>> DEBUG: Exception caught in central_cache::allocate_single! Size: " << memory_size << std::endl;
-			pimpl->m_status[index].clear(std::memory_order_release);
-			throw std::runtime_error("Single memory allocation failed");
+			const size_t span_count = pimpl->m_span_count[index];
+			const size_t free_blocks = pimpl->m_free_count[index];
+			flag.clear(std::memory_order_release);
+			const size_t remote_blocks = pimpl->m_remote_count[index].load(std::memory_order_relaxed);
+
+			const size_t unit_size = size_utils::get_class_size(index);
+			const size_t span_bytes = size_utils::get_span_pages(index) * size_utils::PAGE_SIZE;
+			const size_t units_per_span = span_bytes / unit_size;
+			size_class_stats& class_stats = stats.classes[index];
+			class_stats.unit_size = unit_size;
+			class_stats.span_count += span_count;
+			class_stats.central_free_blocks += free_blocks;
+			class_stats.central_allocated_blocks += span_count * units_per_span - free_blocks;
+			class_stats.remote_free_blocks += remote_blocks;
+			stats.remote_free_bytes += remote_blocks * unit_size;
+			stats.central_span_bytes += span_count * span_bytes;
+			stats.central_free_bytes += free_blocks * unit_size;
+			stats.fragmented_bytes += span_count * (span_bytes - units_per_span * unit_size);
 		}
-
-		// ---  ---
-		pimpl->m_status[index].clear(std::memory_order_release);
-		return result;
 	}
-}
\ No newline at end of file
+}
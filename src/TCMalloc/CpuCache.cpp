@@ -0,0 +1,375 @@
+#include "../../include/TCMalloc/CpuCache.h"
+#include "../../include/TCMalloc/ThreadCache.h"
+#include "../../include/TCMalloc/TransferCache.h"
+#include "../../include/TCMalloc/PageCache.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/TCMallocBootstrap.h"
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include "../../include/TCMalloc/HeapProfiler.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+//glibc 2.35 开始会为每个线程注册 rseq，内核在线程被调度时更新其中的 cpu_id
+#if defined(__linux__) && defined(__GLIBC__) && defined(__GNUC__) && __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#include <unistd.h>
+#define MYSTL_TCMALLOC_HAS_RSEQ 1
+#endif
+
+namespace mystl
+{
+	class CpuCacheImpl
+	{
+	public:
+		//每个CPU单独占一条缓存行
+		struct alignas(64) cpu_slot
+		{
+			std::atomic_flag status = ATOMIC_FLAG_INIT;
+			free_list free_cache[size_utils::SIZE_CLASS_COUNT];
+			//每一级累计交给用户和从用户收回的块数，和链表一起在锁内修改
+			size_t alloc_count[size_utils::SIZE_CLASS_COUNT] = {};
+			size_t free_count[size_utils::SIZE_CLASS_COUNT] = {};
+		};
+		cpu_slot* m_slots = nullptr;
+		size_t m_cpu_count = 0;
+	};
+
+	namespace
+	{
+		//线程在临界区里被抢占后，同一个CPU上的其它线程会在这里等待
+		//临界区只有几次链表操作，冲突很少
+		class cpu_slot_lock
+		{
+		public:
+			explicit cpu_slot_lock(std::atomic_flag& flag) :m_flag(flag)
+			{
+				while (m_flag.test_and_set(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+			}
+			~cpu_slot_lock()
+			{
+				m_flag.clear(std::memory_order_release);
+			}
+			cpu_slot_lock(const cpu_slot_lock&) = delete;
+			cpu_slot_lock& operator=(const cpu_slot_lock&) = delete;
+		private:
+			std::atomic_flag& m_flag;
+		};
+
+		//采样间隔和 thread_cache 一样按线程计算，线程换了CPU也不影响
+		//只有两个整数，不需要构造和析构，线程退出时不会回到分配器
+		struct sample_state
+		{
+			//距离下一次采样还要分配的字节数，初始为0，第一次分配时按采样率生成
+			size_t bytes_until_sample;
+			uint64_t rng;
+		};
+		thread_local sample_state t_sample_state = { 0, 0 };
+	}
+
+	cpu_cache::cpu_cache() :pimpl(nullptr)
+	{
+		allocator_reentry_guard guard;
+		pimpl = new CpuCacheImpl();
+#if defined(MYSTL_TCMALLOC_HAS_RSEQ)
+		long cpu_count = sysconf(_SC_NPROCESSORS_CONF);
+		pimpl->m_cpu_count = cpu_count > 0 ? static_cast<size_t>(cpu_count) : 0;
+#endif
+		if (pimpl->m_cpu_count != 0)
+		{
+			pimpl->m_slots = new CpuCacheImpl::cpu_slot[pimpl->m_cpu_count];
+		}
+	}
+
+	cpu_cache::~cpu_cache()
+	{
+#if !defined(MYSTL_TCMALLOC_IMMORTAL)
+		delete[] pimpl->m_slots;
+		delete pimpl;
+#endif
+	}
+
+	int cpu_cache::current_cpu()
+	{
+#if defined(MYSTL_TCMALLOC_HAS_RSEQ)
+		if (__rseq_size == 0)
+		{
+			//rseq 被关掉了（例如 GLIBC_TUNABLES=glibc.pthread.rseq=0）
+			return -1;
+		}
+		const volatile struct rseq* area = reinterpret_cast<const volatile struct rseq*>(
+			static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+		//没有注册成功时 cpu_id 是负数
+		return static_cast<int>(area->cpu_id);
+#else
+		return -1;
+#endif
+	}
+
+	bool cpu_cache::is_available()
+	{
+		return current_cpu() >= 0;
+	}
+
+	std::optional<void*> cpu_cache::allocate(size_t memory_size)
+	{
+		//太大的申请在对齐之前就拒绝，否则对齐时会回绕成一个很小的块
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+
+		//拿不到CPU编号时交给 thread_cache，由它自己采样
+		const int cpu = current_cpu();
+		if (cpu < 0 || static_cast<size_t>(cpu) >= pimpl->m_cpu_count)
+		{
+			return thread_cache::get_instance().allocate(memory_size);
+		}
+
+		//没到采样点时只有一次比较和一次减法
+		sample_state& state = t_sample_state;
+		if (state.bytes_until_sample < memory_size)
+		{
+			return allocate_sampled(memory_size, cpu);
+		}
+		state.bytes_until_sample -= memory_size;
+		return allocate_unsampled(memory_size, cpu);
+	}
+
+	std::optional<void*> cpu_cache::allocate_sampled(size_t memory_size, int cpu)
+	{
+		const bool sampling = heap_profiler::get_sample_rate() != 0;
+		t_sample_state.bytes_until_sample = heap_profiler::next_sample_interval(t_sample_state.rng);
+		auto result = allocate_unsampled(memory_size, cpu);
+		if (result && sampling)
+		{
+			const size_t aligned_size = size_utils::align(memory_size);
+			const size_t allocated_size = aligned_size > size_utils::MAX_CACHED_UNIT_SIZE
+				? size_utils::align(aligned_size, size_utils::PAGE_SIZE)
+				: size_utils::round_up(aligned_size);
+			heap_profiler::get_instance().record_allocation(*result, memory_size, allocated_size);
+		}
+		return result;
+	}
+
+	std::optional<void*> cpu_cache::allocate_unsampled(size_t memory_size, int cpu)
+	{
+		memory_size = size_utils::align(memory_size);
+		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			auto result = page_cache::allocate_unit(memory_size);
+			if (result)
+			{
+				return std::optional<void*>(result->data());
+			}
+			return std::nullopt;
+		}
+
+		const size_t index = size_utils::get_index(memory_size);
+		memory_size = size_utils::get_class_size(index);
+		auto& slot = pimpl->m_slots[cpu];
+		{
+			cpu_slot_lock lock(slot.status);
+			if (!slot.free_cache[index].empty())
+			{
+				++slot.alloc_count[index];
+				return slot.free_cache[index].pop();
+			}
+		}
+
+		//向下申请时不持有锁，期间线程可能已经换了CPU，多出来的块放进原来那个CPU的缓存也没有关系
+		auto allocation_result = transfer_cache::get_instance(numa_topology::node_of_cpu(cpu)).allocate(memory_size, size_utils::get_batch_count(index));
+		if (!allocation_result)
+		{
+			return std::nullopt;
+		}
+		free_list memory_list = std::move(allocation_result.value());
+		void* result = memory_list.pop();
+		{
+			cpu_slot_lock lock(slot.status);
+			++slot.alloc_count[index];
+			slot.free_cache[index].splice(memory_list);
+		}
+		return result;
+	}
+
+	std::optional<void*> cpu_cache::allocate_aligned(size_t memory_size, size_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+		if (alignment <= size_utils::ALIGNMENT)
+		{
+			return allocate(memory_size);
+		}
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		if (alignment <= size_utils::PAGE_SIZE && memory_size <= size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			const size_t index = size_utils::get_aligned_index(memory_size, alignment);
+			if (index < size_utils::SIZE_CLASS_COUNT)
+			{
+				return allocate(size_utils::get_class_size(index));
+			}
+		}
+		auto result = page_cache::allocate_unit_aligned(memory_size, alignment);
+		if (result)
+		{
+			sample_large_allocation(result->data(), memory_size, result->size());
+			return std::optional<void*>(result->data());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<void*> cpu_cache::allocate_zeroed(size_t memory_size)
+	{
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		//拿不到CPU编号时交给 thread_cache，由它自己采样
+		const int cpu = current_cpu();
+		if (cpu < 0 || static_cast<size_t>(cpu) >= pimpl->m_cpu_count)
+		{
+			return thread_cache::get_instance().allocate_zeroed(memory_size);
+		}
+		//小块都被用过，要清零
+		if (memory_size <= size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			auto result = allocate(memory_size);
+			if (result)
+			{
+				std::memset(*result, 0, memory_size);
+			}
+			return result;
+		}
+		bool zeroed = false;
+		auto memory = page_cache::allocate_unit(memory_size, &zeroed);
+		if (!memory)
+		{
+			return std::nullopt;
+		}
+		if (!zeroed)
+		{
+			std::memset(memory->data(), 0, memory_size);
+		}
+		sample_large_allocation(memory->data(), memory_size, memory->size());
+		return std::optional<void*>(memory->data());
+	}
+
+	void cpu_cache::sample_large_allocation(void* address, size_t requested_size, size_t allocated_size)
+	{
+		sample_state& state = t_sample_state;
+		if (state.bytes_until_sample >= requested_size)
+		{
+			state.bytes_until_sample -= requested_size;
+			return;
+		}
+		const bool sampling = heap_profiler::get_sample_rate() != 0;
+		state.bytes_until_sample = heap_profiler::next_sample_interval(state.rng);
+		if (sampling)
+		{
+			heap_profiler::get_instance().record_allocation(address, requested_size, allocated_size);
+		}
+	}
+
+	void cpu_cache::deallocate(void* start_p, size_t memory_size)
+	{
+		if (memory_size == 0)
+		{
+			return;
+		}
+		//拿不到CPU编号时交给 thread_cache，采样记录也由它删除
+		const int cpu = current_cpu();
+		if (cpu < 0 || static_cast<size_t>(cpu) >= pimpl->m_cpu_count)
+		{
+			thread_cache::get_instance().deallocate(start_p, memory_size);
+			return;
+		}
+		//没有存活的采样记录时只有一次读取和一次比较
+		if (heap_profiler::has_samples())
+		{
+			heap_profiler::get_instance().record_deallocation(start_p);
+		}
+		memory_size = size_utils::align(memory_size);
+		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			page_cache::deallocate_unit(span<byte>(static_cast<byte*>(start_p), memory_size));
+			return;
+		}
+
+		const size_t index = size_utils::get_index(memory_size);
+		memory_size = size_utils::get_class_size(index);
+		auto& slot = pimpl->m_slots[cpu];
+		free_list memory_to_deallocate;
+		{
+			cpu_slot_lock lock(slot.status);
+			slot.free_cache[index].push(start_p);
+			++slot.free_count[index];
+			//超过上限时回收一半
+			if (slot.free_cache[index].size() * memory_size > MAX_FREE_BYTES_PER_LISTS)
+			{
+				memory_to_deallocate = slot.free_cache[index].pop_range(slot.free_cache[index].size() / 2);
+			}
+		}
+		if (!memory_to_deallocate.empty())
+		{
+			transfer_cache::get_instance(numa_topology::node_of_cpu(cpu)).deallocate(std::move(memory_to_deallocate), memory_size);
+		}
+	}
+
+	void cpu_cache::deallocate(void* start_p)
+	{
+		if (start_p == nullptr)
+		{
+			return;
+		}
+		page_span* owner = page_map::get_instance().get(start_p);
+		assert(owner != nullptr);
+		deallocate(start_p, owner->unit_size());
+	}
+
+	size_t cpu_cache::drain()
+	{
+		size_t drained = 0;
+		for (size_t cpu = 0; cpu < pimpl->m_cpu_count; ++cpu)
+		{
+			auto& slot = pimpl->m_slots[cpu];
+			transfer_cache& transfer = transfer_cache::get_instance(numa_topology::node_of_cpu(static_cast<int>(cpu)));
+			for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
+			{
+				free_list memories;
+				{
+					cpu_slot_lock lock(slot.status);
+					memories = std::move(slot.free_cache[index]);
+				}
+				//向下归还时不持有锁，和 deallocate 一样
+				if (!memories.empty())
+				{
+					const size_t memory_size = size_utils::get_class_size(index);
+					drained += memories.size() * memory_size;
+					transfer.deallocate(std::move(memories), memory_size);
+				}
+			}
+		}
+		return drained;
+	}
+
+	void cpu_cache::collect_stats(allocator_stats& stats)
+	{
+		for (size_t cpu = 0; cpu < pimpl->m_cpu_count; ++cpu)
+		{
+			auto& slot = pimpl->m_slots[cpu];
+			cpu_slot_lock lock(slot.status);
+			for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
+			{
+				stats.cpu_cached_bytes += slot.free_cache[index].size() * size_utils::get_class_size(index);
+				stats.classes[index].alloc_count += slot.alloc_count[index];
+				stats.classes[index].free_count += slot.free_count[index];
+			}
+		}
+	}
+}
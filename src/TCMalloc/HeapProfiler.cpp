@@ -0,0 +1,341 @@
+#define NOMINMAX//windows.h会自动引入max和min，和mystl的冲突
+#if defined(_WIN32)
+#include<windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "../../include/TCMalloc/HeapProfiler.h"
+#include "../../include/TCMalloc/TCMallocBootstrap.h"
+
+namespace mystl
+{
+	class HeapProfilerImpl
+	{
+	public:
+		//被删除的位置，查找时要跳过，插入时可以复用
+		static void* tombstone()
+		{
+			return reinterpret_cast<void*>(static_cast<uintptr_t>(1));
+		}
+
+		//开放寻址的哈希表，键可以无锁读取，修改都在锁内
+		struct sample_table
+		{
+			std::atomic<void*> keys[heap_profiler::MAX_SAMPLES];
+			heap_profiler::sample records[heap_profiler::MAX_SAMPLES];
+			//已经使用的位置数（包括被删除的）
+			size_t used;
+		};
+
+		//两张表轮流使用，被删除的位置太多时把存活的记录搬到另一张表
+		sample_table* m_tables = nullptr;
+		std::atomic<sample_table*> m_active{ nullptr };
+		//搬表期间是奇数，无锁查找前后不一致时改为加锁查找
+		std::atomic<uint64_t> m_generation{ 0 };
+		std::atomic_flag m_status = ATOMIC_FLAG_INIT;
+		//dump 共用一块复制记录的缓冲区，同一时刻只能有一个 dump，输出期间可能很久，不占用上面的自旋锁
+		std::mutex m_dump_mutex;
+		//表满了被丢弃的采样数
+		size_t m_dropped = 0;
+		//所有采样过的分配（包括已经释放的）
+		size_t m_total_count = 0;
+		size_t m_total_bytes = 0;
+	};
+
+	namespace
+	{
+		class profiler_lock
+		{
+		public:
+			explicit profiler_lock(std::atomic_flag& flag) :m_flag(flag)
+			{
+				while (m_flag.test_and_set(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+			}
+			~profiler_lock()
+			{
+				m_flag.clear(std::memory_order_release);
+			}
+			profiler_lock(const profiler_lock&) = delete;
+			profiler_lock& operator=(const profiler_lock&) = delete;
+		private:
+			std::atomic_flag& m_flag;
+		};
+
+		//采样表直接向系统申请，不经过分配器
+		void* system_allocate_table(size_t size)
+		{
+#if defined(_WIN32)
+			return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+			void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+		}
+
+		size_t hash_address(const void* address)
+		{
+			constexpr size_t bits = detail::bit_width(heap_profiler::MAX_SAMPLES) - 1;
+			return static_cast<size_t>(((reinterpret_cast<uint64_t>(address) >> 3) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+		}
+
+		//返回 key 所在的位置，找不到返回 MAX_SAMPLES
+		size_t find_slot(HeapProfilerImpl::sample_table* table, const void* address)
+		{
+			size_t index = hash_address(address);
+			for (size_t i = 0; i < heap_profiler::MAX_SAMPLES; ++i)
+			{
+				void* key = table->keys[index].load(std::memory_order_acquire);
+				if (key == address)
+					return index;
+				if (key == nullptr)
+					break;
+				index = (index + 1) & (heap_profiler::MAX_SAMPLES - 1);
+			}
+			return heap_profiler::MAX_SAMPLES;
+		}
+
+		//插入记录，表中不能已经有这个地址，调用时必须持锁
+		bool insert_record(HeapProfilerImpl::sample_table* table, const heap_profiler::sample& record)
+		{
+			size_t index = hash_address(record.address);
+			for (size_t i = 0; i < heap_profiler::MAX_SAMPLES; ++i)
+			{
+				void* key = table->keys[index].load(std::memory_order_relaxed);
+				if (key == nullptr || key == HeapProfilerImpl::tombstone())
+				{
+					if (key == nullptr)
+						++table->used;
+					table->records[index] = record;
+					table->keys[index].store(record.address, std::memory_order_release);
+					return true;
+				}
+				index = (index + 1) & (heap_profiler::MAX_SAMPLES - 1);
+			}
+			return false;
+		}
+
+		uint64_t now_nanoseconds()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+	}
+
+	heap_profiler::heap_profiler() :pimpl(nullptr)
+	{
+		allocator_reentry_guard guard;
+		pimpl = new HeapProfilerImpl();
+	}
+
+	heap_profiler::~heap_profiler()
+	{
+#if !defined(MYSTL_TCMALLOC_IMMORTAL)
+		delete pimpl;
+#endif
+	}
+
+	void heap_profiler::set_sample_rate(size_t sample_rate)
+	{
+		s_sample_rate.store(sample_rate, std::memory_order_relaxed);
+	}
+
+	size_t heap_profiler::get_sample_rate()
+	{
+		return s_sample_rate.load(std::memory_order_relaxed);
+	}
+
+	size_t heap_profiler::next_sample_interval(uint64_t& rng_state)
+	{
+		const size_t sample_rate = get_sample_rate();
+		if (sample_rate == 0)
+		{
+			return RECHECK_INTERVAL;
+		}
+		//xorshift64*，状态为 0 时先打散
+		if (rng_state == 0)
+			rng_state = reinterpret_cast<uint64_t>(&rng_state) | 1;
+		rng_state ^= rng_state >> 12;
+		rng_state ^= rng_state << 25;
+		rng_state ^= rng_state >> 27;
+		const uint64_t random = (rng_state * 0x2545F4914F6CDD1Dull) >> 11;
+		//(0, 1] 上的均匀分布，指数分布的间隔使采样点构成泊松过程
+		const double uniform = (static_cast<double>(random) + 1.0) / 9007199254740992.0;
+		const double interval = -std::log(uniform) * static_cast<double>(sample_rate);
+		if (interval < 1.0)
+			return 1;
+		if (interval > static_cast<double>(sample_rate) * 64.0)
+			return sample_rate * 64;
+		return static_cast<size_t>(interval);
+	}
+
+	void heap_profiler::record_allocation(void* address, size_t requested_size, size_t allocated_size)
+	{
+		allocator_reentry_guard guard;
+		sample record;
+		record.address = address;
+		record.requested_size = requested_size;
+		record.allocated_size = allocated_size;
+		record.timestamp = now_nanoseconds();
+#if defined(__GLIBC__)
+		//第一次调用 backtrace 可能会加载 libgcc 而申请内存，重入保护会让这次申请交给系统分配器
+		const int depth = backtrace(record.stack, static_cast<int>(MAX_STACK_DEPTH));
+		record.depth = depth > 0 ? static_cast<size_t>(depth) : 0;
+#elif defined(_WIN32)
+		record.depth = RtlCaptureStackBackTrace(0, static_cast<DWORD>(MAX_STACK_DEPTH), record.stack, nullptr);
+#else
+		record.depth = 0;
+#endif
+
+		profiler_lock lock(pimpl->m_status);
+		if (pimpl->m_tables == nullptr)
+		{
+			pimpl->m_tables = static_cast<HeapProfilerImpl::sample_table*>(system_allocate_table(sizeof(HeapProfilerImpl::sample_table) * 2));
+			if (pimpl->m_tables == nullptr)
+			{
+				++pimpl->m_dropped;
+				return;
+			}
+			//匿名映射是清零的，正好是空表
+			pimpl->m_active.store(pimpl->m_tables, std::memory_order_release);
+		}
+		pimpl->m_total_count += 1;
+		pimpl->m_total_bytes += allocated_size;
+
+		HeapProfilerImpl::sample_table* table = pimpl->m_active.load(std::memory_order_relaxed);
+		//同一个地址不会同时存活两次，残留的旧记录直接覆盖
+		const size_t old_slot = find_slot(table, address);
+		if (old_slot != MAX_SAMPLES)
+		{
+			table->records[old_slot] = record;
+			return;
+		}
+		//被删除的位置太多，查找会越来越慢，把存活的记录搬到另一张表
+		if (table->used >= MAX_SAMPLES / 4 * 3)
+		{
+			HeapProfilerImpl::sample_table* other = table == pimpl->m_tables ? pimpl->m_tables + 1 : pimpl->m_tables;
+			pimpl->m_generation.fetch_add(1, std::memory_order_acq_rel);
+			for (size_t i = 0; i < MAX_SAMPLES; ++i)
+			{
+				other->keys[i].store(nullptr, std::memory_order_relaxed);
+			}
+			other->used = 0;
+			for (size_t i = 0; i < MAX_SAMPLES; ++i)
+			{
+				void* key = table->keys[i].load(std::memory_order_relaxed);
+				if (key != nullptr && key != HeapProfilerImpl::tombstone())
+				{
+					insert_record(other, table->records[i]);
+				}
+			}
+			pimpl->m_active.store(other, std::memory_order_release);
+			pimpl->m_generation.fetch_add(1, std::memory_order_acq_rel);
+			table = other;
+		}
+		//存活的记录占了一半以上，再插入只会让表退化，丢弃这次采样
+		if (s_live_samples.load(std::memory_order_relaxed) >= MAX_SAMPLES / 2 || !insert_record(table, record))
+		{
+			++pimpl->m_dropped;
+			return;
+		}
+		s_live_samples.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void heap_profiler::record_deallocation(void* address)
+	{
+		//先无锁地查一遍，绝大多数被释放的地址都不是采样过的
+		const uint64_t generation = pimpl->m_generation.load(std::memory_order_acquire);
+		if ((generation & 1) == 0)
+		{
+			HeapProfilerImpl::sample_table* table = pimpl->m_active.load(std::memory_order_acquire);
+			if (table == nullptr)
+				return;
+			const bool found = find_slot(table, address) != MAX_SAMPLES;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (!found && pimpl->m_generation.load(std::memory_order_relaxed) == generation)
+				return;
+		}
+		//找到了，或者查找期间表被搬动过，加锁再确认一次
+		profiler_lock lock(pimpl->m_status);
+		HeapProfilerImpl::sample_table* table = pimpl->m_active.load(std::memory_order_relaxed);
+		const size_t slot = find_slot(table, address);
+		if (slot == MAX_SAMPLES)
+			return;
+		table->keys[slot].store(HeapProfilerImpl::tombstone(), std::memory_order_release);
+		s_live_samples.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	size_t heap_profiler::snapshot(sample* samples, size_t max_count)
+	{
+		profiler_lock lock(pimpl->m_status);
+		HeapProfilerImpl::sample_table* table = pimpl->m_active.load(std::memory_order_relaxed);
+		if (table == nullptr)
+			return 0;
+		size_t count = 0;
+		for (size_t i = 0; i < MAX_SAMPLES && count < max_count; ++i)
+		{
+			void* key = table->keys[i].load(std::memory_order_relaxed);
+			if (key != nullptr && key != HeapProfilerImpl::tombstone())
+			{
+				samples[count++] = table->records[i];
+			}
+		}
+		return count;
+	}
+
+	void heap_profiler::dump(std::ostream& os)
+	{
+		std::lock_guard<std::mutex> dump_lock(pimpl->m_dump_mutex);
+		//记录比较大，放在单独映射的内存里，不占栈也不通过分配器申请
+		static sample* samples = static_cast<sample*>(system_allocate_table(sizeof(sample) * MAX_SAMPLES));
+		if (samples == nullptr)
+			return;
+		const size_t count = snapshot(samples, MAX_SAMPLES);
+		size_t total_count = 0;
+		size_t total_bytes = 0;
+		{
+			profiler_lock lock(pimpl->m_status);
+			total_count = pimpl->m_total_count;
+			total_bytes = pimpl->m_total_bytes;
+		}
+		size_t inuse_bytes = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			inuse_bytes += samples[i].allocated_size;
+		}
+
+		//pprof 的 heap_v2 格式：每一行是 "存活个数: 存活字节 [累计个数: 累计字节] @ 调用栈"
+		//字节数是采样到的原始值，pprof 按照头部给出的采样率自己换算
+		os << "heap profile: " << count << ": " << inuse_bytes << " [" << total_count << ": " << total_bytes
+			<< "] @ heap_v2/" << get_sample_rate() << '\n';
+		for (size_t i = 0; i < count; ++i)
+		{
+			const sample& s = samples[i];
+			os << "1: " << s.allocated_size << " [1: " << s.allocated_size << "] @";
+			for (size_t j = 0; j < s.depth; ++j)
+			{
+				os << ' ' << s.stack[j];
+			}
+			os << '\n';
+		}
+		//pprof 需要通过内存映射把地址还原成符号
+		os << "\nMAPPED_LIBRARIES:\n";
+#if defined(__linux__)
+		std::ifstream maps("/proc/self/maps");
+		os << maps.rdbuf();
+#endif
+	}
+}
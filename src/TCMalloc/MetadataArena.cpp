@@ -0,0 +1,24 @@
+#define NOMINMAX//windows.h会自动引入max和min，和mystl的冲突
+#if defined(_WIN32)
+#include<windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "../../include/TCMalloc/MetadataArena.h"
+
+namespace mystl
+{
+	namespace detail
+	{
+		void* metadata_allocate_chunk(size_t size)
+		{
+#if defined(_WIN32)
+			return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+			void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+		}
+	}
+}
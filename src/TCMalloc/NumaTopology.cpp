@@ -0,0 +1,232 @@
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../../include/TCMalloc/NumaTopology.h"
+#include <cstdint>
+#include <cstdlib>
+
+namespace mystl
+{
+	namespace
+	{
+		struct topology_state
+		{
+			size_t node_count = 1;
+			//逻辑节点编号对应的系统节点编号，mbind 时使用
+			int system_nodes[numa_topology::MAX_NODES] = {};
+			uint8_t cpu_nodes[numa_topology::MAX_CPUS] = {};
+			//模拟的节点只按 CPU 编号取模，不绑定内存
+			bool simulated = false;
+		};
+
+#if defined(__linux__)
+		//读取整个小文件，不经过 stdio，避免在分配器初始化时申请内存
+		size_t read_small_file(const char* path, char* buffer, size_t capacity)
+		{
+			const int fd = open(path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+			{
+				return 0;
+			}
+			size_t length = 0;
+			while (length + 1 < capacity)
+			{
+				const ssize_t count = read(fd, buffer + length, capacity - 1 - length);
+				if (count <= 0)
+				{
+					break;
+				}
+				length += static_cast<size_t>(count);
+			}
+			close(fd);
+			buffer[length] = '\0';
+			return length;
+		}
+
+		//解析 "0-3,8,10-11" 这样的列表，对每个编号调用 visit
+		template<typename Visitor>
+		void parse_list(const char* text, Visitor visit)
+		{
+			const char* p = text;
+			while (*p >= '0' && *p <= '9')
+			{
+				size_t first = 0;
+				while (*p >= '0' && *p <= '9')
+				{
+					first = first * 10 + static_cast<size_t>(*p++ - '0');
+				}
+				size_t last = first;
+				if (*p == '-')
+				{
+					++p;
+					last = 0;
+					while (*p >= '0' && *p <= '9')
+					{
+						last = last * 10 + static_cast<size_t>(*p++ - '0');
+					}
+				}
+				for (size_t i = first; i <= last; ++i)
+				{
+					visit(i);
+				}
+				if (*p != ',')
+				{
+					break;
+				}
+				++p;
+			}
+		}
+
+		void load_system_topology(topology_state& state)
+		{
+			char buffer[4096];
+			if (read_small_file("/sys/devices/system/node/online", buffer, sizeof(buffer)) == 0)
+			{
+				return;
+			}
+			//节点编号不一定连续，逻辑编号按出现的顺序分配
+			size_t online[64];
+			size_t count = 0;
+			parse_list(buffer, [&](size_t node) {
+				if (count < 64)
+				{
+					online[count++] = node;
+				}
+			});
+			if (count <= 1)
+			{
+				return;
+			}
+			state.node_count = count < numa_topology::MAX_NODES ? count : numa_topology::MAX_NODES;
+			for (size_t logical = 0; logical < state.node_count; ++logical)
+			{
+				state.system_nodes[logical] = static_cast<int>(online[logical]);
+			}
+
+			for (size_t logical = 0; logical < count; ++logical)
+			{
+				//拼出 /sys/devices/system/node/nodeN/cpulist
+				char path[64] = "/sys/devices/system/node/node";
+				size_t length = sizeof("/sys/devices/system/node/node") - 1;
+				char digits[20];
+				size_t digit_count = 0;
+				size_t system_node = online[logical];
+				do
+				{
+					digits[digit_count++] = static_cast<char>('0' + system_node % 10);
+					system_node /= 10;
+				} while (system_node != 0);
+				while (digit_count != 0)
+				{
+					path[length++] = digits[--digit_count];
+				}
+				for (const char* suffix = "/cpulist"; *suffix != '\0'; ++suffix)
+				{
+					path[length++] = *suffix;
+				}
+				path[length] = '\0';
+
+				char cpus[4096];
+				if (read_small_file(path, cpus, sizeof(cpus)) == 0)
+				{
+					continue;
+				}
+				const uint8_t node = static_cast<uint8_t>(logical % numa_topology::MAX_NODES);
+				parse_list(cpus, [&](size_t cpu) {
+					if (cpu < numa_topology::MAX_CPUS)
+					{
+						state.cpu_nodes[cpu] = node;
+					}
+				});
+			}
+		}
+#endif
+
+		topology_state make_topology()
+		{
+			topology_state state;
+			const char* forced = std::getenv("MYSTL_TCMALLOC_NUMA_NODES");
+			if (forced != nullptr && *forced != '\0')
+			{
+				const long count = std::strtol(forced, nullptr, 10);
+				if (count > 1)
+				{
+					state.node_count = static_cast<size_t>(count) < numa_topology::MAX_NODES ? static_cast<size_t>(count) : numa_topology::MAX_NODES;
+					state.simulated = true;
+					for (size_t cpu = 0; cpu < numa_topology::MAX_CPUS; ++cpu)
+					{
+						state.cpu_nodes[cpu] = static_cast<uint8_t>(cpu % state.node_count);
+					}
+				}
+				return state;
+			}
+#if defined(__linux__)
+			load_system_topology(state);
+#endif
+			return state;
+		}
+
+		const topology_state& get_topology()
+		{
+			static const topology_state state = make_topology();
+			return state;
+		}
+	}
+
+	size_t numa_topology::node_count()
+	{
+		return get_topology().node_count;
+	}
+
+	size_t numa_topology::node_of_cpu(int cpu)
+	{
+		if (cpu < 0 || static_cast<size_t>(cpu) >= MAX_CPUS)
+		{
+			return 0;
+		}
+		return get_topology().cpu_nodes[cpu];
+	}
+
+	size_t numa_topology::current_node()
+	{
+		const topology_state& state = get_topology();
+		if (state.node_count == 1)
+		{
+			return 0;
+		}
+#if defined(__linux__)
+		return node_of_cpu(sched_getcpu());
+#else
+		return 0;
+#endif
+	}
+
+	void numa_topology::bind_memory(span<byte> memory, size_t node)
+	{
+		const topology_state& state = get_topology();
+		if (state.node_count == 1 || state.simulated || memory.size() == 0)
+		{
+			return;
+		}
+#if defined(__linux__) && defined(SYS_mbind)
+		//不依赖 libnuma，直接发系统调用；MPOL_PREFERRED 的值是 1
+		constexpr int MPOL_PREFERRED_MODE = 1;
+		const size_t system_node = static_cast<size_t>(state.system_nodes[node]);
+		constexpr size_t BITS_PER_WORD = sizeof(unsigned long) * 8;
+		unsigned long mask[1024 / BITS_PER_WORD] = {};
+		if (system_node >= sizeof(mask) * 8)
+		{
+			return;
+		}
+		mask[system_node / BITS_PER_WORD] |= 1UL << (system_node % BITS_PER_WORD);
+		//绑定失败（例如被 cgroup 限制）时内存仍然可用，只是不保证在本节点上
+		syscall(SYS_mbind, memory.data(), memory.size(), MPOL_PREFERRED_MODE, mask, sizeof(mask) * 8, 0);
+#else
+		(void)node;
+#endif
+	}
+}
@@ -1,175 +1,926 @@
-#define NOMINMAX//windows.hԶmanminmystlĳͻ
+#define NOMINMAX//windows.h会自动引入man和min，和mystl的冲突
 #if defined(_WIN32)
 #include<windows.h>
 #else
 #include <sys/mman.h>
 #endif
 
-#include <iostream>
-
 #include "../../include/TCMalloc/PageCache.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/TransferCache.h"
+#include "../../include/TCMalloc/CpuCache.h"
+#include "../../include/TCMalloc/MetadataArena.h"
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include "../../include/TCMalloc/TCMallocTrace.h"
 #include "../../include/TCMalloc/TCMallocBootstrap.h"
-#include "../../include/set.h"
-#include "../../include/map.h"
-#include "../../include/vector.h"
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
 namespace mystl
 {
+	namespace
+	{
+		//归还给系统的页面再次访问时是否一定是零
+		//MADV_DONTNEED 之后私有匿名映射重新补的是零页，Windows 重新提交的页面也是零
+		//MADV_FREE 在内核真正回收之前访问到的还是原来的数据
+#if !defined(_WIN32) && defined(MYSTL_TCMALLOC_MADV_FREE) && defined(MADV_FREE)
+		constexpr bool RELEASED_PAGES_ARE_ZERO = false;
+#else
+		constexpr bool RELEASED_PAGES_ARE_ZERO = true;
+#endif
+
+#if !defined(_WIN32) && (defined(MYSTL_TCMALLOC_HUGE_PAGES) || defined(MYSTL_TCMALLOC_HUGETLB))
+		constexpr bool HUGE_PAGES_ENABLED = true;
+
+		//申请按大页对齐的区域，size 必须是大页的整数倍，失败返回 nullptr
+		void* system_allocate_huge_memory(size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_HUGETLB) && defined(MAP_HUGETLB)
+			void* huge = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (huge != MAP_FAILED)
+			{
+				return huge;
+			}
+			//没有预留足够的大页时退回透明大页
+#endif
+			//多映射一个大页的长度，再把前后多出来的部分还回去，剩下的就是对齐的区域
+			const size_t reserve_size = size + page_cache::HUGE_PAGE_SIZE;
+			void* ptr = mmap(nullptr, reserve_size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (ptr == MAP_FAILED)
+			{
+				return nullptr;
+			}
+			byte* start = static_cast<byte*>(ptr);
+			byte* aligned = reinterpret_cast<byte*>(size_utils::align(reinterpret_cast<uintptr_t>(start), page_cache::HUGE_PAGE_SIZE));
+			if (aligned != start)
+			{
+				munmap(start, aligned - start);
+			}
+			const size_t tail_size = (start + reserve_size) - (aligned + size);
+			if (tail_size != 0)
+			{
+				munmap(aligned + size, tail_size);
+			}
+#if defined(MADV_HUGEPAGE)
+			madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+			return aligned;
+		}
+#else
+		constexpr bool HUGE_PAGES_ENABLED = false;
+#endif
+		static_assert(page_cache::HUGE_PAGE_SIZE == size_t(1) << page_map::HUGE_PAGE_SHIFT, "page_map counts pages per huge page");
+
+		//归还物理内存时实际能归还的部分：开启大页后只取中间完整的大页，拆开大页会让内核把它退化成小页
+		span<byte> releasable_part(const page_run* run)
+		{
+			if (!HUGE_PAGES_ENABLED)
+			{
+				return run->memory();
+			}
+			byte* start = reinterpret_cast<byte*>(size_utils::align(reinterpret_cast<uintptr_t>(run->start), page_cache::HUGE_PAGE_SIZE));
+			byte* end = reinterpret_cast<byte*>(reinterpret_cast<uintptr_t>(run->end()) & ~(page_cache::HUGE_PAGE_SIZE - 1));
+			if (start >= end)
+			{
+				return span<byte>();
+			}
+			return span<byte>(start, static_cast<size_t>(end - start));
+		}
+
+		//正在使用中的大块，page_map 指向其中的 owner
+		//owner 放在最前面，释放时可以从 page_map 查到的指针直接还原出整条记录
+		struct large_span_record
+		{
+			page_span owner;
+			//单独向系统映射的，释放时直接归还给系统
+			bool dedicated = false;
+			large_span_record* prev = nullptr;
+			large_span_record* next = nullptr;
+
+			large_span_record(span<byte> memory, bool is_dedicated, size_t node) : owner(memory, memory.size(), node), dedicated(is_dedicated) {}
+		};
+		static_assert(std::is_standard_layout_v<large_span_record>, "large_span_record must start with its page_span");
+	}
+
 	class PageCacheImpl
 	{
 	public:
-		// ԭе˽ݳԱƵ
-		mystl::map<size_t, mystl::set<span<byte>>> free_page_store;
-		mystl::map<byte*, span<byte>> free_page_map;
-		mystl::vector<span<byte>> page_vector;
+		//不超过这个页数的空闲页段每个页数一个桶，桶里任何一段都能直接使用
+		static constexpr size_t MAX_EXACT_PAGES = 128;
+		//更大的按 2 的幂分组，同一个桶里的页段需要挑选
+		static constexpr size_t BUCKET_COUNT = MAX_EXACT_PAGES + 2 + sizeof(size_t) * 8 - detail::bit_width(MAX_EXACT_PAGES + 1);
+		static constexpr size_t BITMAP_WORDS = (BUCKET_COUNT + 63) / 64;
+
+		static constexpr size_t STATE_COUNT = 3;
+		//开启大页时挑选空闲页段最多看多少个候选
+		static constexpr size_t MAX_PACK_CANDIDATES = 16;
+
+		//按 page_state 分组的空闲页段，只和同状态的页段合并
+		page_run* free_lists[STATE_COUNT][BUCKET_COUNT] = {};
+		uint64_t nonempty_buckets[STATE_COUNT][BITMAP_WORDS] = {};
+		//向系统申请的区域，只在 stop 时归还
+		page_run* regions = nullptr;
+		//正在使用中的大块
+		large_span_record* large_spans = nullptr;
+		//上面这些记录都从元数据池中申请，不经过 mystl::allocator
+		metadata_arena<page_run> run_arena;
+		metadata_arena<large_span_record> large_arena;
+		//所属的 NUMA 节点
+		size_t node = 0;
+		// 空闲页面中仍然占着物理内存的字节数
+		size_t free_committed_bytes = 0;
+		// 空闲页面中已经归还给系统的字节数
+		size_t released_bytes = 0;
+		// 空闲页面中映射以后还没有访问过的字节数，不占物理内存，也不计入保留预算
+		size_t untouched_bytes = 0;
+		// 元数据池向系统要不到内存时，从归还的页面里拿去充当页段记录的字节数，不会再被分配出去
+		size_t metadata_bytes = 0;
+
+		size_t& bytes_of(page_state state)
+		{
+			switch (state)
+			{
+			case page_state::committed:
+				return free_committed_bytes;
+			case page_state::released:
+				return released_bytes;
+			default:
+				return untouched_bytes;
+			}
+		}
+
+		static size_t bucket_of(size_t page_count)
+		{
+			if (page_count <= MAX_EXACT_PAGES)
+			{
+				return page_count;
+			}
+			return MAX_EXACT_PAGES + 1 + std::bit_width(page_count) - detail::bit_width(MAX_EXACT_PAGES + 1);
+		}
+
+		//挂到所在的桶上，并在 page_map 中登记首页和尾页
+		void link(page_run* run)
+		{
+			run->node = node;
+			const size_t state = static_cast<size_t>(run->state);
+			const size_t bucket = bucket_of(run->page_count);
+			page_run*& head = free_lists[state][bucket];
+			run->prev = nullptr;
+			run->next = head;
+			if (head != nullptr)
+			{
+				head->prev = run;
+			}
+			head = run;
+			nonempty_buckets[state][bucket / 64] |= uint64_t(1) << (bucket % 64);
+
+			page_map& map = page_map::get_instance();
+			map.set_run(run->start, run);
+			map.set_run(run->end() - size_utils::PAGE_SIZE, run);
+			bytes_of(run->state) += run->page_count * size_utils::PAGE_SIZE;
+		}
+
+		void unlink(page_run* run)
+		{
+			const size_t state = static_cast<size_t>(run->state);
+			const size_t bucket = bucket_of(run->page_count);
+			if (run->prev != nullptr)
+			{
+				run->prev->next = run->next;
+			}
+			else
+			{
+				free_lists[state][bucket] = run->next;
+				if (run->next == nullptr)
+				{
+					nonempty_buckets[state][bucket / 64] &= ~(uint64_t(1) << (bucket % 64));
+				}
+			}
+			if (run->next != nullptr)
+			{
+				run->next->prev = run->prev;
+			}
+			run->prev = nullptr;
+			run->next = nullptr;
+
+			page_map& map = page_map::get_instance();
+			map.set_run(run->start, nullptr);
+			map.set_run(run->end() - size_utils::PAGE_SIZE, nullptr);
+			bytes_of(run->state) -= run->page_count * size_utils::PAGE_SIZE;
+		}
+
+		//从 bucket 开始第一个非空的桶，没有时返回 BUCKET_COUNT
+		size_t next_bucket(size_t state, size_t bucket) const
+		{
+			size_t word = bucket / 64;
+			if (word >= BITMAP_WORDS)
+			{
+				return BUCKET_COUNT;
+			}
+			uint64_t bits = nonempty_buckets[state][word] & (~uint64_t(0) << (bucket % 64));
+			while (bits == 0)
+			{
+				if (++word == BITMAP_WORDS)
+				{
+					return BUCKET_COUNT;
+				}
+				bits = nonempty_buckets[state][word];
+			}
+			return word * 64 + std::countr_zero(bits);
+		}
+
+		//链表中能放下 page_count 页的最小页段，一样大时取地址低的，减少碎片
+		static page_run* best_fit(page_run* run, size_t page_count)
+		{
+			page_run* best = nullptr;
+			for (; run != nullptr; run = run->next)
+			{
+				if (run->page_count >= page_count &&
+					(best == nullptr || run->page_count < best->page_count ||
+						(run->page_count == best->page_count && run->start < best->start)))
+				{
+					best = run;
+				}
+			}
+			return best;
+		}
+
+		//开启大页时登记分出去和收回来的页面，只在持有锁时调用
+		static void count_huge_used(span<byte> pages, bool used)
+		{
+			if (HUGE_PAGES_ENABLED)
+			{
+				page_map::get_instance().add_huge_used(pages, used);
+			}
+		}
+
+		//放得下的页段里挑所在大页已经分出去最多页数的，小对象的 span 挤在同一个大页里，
+		//其余的大页保持整个空闲，可以整个归还；一样多时取先看到的，也就是桶号小的
+		page_run* find_packed(size_t state, size_t page_count) const
+		{
+			page_map& map = page_map::get_instance();
+			page_run* best = nullptr;
+			size_t best_used = 0;
+			size_t candidates = 0;
+			for (size_t bucket = next_bucket(state, bucket_of(page_count));
+				bucket < BUCKET_COUNT && candidates < MAX_PACK_CANDIDATES; bucket = next_bucket(state, bucket + 1))
+			{
+				for (page_run* run = free_lists[state][bucket]; run != nullptr && candidates < MAX_PACK_CANDIDATES; run = run->next)
+				{
+					if (run->page_count < page_count)
+					{
+						continue;
+					}
+					++candidates;
+					//span 从页段的开头切出来，看开头所在的大页
+					const size_t used = map.get_huge_used(run->start);
+					if (best == nullptr || used > best_used)
+					{
+						best = run;
+						best_used = used;
+					}
+				}
+			}
+			return best;
+		}
+
+		//找一段不少于 page_count 页的空闲页段，没有时返回 nullptr
+		page_run* find(page_state run_state, size_t page_count) const
+		{
+			const size_t state = static_cast<size_t>(run_state);
+			if (HUGE_PAGES_ENABLED && page_count < page_map::PAGES_PER_HUGE_PAGE)
+			{
+				return find_packed(state, page_count);
+			}
+			size_t bucket = bucket_of(page_count);
+			if (bucket > MAX_EXACT_PAGES)
+			{
+				//分组的桶里可能有比需要的更短的页段
+				if (page_run* run = best_fit(free_lists[state][bucket], page_count))
+				{
+					return run;
+				}
+				++bucket;
+			}
+			bucket = next_bucket(state, bucket);
+			if (bucket == BUCKET_COUNT)
+			{
+				return nullptr;
+			}
+			if (bucket <= MAX_EXACT_PAGES)
+			{
+				return free_lists[state][bucket];
+			}
+			return best_fit(free_lists[state][bucket], page_count);
+		}
 	};
 
-	page_cache::page_cache() : pimpl(nullptr), m_stop(false) 
+	page_cache::page_cache(size_t node) : pimpl(nullptr), m_node(node), m_stop(false) 
 	{
-		g_is_allocator_constructing = true;
+		//机器上不存在的节点不会被用到，不创建内部数据
+		if (node >= numa_topology::node_count())
+		{
+			return;
+		}
+		allocator_reentry_guard guard;
 		pimpl = new PageCacheImpl();
-		g_is_allocator_constructing = false;
+		pimpl->node = node;
 	}
 
 	page_cache::~page_cache()
 	{
-		stop();
-		delete pimpl;
+#if !defined(MYSTL_TCMALLOC_IMMORTAL)
+		if (pimpl != nullptr)
+		{
+			//进程退出时不再检查有没有页面在使用
+			std::unique_lock<std::mutex> guard(m_mutex);
+			unmap_all();
+			guard.unlock();
+			delete pimpl;
+		}
+#endif
 	}
 
 
 
-	std::optional<span<byte>> page_cache::allocate_page(size_t page_count)
+	std::optional<span<byte>> page_cache::allocate_page(size_t page_count, bool* zeroed)
 	{
 		if (page_count == 0)
 		{
 			return std::nullopt;
 		}
 		std::unique_lock<std::mutex> guard(m_mutex);
+		page_state state = page_state::committed;
+		bool is_zero = false;
+		auto memory_opt = take_pages(page_count, state, is_zero);
+		if (!memory_opt)
+		{
+			return std::nullopt;
+		}
+		if (state == page_state::released)
+		{
+			system_commit_memory(*memory_opt);
+		}
+		if (zeroed != nullptr)
+		{
+			*zeroed = is_zero;
+		}
+		PageCacheImpl::count_huge_used(*memory_opt, true);
+		MYSTL_TCMALLOC_TRACE_EVENT(span_allocate, memory_opt->data(), memory_opt->size());
+		return memory_opt;
+	}
 
-		std::cout << "    [PageCache] INFO: Request to allocate " << page_count << " pages.\n";
+	std::optional<span<byte>> page_cache::take_pages(size_t page_count, page_state& state, bool& zeroed)
+	{
+		const size_t memory_to_use = page_count * size_utils::PAGE_SIZE;
 
-		auto it = pimpl->free_page_store.lower_bound(page_count);
-		while (it != pimpl->free_page_store.end())
+		//优先使用仍然占着物理内存的页面，其次是还没有访问过的页面，最后才是需要重新提交的已归还页面
+		page_run* run = pimpl->find(page_state::committed, page_count);
+		if (run == nullptr)
+		{
+			run = pimpl->find(page_state::untouched, page_count);
+		}
+		if (run == nullptr)
+		{
+			run = pimpl->find(page_state::released, page_count);
+		}
+		if (run != nullptr)
 		{
-			if (!it->second.empty())
+			pimpl->unlink(run);
+			//从前面切下需要的部分，剩下的仍是同状态的空闲页段，不会再和相邻的页段相接
+			span<byte> memory(run->start, memory_to_use);
+			state = run->state;
+			zeroed = run->zeroed;
+			if (run->page_count > page_count)
 			{
-				//һҳ棬ҳĴСǴڻҪҳ
-				auto mem_iter = it->second.begin();
-				span<byte> free_memory = *mem_iter;
-				it->second.erase(mem_iter);
-				pimpl->free_page_map.erase(free_memory.data());
-
-				//ָȡĿռ
-				size_t memory_to_use = page_count * size_utils::PAGE_SIZE;
-				span<byte> memory = free_memory.subspan(0, memory_to_use);
-				free_memory = free_memory.subspan(memory_to_use);
-				//黹
-				if (free_memory.size())
-				{
-					pimpl->free_page_store[free_memory.size() / size_utils::PAGE_SIZE];
-					pimpl->free_page_map.emplace(free_memory.data(), free_memory);
-				}
-				return memory;
+				run->start += memory_to_use;
+				run->page_count -= page_count;
+				pimpl->link(run);
+			}
+			else
+			{
+				pimpl->run_arena.destroy(run);
 			}
-			++it;
+			return memory;
 		}
-		
-		std::cout << "    [PageCache] WARNING: No suitable page in cache. Requesting from OS...\n";
 
-		//Ѿû㹻ҳˣϵͳ
-		//һϵͳС2048ҳ
+		//如果已经没有足够大的页面了，就向系统申请
+		//一次性向系统申请的最小申请2048个页面
 		size_t page_to_allocate = mystl::max(PAGE_ALLOCATE_COUNT, page_count);
-		auto memory_opt = system_allocate_memory(page_to_allocate);
+		if (HUGE_PAGES_ENABLED)
+		{
+			//区域按整个大页申请，小对象的 span 从前往后依次切出来，之后 find 也优先挑用得多的大页里的页段
+			page_to_allocate = size_utils::align(page_to_allocate, HUGE_PAGE_SIZE / size_utils::PAGE_SIZE);
+		}
+		//区域本身和切剩下的页面各要一条记录，先预留好，映射以后就不会因为记录不够而丢掉页面
+		std::optional<span<byte>> memory_opt;
+		if (pimpl->run_arena.reserve(2))
+		{
+			memory_opt = system_allocate_memory(page_to_allocate);
+		}
 		if (!memory_opt)
 		{
-			std::cout << "    [PageCache] FATAL: System memory allocation failed!\n";
-			return std::nullopt; // ʧ
+			MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, page_to_allocate * size_utils::PAGE_SIZE);
+			return std::nullopt; // 分配失败
 		}
 		span<byte> memory = *memory_opt;
+		page_run* region = pimpl->run_arena.create(memory.data(), page_to_allocate, page_state::untouched, true);
+		MYSTL_TCMALLOC_TRACE_EVENT(page_grow, memory.data(), memory.size());
 
-		//ܵڴڽβڴ
-		pimpl->page_vector.push_back(memory);
-		size_t memory_to_use = page_count * size_utils::PAGE_SIZE;
+		//记录整块区域用于结尾回收内存
+		region->next = pimpl->regions;
+		pimpl->regions = region;
+		//登记这些页面归这个节点所有，合并空闲页段时据此判断相邻的页面能不能碰
+		page_map::get_instance().set_run_node(memory, m_node);
 		span<byte> result = memory.subspan(0, memory_to_use);
 		span<byte> free_memory = memory.subspan(memory_to_use);
 		if (free_memory.size())
 		{
-			size_t index = free_memory.size() / size_utils::PAGE_SIZE;
-			pimpl->free_page_store[index].emplace(free_memory);
-			pimpl->free_page_map.emplace(free_memory.data(), free_memory);
+			//剩下的页面还没有访问过，不占物理内存，也不计入保留预算
+			insert_free_run(free_memory, page_state::untouched, true);
 		}
+		state = page_state::untouched;
+		zeroed = true;
 		return result;
 	}
 
 	void page_cache::deallocate_page(span<byte> page)
 	{
-		//һҳһҳĻյģԴСһǻᱻ
+		//由于是一页一页的回收的，所以大小一定是会被整除的
 		assert(page.size() % size_utils::PAGE_SIZE == 0);
 		std::unique_lock<std::mutex> guard(m_mutex);
+		MYSTL_TCMALLOC_TRACE_EVENT(span_deallocate, page.data(), page.size());
+		PageCacheImpl::count_huge_used(page, false);
+
+		//只和仍然占着物理内存的空闲页面合并，已归还的页面保持原状
+		//元数据池耗尽时 insert_free_run 会拿这段页面的第一页充当记录，归还本身不会失败
+		insert_free_run(page, page_state::committed, false);
+
+		//超出预算时多归还四分之一，避免在预算附近每次回收都触发系统调用
+		if (pimpl->free_committed_bytes > m_release_budget) {
+			release_to_budget(m_release_budget - m_release_budget / 4);
+		}
+	}
+
+	page_run* page_cache::insert_free_run(span<byte> page, page_state state, bool zeroed)
+	{
+		page_map& map = page_map::get_instance();
+		const size_t page_count = page.size() / size_utils::PAGE_SIZE;
+		byte* page_end = page.data() + page.size();
+		//相邻的页面可能属于另一个节点的页面堆，那边的 page_run 由那个节点的锁保护，
+		//所以先按 page_map 登记的节点确认是自己的页面，再去读它的页段记录
+		page_run* prev = map.get_run_node(page.data() - size_utils::PAGE_SIZE) == m_node ? map.get_run(page.data() - size_utils::PAGE_SIZE) : nullptr;
+		page_run* next = map.get_run_node(page_end) == m_node ? map.get_run(page_end) : nullptr;
+		page_run* run = nullptr;
+
+		if (prev != nullptr && prev->state == state && prev->end() == page.data()) {
+			// 如果前面一段的空间与当前的相邻，则合并
+			pimpl->unlink(prev);
+			prev->page_count += page_count;
+			prev->zeroed = prev->zeroed && zeroed;
+			run = prev;
+		}
+		if (next != nullptr && next->state == state && next->start == page_end) {
+			// 后面相邻的页段
+			pimpl->unlink(next);
+			if (run != nullptr) {
+				run->page_count += next->page_count;
+				run->zeroed = run->zeroed && next->zeroed;
+				pimpl->run_arena.destroy(next);
+			}
+			else {
+				next->start = page.data();
+				next->page_count += page_count;
+				next->zeroed = next->zeroed && zeroed;
+				run = next;
+			}
+		}
+		if (run == nullptr) {
+			run = pimpl->run_arena.create(page.data(), page_count, state, zeroed);
+			if (run == nullptr) {
+				//元数据池向系统要不到内存。其他状态的页面调用者都事先预留了记录，走到这里的是刚归还、占着物理内存的页面
+				//拿出第一页切成记录，剩下的照常放回去，页面不会凭空消失
+				assert(state == page_state::committed);
+				MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, page.data(), page.size());
+				span<byte> donated = page.subspan(0, size_utils::PAGE_SIZE);
+				pimpl->run_arena.donate(donated);
+				pimpl->metadata_bytes += donated.size();
+				if (page_count == 1) {
+					return nullptr;
+				}
+				return insert_free_run(page.subspan(size_utils::PAGE_SIZE), state, zeroed);
+			}
+		}
+		else if (state == page_state::committed) {
+			MYSTL_TCMALLOC_TRACE_EVENT(page_coalesce, run->start, run->page_count * size_utils::PAGE_SIZE);
+		}
+		pimpl->link(run);
+		return run;
+	}
+
+	void page_cache::set_release_budget(size_t budget)
+	{
+		std::unique_lock<std::mutex> guard(m_mutex);
+		m_release_budget = budget;
+		if (pimpl->free_committed_bytes > m_release_budget) {
+			release_to_budget(m_release_budget);
+		}
+	}
+
+	size_t page_cache::release_free_memory()
+	{
+		//先让按CPU的缓存和中转层把块还给中心缓存，空出来的 span 回到这里以后才能一起归还
+		//中心缓存归还 span 时要拿这个页面堆的锁，所以必须在加锁之前做
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+		if (cpu_cache::is_available())
+		{
+			cpu_cache::get_instance().drain();
+		}
+#endif
+		transfer_cache::get_instance(m_node).drain();
+		std::unique_lock<std::mutex> guard(m_mutex);
+		return release_to_budget(0);
+	}
 
-		while (true) {
-			//ռ䲻ӦѾ
-			assert(pimpl->free_page_map.find(page.data()) == pimpl->free_page_map.end());
-			auto it = pimpl->free_page_map.upper_bound(page.data());
-			if (it != pimpl->free_page_map.begin()) {
-				// ǰһspan
-				--it;
-				const span<byte>& memory = it->second;
-				if (memory.data() + memory.size() == page.data()) {
-					// ǰһεĿռ뵱ǰڣϲ
-					page = span<byte>(memory.data(), memory.size() + page.size());
-					// ڴҲɾ
-					pimpl->free_page_store[memory.size() / size_utils::PAGE_SIZE].erase(memory);
-					pimpl->free_page_map.erase(it);
+	size_t page_cache::release_to_budget(size_t budget)
+	{
+		size_t released = 0;
+		if (m_stop) {
+			return released;
+		}
+		//从最大的空闲段开始归还，这样系统调用的次数最少
+		for (size_t bucket = PageCacheImpl::BUCKET_COUNT - 1; bucket > 0 && pimpl->free_committed_bytes > budget; --bucket) {
+			page_run* run = pimpl->free_lists[static_cast<size_t>(page_state::committed)][bucket];
+			while (run != nullptr && pimpl->free_committed_bytes > budget) {
+				page_run* next_run = run->next;
+				span<byte> page = releasable_part(run);
+				if (page.size() == 0) {
+					//放不下一个完整的大页，留着不归还
+					run = next_run;
+					continue;
 				}
-				else {
-					break; // ûǰڵĿԺϲ
+				//拆成三段最多要三条记录，原来那条会先还回元数据池，再预留两条
+				//预留不到就不再归还，页段原样留在空闲链表上
+				if (!pimpl->run_arena.reserve(2)) {
+					return released;
 				}
+				pimpl->unlink(run);
+				//开启大页时两端不满一个大页的部分仍然是占着物理内存的空闲页面
+				//它们原来的邻居都不是占着物理内存的空闲页段，不会合并，所以 next_run 仍然有效
+				span<byte> head(run->start, static_cast<size_t>(page.data() - run->start));
+				span<byte> tail(page.data() + page.size(), static_cast<size_t>(run->end() - (page.data() + page.size())));
+				pimpl->run_arena.destroy(run);
+				system_release_memory(page);
+				MYSTL_TCMALLOC_TRACE_EVENT(page_release, page.data(), page.size());
+				released += page.size();
+				insert_free_run(page, page_state::released, RELEASED_PAGES_ARE_ZERO);
+				if (head.size() != 0) {
+					insert_free_run(head, page_state::committed, false);
+				}
+				if (tail.size() != 0) {
+					insert_free_run(tail, page_state::committed, false);
+				}
+				run = next_run;
 			}
-			else {
-				break; // ûǰ
+		}
+		return released;
+	}
+
+	std::optional<span<byte>> page_cache::allocate_unit(size_t memory_size, bool* zeroed) {
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		page_cache& cache = get_instance();
+		const size_t page_count = size_utils::align(memory_size, size_utils::PAGE_SIZE) / size_utils::PAGE_SIZE;
+		const bool dedicated = page_count * size_utils::PAGE_SIZE >= LARGE_MMAP_THRESHOLD;
+
+		//特别大的块单独映射，释放时直接还给系统，不在页面缓存里长期占着
+		std::optional<span<byte>> memory_opt = dedicated
+			? cache.system_allocate_memory(page_count)
+			: cache.allocate_page(page_count, zeroed);
+		if (!memory_opt)
+		{
+			MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, page_count * size_utils::PAGE_SIZE);
+			return std::nullopt;
+		}
+		span<byte> memory = *memory_opt;
+		if (dedicated && zeroed != nullptr)
+		{
+			//新映射的内存一定是零
+			*zeroed = true;
+		}
+
+		if (cache.register_large_unit(memory, dedicated))
+		{
+			if (dedicated)
+			{
+				MYSTL_TCMALLOC_TRACE_EVENT(large_map, memory.data(), memory.size());
 			}
+			return memory;
 		}
 
-		// ڵspan
-		while (true) {
-			assert(pimpl->free_page_map.find(page.data()) == pimpl->free_page_map.end());
-			// ****:  map::contains 滻Ϊ map::find
-			auto it = pimpl->free_page_map.find(page.data() + page.size());
-			if (it != pimpl->free_page_map.end()) {
-				span<byte> next_memory = it->second;
-				pimpl->free_page_store[next_memory.size() / size_utils::PAGE_SIZE].erase(next_memory);
-				pimpl->free_page_map.erase(it);
-				page = span<byte>(page.data(), page.size() + next_memory.size());
+		//记录申请不到，把刚拿到的页面退回去
+		MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, memory.size());
+		if (dedicated)
+		{
+			cache.system_deallocate_memory(memory);
+		}
+		else
+		{
+			cache.deallocate_page(memory);
+		}
+		return std::nullopt;
+	}
+
+	std::optional<span<byte>> page_cache::reallocate_unit(span<byte> memories, size_t new_size)
+	{
+		assert(new_size > size_utils::MAX_CACHED_UNIT_SIZE);
+		if (new_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		const size_t new_bytes = size_utils::align(new_size, size_utils::PAGE_SIZE);
+		page_map& map = page_map::get_instance();
+		//调用者持有这个块，记录在加锁之前也不会变
+		page_span* owner = map.get(memories.data());
+		assert(owner != nullptr && owner->data() == memories.data() && owner->unit_size() == owner->size());
+		page_cache& cache = get_instance(owner->node());
+		std::unique_lock<std::mutex> guard(cache.m_mutex);
+		large_span_record* record = reinterpret_cast<large_span_record*>(owner);
+		span<byte> memory = owner->get_memory_span();
+		if (new_bytes == memory.size())
+		{
+			return memory;
+		}
+
+		span<byte> result;
+		if (record->dedicated)
+		{
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			//内核直接搬动页表，不复制数据
+			void* ptr = mremap(memory.data(), memory.size(), new_bytes, MREMAP_MAYMOVE);
+			if (ptr == MAP_FAILED)
+			{
+				return std::nullopt;
 			}
-			else {
-				break; // ûкڵĿԺϲ
+			result = span<byte>(static_cast<byte*>(ptr), new_bytes);
+			MYSTL_TCMALLOC_TRACE_EVENT(large_unmap, memory.data(), memory.size());
+			MYSTL_TCMALLOC_TRACE_EVENT(large_map, result.data(), result.size());
+#else
+			return std::nullopt;
+#endif
+		}
+		else if (new_bytes < memory.size())
+		{
+			//缩小：多余的页面还给页面缓存，记录不够时不缩小，由调用者另外申请
+			if (!cache.pimpl->run_arena.reserve(1))
+			{
+				return std::nullopt;
+			}
+			result = memory.subspan(0, new_bytes);
+			span<byte> tail = memory.subspan(new_bytes);
+			MYSTL_TCMALLOC_TRACE_EVENT(span_deallocate, tail.data(), tail.size());
+			PageCacheImpl::count_huge_used(tail, false);
+			cache.insert_free_run(tail, page_state::committed, false);
+		}
+		else
+		{
+			//增长：后面紧挨着的页面必须是空闲的，并且足够长
+			const size_t extra_pages = (new_bytes - memory.size()) / size_utils::PAGE_SIZE;
+			//后面的页面不是这个节点的就不去读它的页段记录
+			page_run* next = map.get_run_node(memory.data() + memory.size()) == cache.m_node ? map.get_run(memory.data() + memory.size()) : nullptr;
+			if (next == nullptr || next->start != memory.data() + memory.size() || next->page_count < extra_pages)
+			{
+				return std::nullopt;
+			}
+			cache.pimpl->unlink(next);
+			span<byte> extra(next->start, extra_pages * size_utils::PAGE_SIZE);
+			const bool released = next->state == page_state::released;
+			if (next->page_count > extra_pages)
+			{
+				next->start += extra.size();
+				next->page_count -= extra_pages;
+				cache.pimpl->link(next);
+			}
+			else
+			{
+				cache.pimpl->run_arena.destroy(next);
+			}
+			if (released)
+			{
+				cache.system_commit_memory(extra);
 			}
+			PageCacheImpl::count_huge_used(extra, true);
+			MYSTL_TCMALLOC_TRACE_EVENT(span_allocate, extra.data(), extra.size());
+			result = span<byte>(memory.data(), new_bytes);
+		}
+
+		//page_span 记录的范围不能修改，在原来的位置重新构造
+		owner->~page_span();
+		new(owner) page_span(result, result.size(), cache.m_node);
+		if (result.data() != memory.data())
+		{
+			map.clear(memory.subspan(0, size_utils::PAGE_SIZE));
+			map.set(result.subspan(0, size_utils::PAGE_SIZE), owner);
+		}
+		if (cache.pimpl->free_committed_bytes > cache.m_release_budget)
+		{
+			cache.release_to_budget(cache.m_release_budget - cache.m_release_budget / 4);
 		}
-		size_t index = page.size() / size_utils::PAGE_SIZE;
-		pimpl->free_page_store[index].emplace(page);
-		pimpl->free_page_map.emplace(page.data(), page);
+		return result;
 	}
 
-	std::optional<span<byte>> page_cache::allocate_unit(size_t memory_size) {
-		auto ret = malloc(memory_size);
-		if (ret != nullptr) {
-			return span<byte>{ static_cast<byte*>(ret), memory_size };
+	std::optional<span<byte>> page_cache::allocate_unit_aligned(size_t memory_size, size_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+		//多申请的对齐余量也要算在上限以内
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE
+			|| alignment > size_utils::MAX_ALLOCATION_SIZE - memory_size)
+		{
+			return std::nullopt;
 		}
-		return std::nullopt;
+		//释放时按块大小区分大块和小块，大块至少要比 MAX_CACHED_UNIT_SIZE 多一页
+		memory_size = mystl::max(memory_size, size_utils::MAX_CACHED_UNIT_SIZE + 1);
+		if (alignment <= size_utils::PAGE_SIZE)
+		{
+			//页面本身就是按页对齐的
+			return allocate_unit(memory_size);
+		}
+		page_cache& cache = get_instance();
+		const size_t page_count = size_utils::align(memory_size, size_utils::PAGE_SIZE) / size_utils::PAGE_SIZE;
+		auto memory_opt = cache.allocate_aligned_page(page_count, alignment);
+		if (!memory_opt)
+		{
+			MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, page_count * size_utils::PAGE_SIZE);
+			return std::nullopt;
+		}
+		//从页面缓存中切出来的，即使超过 LARGE_MMAP_THRESHOLD 释放时也要还给页面缓存
+		if (!cache.register_large_unit(*memory_opt, false))
+		{
+			MYSTL_TCMALLOC_TRACE_EVENT(allocation_failure, nullptr, memory_opt->size());
+			cache.deallocate_page(*memory_opt);
+			return std::nullopt;
+		}
+		return memory_opt;
+	}
+
+	std::optional<span<byte>> page_cache::allocate_aligned_page(size_t page_count, size_t alignment)
+	{
+		//多申请 alignment 减一页，其中一定有一个对齐的起点
+		const size_t extra_pages = alignment / size_utils::PAGE_SIZE - 1;
+		std::unique_lock<std::mutex> guard(m_mutex);
+		//take_pages 新申请区域时最多用两条记录，切下来的两端还要两条
+		if (!pimpl->run_arena.reserve(4))
+		{
+			return std::nullopt;
+		}
+		page_state state = page_state::committed;
+		bool zeroed = false;
+		auto memory_opt = take_pages(page_count + extra_pages, state, zeroed);
+		if (!memory_opt)
+		{
+			return std::nullopt;
+		}
+		span<byte> memory = *memory_opt;
+		byte* start = reinterpret_cast<byte*>(size_utils::align(reinterpret_cast<uintptr_t>(memory.data()), alignment));
+		span<byte> result(start, page_count * size_utils::PAGE_SIZE);
+		byte* result_end = start + result.size();
+		span<byte> head(memory.data(), static_cast<size_t>(start - memory.data()));
+		span<byte> tail(result_end, static_cast<size_t>(memory.data() + memory.size() - result_end));
+
+		//切下来的两端没有被用过，按原来的状态放回去，已归还的页面只重新提交中间用到的部分
+		if (head.size() != 0)
+		{
+			insert_free_run(head, state, zeroed);
+		}
+		if (tail.size() != 0)
+		{
+			insert_free_run(tail, state, zeroed);
+		}
+		if (state == page_state::released)
+		{
+			system_commit_memory(result);
+		}
+		PageCacheImpl::count_huge_used(result, true);
+		MYSTL_TCMALLOC_TRACE_EVENT(span_allocate, result.data(), result.size());
+		return result;
+	}
+
+	bool page_cache::register_large_unit(span<byte> memory, bool dedicated)
+	{
+		std::unique_lock<std::mutex> guard(m_mutex);
+		//整段页面当作一个单元来记录
+		large_span_record* record = pimpl->large_arena.create(memory, dedicated, m_node);
+		if (record == nullptr)
+		{
+			return false;
+		}
+		record->next = pimpl->large_spans;
+		if (record->next != nullptr)
+		{
+			record->next->prev = record;
+		}
+		pimpl->large_spans = record;
+		//释放时拿到的一定是起始地址，所以只登记第一页
+		page_map::get_instance().set(memory.subspan(0, size_utils::PAGE_SIZE), &record->owner);
+		return true;
 	}
 
 	void page_cache::deallocate_unit(span<byte> memories)
 	{
-		free(memories.data());
+		page_span* owner = page_map::get_instance().get(memories.data());
+		assert(owner != nullptr && owner->data() == memories.data() && owner->unit_size() == owner->size());
+		//还给申请时的那个节点
+		page_cache& cache = get_instance(owner->node());
+		span<byte> memory;
+		bool dedicated = false;
+		{
+			std::unique_lock<std::mutex> guard(cache.m_mutex);
+			large_span_record* record = reinterpret_cast<large_span_record*>(owner);
+			if (record->prev != nullptr)
+			{
+				record->prev->next = record->next;
+			}
+			else
+			{
+				cache.pimpl->large_spans = record->next;
+			}
+			if (record->next != nullptr)
+			{
+				record->next->prev = record->prev;
+			}
+			memory = owner->get_memory_span();
+			dedicated = record->dedicated;
+			page_map::get_instance().clear(memory.subspan(0, size_utils::PAGE_SIZE));
+			cache.pimpl->large_arena.destroy(record);
+		}
+		if (dedicated)
+		{
+			MYSTL_TCMALLOC_TRACE_EVENT(large_unmap, memory.data(), memory.size());
+			cache.system_deallocate_memory(memory);
+		}
+		else
+		{
+			//与相邻的空闲页面合并后留在页面缓存中
+			cache.deallocate_page(memory);
+		}
+	}
+
+	void page_cache::collect_stats(allocator_stats& stats)
+	{
+		std::unique_lock<std::mutex> guard(m_mutex);
+		for (page_run* region = pimpl->regions; region != nullptr; region = region->next) {
+			stats.mapped_bytes += region->page_count * size_utils::PAGE_SIZE;
+		}
+		for (large_span_record* record = pimpl->large_spans; record != nullptr; record = record->next) {
+			const size_t size = record->owner.size();
+			if (record->dedicated) {
+				stats.mapped_bytes += size;
+			}
+			stats.large_allocated_bytes += size;
+			++stats.large_allocated_count;
+		}
+		stats.page_free_bytes += pimpl->free_committed_bytes + pimpl->released_bytes + pimpl->untouched_bytes;
+		stats.page_released_bytes += pimpl->released_bytes;
+		stats.page_untouched_bytes += pimpl->untouched_bytes;
+		stats.page_metadata_bytes += pimpl->metadata_bytes;
 	}
 
-	void page_cache::stop() {
+	bool page_cache::stop() {
 		std::unique_lock<std::mutex> guard(m_mutex);
-		if (m_stop == false) {
-			m_stop = true;
-			for (auto& i : pimpl->page_vector) {
-				system_deallocate_memory(i);
+		if (m_stop) {
+			return true;
+		}
+		//区域里的页面必须全部在空闲链表上，并且没有未释放的大块
+		size_t region_bytes = 0;
+		for (page_run* region = pimpl->regions; region != nullptr; region = region->next) {
+			region_bytes += region->page_count * size_utils::PAGE_SIZE;
+		}
+		if (pimpl->large_spans != nullptr || region_bytes != pimpl->free_committed_bytes + pimpl->released_bytes + pimpl->untouched_bytes + pimpl->metadata_bytes) {
+			return false;
+		}
+		unmap_all();
+		return true;
+	}
+
+	void page_cache::unmap_all() {
+		if (m_stop) {
+			return;
+		}
+		m_stop = true;
+		for (page_run* region = pimpl->regions; region != nullptr; region = region->next) {
+			//地址之后可能被别的映射复用，不能再被当成这个节点的页面
+			page_map::get_instance().set_run_node(region->memory(), page_map::NO_NODE);
+			system_deallocate_memory(region->memory());
+		}
+		// 单独映射的大块不在 regions 里，要分别归还
+		for (large_span_record* record = pimpl->large_spans; record != nullptr; record = record->next) {
+			if (record->dedicated) {
+				system_deallocate_memory(record->owner.get_memory_span());
 			}
 		}
 	}
@@ -179,24 +930,38 @@ namespace mystl
 		const size_t size = page_count * size_utils::PAGE_SIZE;
 
 #if defined(_WIN32)
-		// Windows ʵ
+		// Windows 实现
 		void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
 		if (ptr == nullptr)
 		{
 			return std::nullopt;
 		}
-		// VirtualAlloc ڴĬ
+		// VirtualAlloc 申请的内存默认是清零的
 		// memset(ptr, 0, size);
 #else
-		// POSIX (Linux, macOS) ʵ
+#if defined(MYSTL_TCMALLOC_HUGE_PAGES) || defined(MYSTL_TCMALLOC_HUGETLB)
+		//整数倍大页的区域按大页对齐
+		if (size % HUGE_PAGE_SIZE == 0)
+		{
+			void* huge = system_allocate_huge_memory(size);
+			if (huge == nullptr)
+			{
+				return std::nullopt;
+			}
+			numa_topology::bind_memory(span<byte>{ static_cast<byte*>(huge), size }, m_node);
+			return span<byte>{ static_cast<byte*>(huge), size };
+		}
+#endif
+		// POSIX (Linux, macOS) 实现
 		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
 			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 		if (ptr == MAP_FAILED)
 		{
 			return std::nullopt;
 		}
-		// ڴ
-		memset(ptr, 0, size);
+		// 匿名映射本身就是清零的，不再 memset，物理页等到第一次访问时才分配
+		// 所以在这里绑定节点，之后补的物理页都从这个节点分配
+		numa_topology::bind_memory(span<byte>{ static_cast<byte*>(ptr), size }, m_node);
 #endif
 		return span<byte>{ static_cast<byte*>(ptr), size};
 	}
@@ -204,12 +969,33 @@ namespace mystl
 	void page_cache::system_deallocate_memory(span<byte> page)
 	{
 #if defined(_WIN32)
-		// Windows ʵ
-		//  VirtualAlloc ڴ棬size Ϊ 0Ϊ MEM_RELEASE
+		// Windows 实现
+		// 对于 VirtualAlloc 申请的内存，size 必须为 0，并且类型为 MEM_RELEASE
 		VirtualFree(page.data(), 0, MEM_RELEASE);
 #else
-		// POSIX ʵ
+		// POSIX 实现
 		munmap(page.data(), page.size());
+#endif
+	}
+
+	void page_cache::system_release_memory(span<byte> page)
+	{
+#if defined(_WIN32)
+		VirtualFree(page.data(), page.size(), MEM_DECOMMIT);
+#elif defined(MYSTL_TCMALLOC_MADV_FREE) && defined(MADV_FREE)
+		// 内核在内存紧张时才真正回收，开销更小，但 RSS 不会立刻下降
+		madvise(page.data(), page.size(), MADV_FREE);
+#else
+		madvise(page.data(), page.size(), MADV_DONTNEED);
+#endif
+	}
+
+	void page_cache::system_commit_memory(span<byte> page)
+	{
+#if defined(_WIN32)
+		VirtualAlloc(page.data(), page.size(), MEM_COMMIT, PAGE_READWRITE);
+#else
+		(void)page;
 #endif
 	}
 }
\ No newline at end of file
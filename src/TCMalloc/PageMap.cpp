@@ -0,0 +1,219 @@
+#define NOMINMAX//windows.h会自动引入max和min，和mystl的冲突
+#if defined(_WIN32)
+#include<windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <cassert>
+#include <new>
+#include <mutex>
+
+#include "../../include/TCMalloc/PageMap.h"
+
+namespace mystl
+{
+	namespace
+	{
+		//只在创建新节点时使用，查找路径上不加锁
+		std::mutex g_page_map_grow_mutex;
+	}
+
+	page_map::page_map()
+	{
+		for (size_t i = 0; i < ROOT_LENGTH; ++i)
+		{
+			m_root[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	//基数树的节点与进程同生命周期，析构时不归还给系统，
+	//避免退出阶段还在释放内存的线程访问到已经回收的节点
+	page_map::~page_map() = default;
+
+	page_span* page_map::get(const void* address) const
+	{
+		const uintptr_t number = page_number(address);
+		const size_t root_index = (number >> (LEAF_BITS + MIDDLE_BITS)) & (ROOT_LENGTH - 1);
+		const size_t middle_index = (number >> LEAF_BITS) & (MIDDLE_LENGTH - 1);
+		const size_t leaf_index = number & (LEAF_LENGTH - 1);
+
+		middle_node* middle = m_root[root_index].load(std::memory_order_acquire);
+		if (middle == nullptr)
+			return nullptr;
+		leaf_node* leaf = middle->leaves[middle_index].load(std::memory_order_acquire);
+		if (leaf == nullptr)
+			return nullptr;
+		return leaf->spans[leaf_index].load(std::memory_order_acquire);
+	}
+
+	void page_map::set(span<byte> pages, page_span* owner)
+	{
+		assert(pages.size() % size_utils::PAGE_SIZE == 0);
+		const uintptr_t first = page_number(pages.data());
+		const uintptr_t last = first + pages.size() / size_utils::PAGE_SIZE;
+		leaf_node* leaf = nullptr;
+		for (uintptr_t number = first; number < last; ++number)
+		{
+			//跨过叶子边界时才需要重新定位叶子
+			if (leaf == nullptr || (number & (LEAF_LENGTH - 1)) == 0)
+			{
+				leaf = ensure_leaf(number);
+			}
+			leaf->spans[number & (LEAF_LENGTH - 1)].store(owner, std::memory_order_release);
+		}
+	}
+
+	void page_map::clear(span<byte> pages)
+	{
+		assert(pages.size() % size_utils::PAGE_SIZE == 0);
+		const uintptr_t first = page_number(pages.data());
+		const uintptr_t last = first + pages.size() / size_utils::PAGE_SIZE;
+		for (uintptr_t number = first; number < last; ++number)
+		{
+			middle_node* middle = m_root[(number >> (LEAF_BITS + MIDDLE_BITS)) & (ROOT_LENGTH - 1)].load(std::memory_order_acquire);
+			if (middle == nullptr)
+				continue;
+			leaf_node* leaf = middle->leaves[(number >> LEAF_BITS) & (MIDDLE_LENGTH - 1)].load(std::memory_order_acquire);
+			if (leaf == nullptr)
+				continue;
+			leaf->spans[number & (LEAF_LENGTH - 1)].store(nullptr, std::memory_order_release);
+		}
+	}
+
+	page_run* page_map::get_run(const void* address) const
+	{
+		const uintptr_t number = page_number(address);
+		leaf_node* leaf = find_leaf(number);
+		return leaf == nullptr ? nullptr : leaf->runs[number & (LEAF_LENGTH - 1)];
+	}
+
+	void page_map::set_run(const void* address, page_run* run)
+	{
+		const uintptr_t number = page_number(address);
+		leaf_node* leaf = run == nullptr ? find_leaf(number) : ensure_leaf(number);
+		if (leaf != nullptr)
+		{
+			leaf->runs[number & (LEAF_LENGTH - 1)] = run;
+		}
+	}
+
+	size_t page_map::get_run_node(const void* address) const
+	{
+		const uintptr_t number = page_number(address);
+		leaf_node* leaf = find_leaf(number);
+		const unsigned char tag = leaf == nullptr ? 0 : leaf->run_nodes[number & (LEAF_LENGTH - 1)].load(std::memory_order_relaxed);
+		return tag == 0 ? NO_NODE : static_cast<size_t>(tag) - 1;
+	}
+
+	void page_map::set_run_node(span<byte> pages, size_t node)
+	{
+		assert(pages.size() % size_utils::PAGE_SIZE == 0);
+		assert(node == NO_NODE || node < 255);
+		const unsigned char tag = node == NO_NODE ? 0 : static_cast<unsigned char>(node + 1);
+		const uintptr_t first = page_number(pages.data());
+		const uintptr_t last = first + pages.size() / size_utils::PAGE_SIZE;
+		leaf_node* leaf = nullptr;
+		for (uintptr_t number = first; number < last; ++number)
+		{
+			if (leaf == nullptr || (number & (LEAF_LENGTH - 1)) == 0)
+			{
+				leaf = tag == 0 ? find_leaf(number) : ensure_leaf(number);
+			}
+			if (leaf != nullptr)
+			{
+				leaf->run_nodes[number & (LEAF_LENGTH - 1)].store(tag, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	size_t page_map::get_huge_used(const void* address) const
+	{
+		const uintptr_t number = page_number(address);
+		leaf_node* leaf = find_leaf(number);
+		return leaf == nullptr ? 0 : leaf->huge_used[(number & (LEAF_LENGTH - 1)) / PAGES_PER_HUGE_PAGE];
+	}
+
+	void page_map::add_huge_used(span<byte> pages, bool used)
+	{
+		assert(pages.size() % size_utils::PAGE_SIZE == 0);
+		uintptr_t number = page_number(pages.data());
+		const uintptr_t last = number + pages.size() / size_utils::PAGE_SIZE;
+		//按大页分段，每段只改一次计数
+		while (number < last)
+		{
+			const uintptr_t huge_end = (number | (PAGES_PER_HUGE_PAGE - 1)) + 1;
+			const uintptr_t end = huge_end < last ? huge_end : last;
+			uint16_t& count = ensure_leaf(number)->huge_used[(number & (LEAF_LENGTH - 1)) / PAGES_PER_HUGE_PAGE];
+			if (used)
+			{
+				count = static_cast<uint16_t>(count + (end - number));
+			}
+			else
+			{
+				assert(count >= end - number);
+				count = static_cast<uint16_t>(count - (end - number));
+			}
+			number = end;
+		}
+	}
+
+	page_map::leaf_node* page_map::find_leaf(uintptr_t number) const
+	{
+		middle_node* middle = m_root[(number >> (LEAF_BITS + MIDDLE_BITS)) & (ROOT_LENGTH - 1)].load(std::memory_order_acquire);
+		if (middle == nullptr)
+			return nullptr;
+		return middle->leaves[(number >> LEAF_BITS) & (MIDDLE_LENGTH - 1)].load(std::memory_order_acquire);
+	}
+
+	page_map::leaf_node* page_map::ensure_leaf(uintptr_t number)
+	{
+		const size_t root_index = (number >> (LEAF_BITS + MIDDLE_BITS)) & (ROOT_LENGTH - 1);
+		const size_t middle_index = (number >> LEAF_BITS) & (MIDDLE_LENGTH - 1);
+
+		middle_node* middle = m_root[root_index].load(std::memory_order_acquire);
+		if (middle == nullptr)
+		{
+			std::lock_guard<std::mutex> guard(g_page_map_grow_mutex);
+			middle = m_root[root_index].load(std::memory_order_relaxed);
+			if (middle == nullptr)
+			{
+				//系统返回的内存已经清零，原子量的初值就是 nullptr
+				middle = new(system_allocate_node(sizeof(middle_node))) middle_node;
+				m_root[root_index].store(middle, std::memory_order_release);
+			}
+		}
+
+		leaf_node* leaf = middle->leaves[middle_index].load(std::memory_order_acquire);
+		if (leaf == nullptr)
+		{
+			std::lock_guard<std::mutex> guard(g_page_map_grow_mutex);
+			leaf = middle->leaves[middle_index].load(std::memory_order_relaxed);
+			if (leaf == nullptr)
+			{
+				leaf = new(system_allocate_node(sizeof(leaf_node))) leaf_node;
+				middle->leaves[middle_index].store(leaf, std::memory_order_release);
+			}
+		}
+		return leaf;
+	}
+
+	void* page_map::system_allocate_node(size_t size)
+	{
+#if defined(_WIN32)
+		void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		if (ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+#else
+		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ptr == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+#endif
+		return ptr;
+	}
+}
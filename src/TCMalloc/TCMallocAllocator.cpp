@@ -0,0 +1,310 @@
+#include "../../include/TCMalloc/TCMallocAllocator.h"
+#include "../../include/TCMalloc/ThreadCache.h"
+#include "../../include/TCMalloc/CpuCache.h"
+#include "../../include/TCMalloc/CentralCache.h"
+#include "../../include/TCMalloc/PageCache.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/HeapProfiler.h"
+#include "../../include/TCMalloc/TCMallocBootstrap.h"
+#include <cstdlib>
+#include <cstring>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+#if !defined(__GLIBC__)
+#error "MYSTL_TCMALLOC_OVERRIDE_MALLOC requires glibc (__libc_malloc and friends)"
+#endif
+//glibc 导出的原始实现，替换掉 malloc 以后，分配器内部只能通过它们拿到系统内存
+extern "C"
+{
+	void* __libc_malloc(size_t size);
+	void __libc_free(void* ptr);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_memalign(size_t alignment, size_t size);
+}
+#endif
+
+namespace mystl
+{
+	namespace
+	{
+		//系统分配器：重入和线程退出阶段的分配都走这里，这些块不在 page_map 里
+		void* system_malloc(size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+			return __libc_malloc(size);
+#else
+			return std::malloc(size);
+#endif
+		}
+
+		void system_free(void* ptr)
+		{
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+			__libc_free(ptr);
+#else
+			std::free(ptr);
+#endif
+		}
+
+		void* system_calloc(size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+			return __libc_calloc(1, size);
+#else
+			return std::calloc(1, size);
+#endif
+		}
+
+		void* system_aligned_malloc(size_t alignment, size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+			return __libc_memalign(alignment, size);
+#elif defined(_WIN32)
+			return _aligned_malloc(size, alignment);
+#else
+			//aligned_alloc 要求大小是对齐值的整数倍
+			return std::aligned_alloc(alignment, size_utils::align(size, alignment));
+#endif
+		}
+
+		void system_aligned_free(void* ptr)
+		{
+#if defined(_WIN32) && !defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+			_aligned_free(ptr);
+#else
+			system_free(ptr);
+#endif
+		}
+
+		//当前线程能不能进入 thread_cache
+		bool can_use_thread_cache()
+		{
+			return !is_allocator_reentrant() && !g_thread_cache_destroyed;
+		}
+
+		//前端：能拿到CPU编号时走按CPU划分的缓存，否则走 thread_cache；调用者持有 allocator_reentry_guard
+		void* front_allocate(size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+			if (cpu_cache::is_available())
+			{
+				return cpu_cache::get_instance().allocate(size).value_or(nullptr);
+			}
+#endif
+			return thread_cache::get_instance().allocate(size).value_or(nullptr);
+		}
+
+		void* front_allocate_aligned(size_t size, size_t alignment)
+		{
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+			if (cpu_cache::is_available())
+			{
+				return cpu_cache::get_instance().allocate_aligned(size, alignment).value_or(nullptr);
+			}
+#endif
+			return thread_cache::get_instance().allocate_aligned(size, alignment).value_or(nullptr);
+		}
+
+		void* front_allocate_zeroed(size_t size)
+		{
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+			if (cpu_cache::is_available())
+			{
+				return cpu_cache::get_instance().allocate_zeroed(size).value_or(nullptr);
+			}
+#endif
+			return thread_cache::get_instance().allocate_zeroed(size).value_or(nullptr);
+		}
+
+		void front_deallocate(void* ptr, size_t unit_size)
+		{
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+			if (cpu_cache::is_available())
+			{
+				cpu_cache::get_instance().deallocate(ptr, unit_size);
+				return;
+			}
+#endif
+			thread_cache::get_instance().deallocate(ptr, unit_size);
+		}
+	}
+
+	void* tcmalloc_allocate(size_t size)
+	{
+		//超过上限的申请直接失败，不能让后面的对齐回绕成一个很小的块
+		if (size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return nullptr;
+		}
+		//malloc(0) 也要返回一个可以释放的唯一指针
+		if (size == 0)
+		{
+			size = 1;
+		}
+		if (!can_use_thread_cache())
+		{
+			return system_malloc(size);
+		}
+		allocator_reentry_guard guard;
+		return front_allocate(size);
+	}
+
+	void* tcmalloc_allocate_zeroed(size_t size)
+	{
+		if (size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return nullptr;
+		}
+		if (size == 0)
+		{
+			size = 1;
+		}
+		if (!can_use_thread_cache())
+		{
+			return system_calloc(size);
+		}
+		//大块整段页面确定是零时不再清零，和普通申请一样经过前端的采样
+		allocator_reentry_guard guard;
+		return front_allocate_zeroed(size);
+	}
+
+	void* tcmalloc_allocate_aligned(size_t size, size_t alignment)
+	{
+		if (alignment <= size_utils::ALIGNMENT)
+		{
+			return tcmalloc_allocate(size);
+		}
+		//对齐值必须是 2 的幂，大小加上对齐余量也不能超过上限
+		if ((alignment & (alignment - 1)) != 0
+			|| size > size_utils::MAX_ALLOCATION_SIZE || alignment > size_utils::MAX_ALLOCATION_SIZE - size)
+		{
+			return nullptr;
+		}
+		if (size == 0)
+		{
+			size = 1;
+		}
+		if (!can_use_thread_cache())
+		{
+			return system_aligned_malloc(alignment, size);
+		}
+		allocator_reentry_guard guard;
+		return front_allocate_aligned(size, alignment);
+	}
+
+	void tcmalloc_deallocate(void* ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+		//不在 page_map 里的指针一定来自系统分配器（重入时分配的）
+		page_span* owner = page_map::get_instance().get(ptr);
+		if (owner == nullptr)
+		{
+			system_free(ptr);
+			return;
+		}
+		if (!can_use_thread_cache())
+		{
+			//前端缓存删除采样记录的那一步也要在这里补上
+			if (heap_profiler::has_samples())
+			{
+				heap_profiler::get_instance().record_deallocation(ptr);
+			}
+			//线程缓存已经不在了，大块还给页面缓存，小块直接还给所属节点的中心缓存
+			if (owner->unit_size() > size_utils::MAX_CACHED_UNIT_SIZE)
+			{
+				page_cache::deallocate_unit(span<byte>(static_cast<byte*>(ptr), owner->unit_size()));
+				return;
+			}
+			free_list block;
+			block.push(ptr);
+			central_cache::get_instance(owner->node()).deallocate(std::move(block), owner->unit_size());
+			return;
+		}
+		allocator_reentry_guard guard;
+		front_deallocate(ptr, owner->unit_size());
+	}
+
+	void tcmalloc_deallocate_aligned(void* ptr)
+	{
+		if (ptr != nullptr && page_map::get_instance().get(ptr) == nullptr)
+		{
+			system_aligned_free(ptr);
+			return;
+		}
+		tcmalloc_deallocate(ptr);
+	}
+
+	void* tcmalloc_reallocate(void* ptr, size_t old_size, size_t new_size)
+	{
+		if (ptr == nullptr)
+		{
+			return tcmalloc_allocate(new_size);
+		}
+		if (new_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return nullptr;
+		}
+		if (new_size == 0)
+		{
+			new_size = 1;
+		}
+		page_span* owner = page_map::get_instance().get(ptr);
+		size_t copy_size = old_size < new_size ? old_size : new_size;
+		if (owner != nullptr)
+		{
+			const size_t block_size = owner->unit_size();
+			if (copy_size > block_size)
+			{
+				copy_size = block_size;
+			}
+			if (block_size > size_utils::MAX_CACHED_UNIT_SIZE)
+			{
+				//大块先尝试吞并后面的空闲页面或者 mremap，缩小时顺便把多余的页面还回去
+				if (new_size > size_utils::MAX_CACHED_UNIT_SIZE && can_use_thread_cache())
+				{
+					allocator_reentry_guard guard;
+					auto memory = page_cache::reallocate_unit(span<byte>(static_cast<byte*>(ptr), block_size), new_size);
+					if (memory)
+					{
+						//搬动了地址，旧地址上的采样记录作废
+						if (memory->data() != ptr && heap_profiler::has_samples())
+						{
+							heap_profiler::get_instance().record_deallocation(ptr);
+						}
+						return memory->data();
+					}
+				}
+			}
+			else if (new_size <= block_size && size_utils::round_up(new_size) == block_size)
+			{
+				//还在同一个级别里
+				return ptr;
+			}
+		}
+		//来自系统分配器的块、跨级别或者不能原地调整的大块，只能重新申请再复制
+		void* result = tcmalloc_allocate(new_size);
+		if (result == nullptr)
+		{
+			return nullptr;
+		}
+		std::memcpy(result, ptr, copy_size);
+		tcmalloc_deallocate(ptr);
+		return result;
+	}
+
+	size_t tcmalloc_usable_size(void* ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return 0;
+		}
+		page_span* owner = page_map::get_instance().get(ptr);
+		return owner == nullptr ? 0 : owner->unit_size();
+	}
+}
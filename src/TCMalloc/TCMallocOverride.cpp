@@ -0,0 +1,228 @@
+//用 TCMalloc 层替换全局的 operator new/delete，以及（可选的）malloc/free 系列函数
+//这是一个可选的编译单元，只有定义了下面的宏才会生效：
+//  MYSTL_TCMALLOC_OVERRIDE         替换 operator new/delete（普通、sized、aligned、nothrow 版本）
+//  MYSTL_TCMALLOC_OVERRIDE_MALLOC  额外替换 malloc/free/calloc/realloc/posix_memalign/malloc_usable_size 等（仅 glibc）
+//  MYSTL_TCMALLOC_PER_CPU          前端改用按CPU划分的缓存（Linux + rseq），拿不到CPU编号的线程仍然走 thread_cache
+//把它编成动态库后，就可以通过 LD_PRELOAD 让现有的程序跑在这个分配器上
+//编成动态库时整个 TCMalloc 层都要加上 -ftls-model=initial-exec：
+//默认的 global-dynamic 模型第一次访问 thread_local 时会通过 __tls_get_addr 调用 malloc，又回到这里，造成无限递归
+#if defined(MYSTL_TCMALLOC_OVERRIDE) || defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+
+#include <cerrno>
+#include <new>
+
+#include "../../include/TCMalloc/TCMallocAllocator.h"
+#include "../../include/TCMalloc/TCMallocutils.h"
+
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+#if !defined(__GLIBC__)
+#error "MYSTL_TCMALLOC_OVERRIDE_MALLOC requires glibc (__libc_malloc and friends)"
+#endif
+#include <dlfcn.h>
+//不归本分配器管理的块交还给 glibc 的原始实现
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+#endif
+
+//申请和释放的实现都在 TCMallocAllocator.cpp 里，和 mystl::allocator 共用，这里只做接口适配
+namespace mystl
+{
+	namespace
+	{
+		//operator new 失败时要按标准调用 new_handler，直到分配成功或者没有 handler
+		void* tc_new(size_t size)
+		{
+			while (true)
+			{
+				void* ptr = tcmalloc_allocate(size);
+				if (ptr != nullptr)
+					return ptr;
+				std::new_handler handler = std::get_new_handler();
+				if (handler == nullptr)
+					throw std::bad_alloc();
+				handler();
+			}
+		}
+
+		void* tc_aligned_new(size_t size, size_t alignment)
+		{
+			while (true)
+			{
+				void* ptr = tcmalloc_allocate_aligned(size, alignment);
+				if (ptr != nullptr)
+					return ptr;
+				std::new_handler handler = std::get_new_handler();
+				if (handler == nullptr)
+					throw std::bad_alloc();
+				handler();
+			}
+		}
+	}
+}
+
+//---------------------------- operator new / delete ----------------------------
+void* operator new(size_t size) { return mystl::tc_new(size); }
+void* operator new[](size_t size) { return mystl::tc_new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try { return mystl::tc_new(size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	try { return mystl::tc_new(size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new(size_t size, std::align_val_t alignment) { return mystl::tc_aligned_new(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return mystl::tc_aligned_new(size, static_cast<size_t>(alignment)); }
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	try { return mystl::tc_aligned_new(size, static_cast<size_t>(alignment)); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	try { return mystl::tc_aligned_new(size, static_cast<size_t>(alignment)); }
+	catch (...) { return nullptr; }
+}
+
+//sized 版本同样要先确认指针的归属，所以直接忽略大小参数
+void operator delete(void* ptr) noexcept { mystl::tcmalloc_deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { mystl::tcmalloc_deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { mystl::tcmalloc_deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { mystl::tcmalloc_deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { mystl::tcmalloc_deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { mystl::tcmalloc_deallocate(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { mystl::tcmalloc_deallocate_aligned(ptr); }
+
+//---------------------------- malloc / free ----------------------------
+#if defined(MYSTL_TCMALLOC_OVERRIDE_MALLOC)
+extern "C"
+{
+	void* malloc(size_t size) noexcept
+	{
+		void* ptr = mystl::tcmalloc_allocate(size);
+		if (ptr == nullptr)
+			errno = ENOMEM;
+		return ptr;
+	}
+
+	void free(void* ptr) noexcept
+	{
+		mystl::tcmalloc_deallocate(ptr);
+	}
+
+	void* calloc(size_t count, size_t size) noexcept
+	{
+		//count * size 溢出
+		if (size != 0 && count > static_cast<size_t>(-1) / size)
+		{
+			errno = ENOMEM;
+			return nullptr;
+		}
+		void* ptr = mystl::tcmalloc_allocate_zeroed(count * size);
+		if (ptr == nullptr)
+			errno = ENOMEM;
+		return ptr;
+	}
+
+	void* realloc(void* ptr, size_t size) noexcept
+	{
+		if (ptr == nullptr)
+			return malloc(size);
+		if (size == 0)
+		{
+			free(ptr);
+			return nullptr;
+		}
+		const size_t old_size = mystl::tcmalloc_usable_size(ptr);
+		//不是本分配器的块，原样交还给系统分配器处理
+		if (old_size == 0)
+			return __libc_realloc(ptr, size);
+		void* result = mystl::tcmalloc_reallocate(ptr, old_size, size);
+		if (result == nullptr)
+			errno = ENOMEM;
+		return result;
+	}
+
+	void* reallocarray(void* ptr, size_t count, size_t size) noexcept
+	{
+		if (size != 0 && count > static_cast<size_t>(-1) / size)
+		{
+			errno = ENOMEM;
+			return nullptr;
+		}
+		return realloc(ptr, count * size);
+	}
+
+	size_t malloc_usable_size(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+			return 0;
+		const size_t size = mystl::tcmalloc_usable_size(ptr);
+		if (size != 0)
+			return size;
+		//系统分配的块交给 glibc 自己的实现
+		using usable_size_function = size_t(*)(void*);
+		static usable_size_function next = reinterpret_cast<usable_size_function>(dlsym(RTLD_NEXT, "malloc_usable_size"));
+		return next != nullptr ? next(ptr) : 0;
+	}
+
+	int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+	{
+		//对齐值必须是 2 的幂，并且是 sizeof(void*) 的倍数
+		if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+			return EINVAL;
+		void* ptr = mystl::tcmalloc_allocate_aligned(size, alignment);
+		if (ptr == nullptr)
+			return ENOMEM;
+		*result = ptr;
+		return 0;
+	}
+
+	void* aligned_alloc(size_t alignment, size_t size) noexcept
+	{
+		if ((alignment & (alignment - 1)) != 0)
+		{
+			errno = EINVAL;
+			return nullptr;
+		}
+		void* ptr = mystl::tcmalloc_allocate_aligned(size, alignment);
+		if (ptr == nullptr)
+			errno = ENOMEM;
+		return ptr;
+	}
+
+	void* memalign(size_t alignment, size_t size) noexcept
+	{
+		return aligned_alloc(alignment, size);
+	}
+
+	void* valloc(size_t size) noexcept
+	{
+		return aligned_alloc(mystl::size_utils::PAGE_SIZE, size);
+	}
+
+	void* pvalloc(size_t size) noexcept
+	{
+		if (size > mystl::size_utils::MAX_ALLOCATION_SIZE)
+		{
+			errno = ENOMEM;
+			return nullptr;
+		}
+		return aligned_alloc(mystl::size_utils::PAGE_SIZE, mystl::size_utils::align(size, mystl::size_utils::PAGE_SIZE));
+	}
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include "../../include/TCMalloc/ThreadCache.h"
+#include "../../include/TCMalloc/CpuCache.h"
+#include "../../include/TCMalloc/TransferCache.h"
+#include "../../include/TCMalloc/CentralCache.h"
+#include "../../include/TCMalloc/PageCache.h"
+#include <iomanip>
+
+namespace mystl
+{
+	namespace
+	{
+		//交给前端的块里除去中转层和远程回收队列持有的
+		//各层不是同一时刻读取的，可能出现短暂的不一致，不能让减法回绕
+		size_t handed_out_blocks(const size_class_stats& i)
+		{
+			const size_t cached = i.transfer_cached_blocks + i.remote_free_blocks;
+			return i.central_allocated_blocks > cached ? i.central_allocated_blocks - cached : 0;
+		}
+	}
+
+	allocator_stats get_allocator_stats()
+	{
+		allocator_stats stats;
+		thread_cache::collect_stats(stats);
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+		//没有用到按CPU的缓存时不去创建它
+		if (cpu_cache::is_available())
+		{
+			cpu_cache::get_instance().collect_stats(stats);
+		}
+#endif
+		stats.numa_node_count = numa_topology::node_count();
+		for (size_t node = 0; node < stats.numa_node_count; ++node)
+		{
+			transfer_cache::get_instance(node).collect_stats(stats);
+			central_cache::get_instance(node).collect_stats(stats);
+			page_cache::get_instance(node).collect_stats(stats);
+		}
+
+		//交给前端的块里，除去各级缓存持有的，剩下的就在用户手里
+		size_t handed_out_bytes = 0;
+		for (const auto& i : stats.classes)
+		{
+			handed_out_bytes += handed_out_blocks(i) * i.unit_size;
+		}
+		const size_t front_cached_bytes = stats.thread_cached_bytes + stats.cpu_cached_bytes;
+		//各层不是同一时刻读取的，可能出现短暂的不一致
+		stats.allocated_bytes = (handed_out_bytes > front_cached_bytes ? handed_out_bytes - front_cached_bytes : 0) + stats.large_allocated_bytes;
+		return stats;
+	}
+
+	void print_allocator_stats(std::ostream& os)
+	{
+		print_allocator_stats(os, get_allocator_stats());
+	}
+
+	void print_allocator_stats(std::ostream& os, const allocator_stats& stats)
+	{
+		auto mb = [](size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+		auto line = [&](const char* prefix, size_t bytes, const char* name) {
+			os << "MALLOC: " << prefix << std::setw(14) << bytes << " (" << std::setw(9) << std::fixed << std::setprecision(1) << mb(bytes) << " MiB) " << name << '\n';
+		};
+		os << "------------------------------------------------\n";
+		line("  ", stats.allocated_bytes, "Bytes in use by application");
+		line("+ ", stats.thread_cached_bytes, "Bytes in thread cache freelists");
+		line("+ ", stats.cpu_cached_bytes, "Bytes in cpu cache freelists");
+		line("+ ", stats.transfer_cached_bytes, "Bytes in transfer cache freelists");
+		line("+ ", stats.remote_free_bytes, "Bytes in remote free queues");
+		line("+ ", stats.central_free_bytes, "Bytes in central cache freelists");
+		line("+ ", stats.fragmented_bytes, "Bytes in span tails (fragmentation)");
+		line("+ ", stats.page_free_bytes - stats.page_released_bytes - stats.page_untouched_bytes, "Bytes in page cache freelist");
+		line("+ ", stats.page_released_bytes, "Bytes released to OS (aka unmapped)");
+		line("+ ", stats.page_untouched_bytes, "Bytes mapped but never touched");
+		line("+ ", stats.page_metadata_bytes, "Bytes of free pages used as page cache metadata");
+		os << "------------------------------------------------\n";
+		line("  ", stats.mapped_bytes, "Virtual address space mapped");
+		line("  ", stats.central_span_bytes, "Bytes in central cache spans");
+		line("  ", stats.large_allocated_bytes, "Bytes in large spans");
+		os << "MALLOC:   " << std::setw(14) << stats.large_allocated_count << "               Large spans in use\n";
+		os << "MALLOC:   " << std::setw(14) << stats.thread_cache_count << "               Thread caches in use\n";
+		os << "MALLOC:   " << std::setw(14) << stats.numa_node_count << "               NUMA nodes\n";
+		os << "------------------------------------------------\n";
+		os << "class   size   spans      handed_out  central_free  transfer  refills  transfer_hits  flushes          allocs           frees\n";
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
+		{
+			const size_class_stats& i = stats.classes[index];
+			if (i.span_count == 0 && i.refill_count == 0 && i.flush_count == 0 && i.alloc_count == 0)
+			{
+				continue;
+			}
+			os << std::setw(5) << index << std::setw(7) << i.unit_size << std::setw(8) << i.span_count
+				<< std::setw(16) << handed_out_blocks(i) << std::setw(14) << i.central_free_blocks
+				<< std::setw(10) << i.transfer_cached_blocks << std::setw(9) << i.refill_count
+				<< std::setw(15) << i.transfer_hit_count << std::setw(9) << i.flush_count
+				<< std::setw(16) << i.alloc_count << std::setw(16) << i.free_count << '\n';
+		}
+	}
+}
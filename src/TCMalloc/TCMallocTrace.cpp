@@ -0,0 +1,82 @@
+#include "../../include/TCMalloc/TCMallocTrace.h"
+#include <chrono>
+#include <iomanip>
+
+namespace mystl
+{
+	void trace_buffer::record(trace_event_type type, const void* address, size_t size)
+	{
+		const uint64_t sequence = m_next.fetch_add(1, std::memory_order_relaxed) + 1;
+		slot& s = m_slots[(sequence - 1) & (CAPACITY - 1)];
+		const uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+		//先标记为正在写入，读者看到 0 或者前后序号不一致就丢弃这一条
+		s.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		s.timestamp.store(timestamp, std::memory_order_relaxed);
+		s.type.store(static_cast<uint32_t>(type), std::memory_order_relaxed);
+		s.address.store(address, std::memory_order_relaxed);
+		s.size.store(size, std::memory_order_relaxed);
+		s.sequence.store(sequence, std::memory_order_release);
+	}
+
+	size_t trace_buffer::snapshot(trace_event* events, size_t max_count) const
+	{
+		const uint64_t end = m_next.load(std::memory_order_acquire);
+		const uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+		size_t count = 0;
+		for (uint64_t sequence = begin + 1; sequence <= end && count < max_count; ++sequence)
+		{
+			const slot& s = m_slots[(sequence - 1) & (CAPACITY - 1)];
+			if (s.sequence.load(std::memory_order_acquire) != sequence)
+			{
+				//还没有写完，或者已经被更新的记录覆盖
+				continue;
+			}
+			trace_event event;
+			event.sequence = sequence;
+			event.timestamp = s.timestamp.load(std::memory_order_relaxed);
+			event.type = static_cast<trace_event_type>(s.type.load(std::memory_order_relaxed));
+			event.address = s.address.load(std::memory_order_relaxed);
+			event.size = s.size.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s.sequence.load(std::memory_order_relaxed) != sequence)
+			{
+				continue;
+			}
+			events[count++] = event;
+		}
+		return count;
+	}
+
+	void trace_buffer::dump(std::ostream& os) const
+	{
+		//放在静态区，避免在栈上放几十KB，也不通过分配器申请内存
+		static trace_event events[CAPACITY];
+		const size_t count = snapshot(events, CAPACITY);
+		os << "sequence      timestamp(ns)  event               address             size\n";
+		for (size_t i = 0; i < count; ++i)
+		{
+			const trace_event& event = events[i];
+			os << std::setw(8) << event.sequence << std::setw(19) << event.timestamp << "  "
+				<< std::left << std::setw(20) << get_type_name(event.type) << std::right
+				<< std::setw(18) << event.address << std::setw(10) << event.size << '\n';
+		}
+	}
+
+	const char* trace_buffer::get_type_name(trace_event_type type)
+	{
+		switch (type)
+		{
+		case trace_event_type::page_grow: return "page_grow";
+		case trace_event_type::page_release: return "page_release";
+		case trace_event_type::page_coalesce: return "page_coalesce";
+		case trace_event_type::span_allocate: return "span_allocate";
+		case trace_event_type::span_deallocate: return "span_deallocate";
+		case trace_event_type::large_map: return "large_map";
+		case trace_event_type::large_unmap: return "large_unmap";
+		case trace_event_type::allocation_failure: return "allocation_failure";
+		}
+		return "unknown";
+	}
+}
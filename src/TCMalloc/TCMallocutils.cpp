@@ -5,12 +5,13 @@ namespace mystl
 {
 	void page_span::allocate(mystl::span<mystl::byte> memory)
 	{
-		//жռǲǱ
+		//判断这个空间是不是被管理的
 		assert(is_valid_unit_span(memory));
 		uint64_t address_offset = memory.data() - m_memory.data();
 		uint64_t index = address_offset / m_unit_size;
 		assert(m_allocated_map[index] == 0);
 		m_allocated_map[index] = true;
+		++m_allocated_count;
 	}
 
 	void page_span::deallocate(mystl::span<mystl::byte> memory)
@@ -20,22 +21,46 @@ namespace mystl
 		uint64_t index = address_offset / m_unit_size;
 		assert(m_allocated_map[index] == 1);
 		m_allocated_map[index] = false;
+		--m_allocated_count;
+	}
+
+	void* page_span::pop_free()
+	{
+		void* block = nullptr;
+		if (!m_free_blocks.empty())
+		{
+			block = m_free_blocks.pop();
+		}
+		else
+		{
+			assert(m_carved_count < unit_count());
+			block = m_memory.data() + m_carved_count * m_unit_size;
+			++m_carved_count;
+		}
+		allocate(mystl::span<mystl::byte>(static_cast<mystl::byte*>(block), m_unit_size));
+		return block;
+	}
+
+	void page_span::push_free(void* block)
+	{
+		deallocate(mystl::span<mystl::byte>(static_cast<mystl::byte*>(block), m_unit_size));
+		m_free_blocks.push(block);
 	}
 
 	bool page_span::is_valid_unit_span(mystl::span<mystl::byte> memory)
 	{
-		//黹ĿռСҳĴСһ
+		//归还的空间大小与这个页面管理的大小不一样
 		if (memory.size() != m_unit_size)
 			return false;
-		//ʼַС˹ĵַ
+		//起始地址小于了管理的地址
 		if (memory.data() < m_memory.data())
 			return false;
-		//ַƫ
+		//计算地址偏移量
 		uint64_t address_offset = memory.data() - m_memory.data();
-		//ڴû
+		//内存没对齐
 		if (address_offset % m_unit_size != 0)
 			return false;
-		//ԱȽĵַǲСڻڹĽַ
+		//对比结束的地址是不是小于或等于管理区域的结束地址
 		return address_offset + m_unit_size <= m_memory.size();
 	}
 }
\ No newline at end of file
@@ -1,52 +1,326 @@
 #include "../../include/TCMalloc/ThreadCache.h"
 #include"../../include/TCMalloc/CentralCache.h"
+#include "../../include/TCMalloc/TransferCache.h"
+#include "../../include/TCMalloc/CpuCache.h"
 #include "../../include/TCMalloc/TCMallocutils.h"
 #include "../../include/TCMalloc/TCMallocBootstrap.h"
-#include "../../include/list.h"
-#include "../../include/set.h"
-#include "../../include/unordered_map.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/PageCache.h"
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include "../../include/TCMalloc/HeapProfiler.h"
+#include "../../include/TCMalloc/TCMallocAllocator.h"
 #include <assert.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 namespace mystl
 {
 	class ThreadCacheImpl
 	{
 	public:
-		// ԭе˽ݳԱƵ
-		list<span<byte>> m_free_cache[size_utils::CACHE_LINE_SIZE];
-		size_t m_next_allocate_count[size_utils::CACHE_LINE_SIZE];
+		// 将原有的私有数据成员移到这里
+		free_list m_free_cache[size_utils::SIZE_CLASS_COUNT];
+		size_t m_next_allocate_count[size_utils::SIZE_CLASS_COUNT];
+		// 上一次回收以来每个链表的最短长度，这么多块在这段时间里一直没有被用到
+		size_t m_low_water[size_utils::SIZE_CLASS_COUNT];
+		// 当前缓存的字节数，只有所属线程会修改，统计时其它线程会读取
+		std::atomic<size_t> m_size{ 0 };
+		// 本线程允许缓存的字节数，其它线程窃取时会修改它
+		std::atomic<size_t> m_max_size{ 0 };
+		// 其它线程请求清空本线程的缓存
+		std::atomic<bool> m_flush_requested{ false };
+		std::thread::id m_thread_id;
+		// 距离下一次采样还要分配的字节数，初始为0，第一次分配时按采样率生成
+		size_t m_bytes_until_sample = 0;
+		uint64_t m_sample_rng = 0;
+		// 每一级累计交给用户和从用户收回的块数，只有所属线程会修改，统计时其它线程会读取
+		std::atomic<size_t> m_alloc_count[size_utils::SIZE_CLASS_COUNT] = {};
+		std::atomic<size_t> m_free_count[size_utils::SIZE_CLASS_COUNT] = {};
+		// 所有线程缓存串成一个双向链表
+		ThreadCacheImpl* m_prev = nullptr;
+		ThreadCacheImpl* m_next = nullptr;
+
+		// 只有一个写者，不需要原子的读-改-写，无符号数的回绕正好可以表示减法
+		void add_size(size_t bytes)
+		{
+			m_size.store(m_size.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+		}
+
+		// 同样只有一个写者
+		static void increase(std::atomic<size_t>& counter)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
 	};
 
+	namespace
+	{
+		// 保护下面所有的全局状态
+		std::mutex g_thread_cache_mutex;
+		ThreadCacheImpl* g_thread_cache_list = nullptr;
+		// 下一个被窃取的线程，轮流选择
+		ThreadCacheImpl* g_next_victim = nullptr;
+		// 全局预算中还没有分给任何线程的部分，可能为负（每个线程至少要有最小额度）
+		std::ptrdiff_t g_unclaimed_cache_bytes = static_cast<std::ptrdiff_t>(thread_cache::DEFAULT_TOTAL_CACHE_BYTES);
+		size_t g_total_cache_bytes = thread_cache::DEFAULT_TOTAL_CACHE_BYTES;
+		// 已经退出的线程累计的每一级申请、归还块数
+		size_t g_retired_alloc_count[size_utils::SIZE_CLASS_COUNT] = {};
+		size_t g_retired_free_count[size_utils::SIZE_CLASS_COUNT] = {};
+	}
+
 	thread_cache::thread_cache() : pimpl(nullptr)
 	{
-		g_is_allocator_constructing = true;
-		// ʼ
+		allocator_reentry_guard guard;
+		// 初始化数组
 		pimpl = new ThreadCacheImpl();
 
-		for (size_t i = 0; i < size_utils::CACHE_LINE_SIZE; ++i)
+		for (size_t i = 0; i < size_utils::SIZE_CLASS_COUNT; ++i)
 		{
 			pimpl->m_next_allocate_count[i] = 1;
+			pimpl->m_low_water[i] = 0;
 		}
 
-		g_is_allocator_constructing = false;
+		pimpl->m_thread_id = std::this_thread::get_id();
+
+		// 从全局预算中领取最小额度并登记
+		std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+		pimpl->m_max_size.store(MIN_CACHE_BYTES_PER_THREAD, std::memory_order_relaxed);
+		g_unclaimed_cache_bytes -= static_cast<std::ptrdiff_t>(MIN_CACHE_BYTES_PER_THREAD);
+		pimpl->m_next = g_thread_cache_list;
+		if (g_thread_cache_list != nullptr)
+			g_thread_cache_list->m_prev = pimpl;
+		g_thread_cache_list = pimpl;
 	}
 
 	thread_cache::~thread_cache()
 	{
+		allocator_reentry_guard guard;
+		// 线程退出时把缓存的内存块全部还回去，否则这些内存就再也用不上了
+		flush();
+		{
+			// 注销，并把额度还给全局预算
+			std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+			g_unclaimed_cache_bytes += static_cast<std::ptrdiff_t>(pimpl->m_max_size.load(std::memory_order_relaxed));
+			for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index) {
+				g_retired_alloc_count[index] += pimpl->m_alloc_count[index].load(std::memory_order_relaxed);
+				g_retired_free_count[index] += pimpl->m_free_count[index].load(std::memory_order_relaxed);
+			}
+			if (pimpl->m_prev != nullptr)
+				pimpl->m_prev->m_next = pimpl->m_next;
+			else
+				g_thread_cache_list = pimpl->m_next;
+			if (pimpl->m_next != nullptr)
+				pimpl->m_next->m_prev = pimpl->m_prev;
+			if (g_next_victim == pimpl)
+				g_next_victim = pimpl->m_next;
+		}
 		delete pimpl;
+		pimpl = nullptr;
+		g_thread_cache_destroyed = true;
+	}
+
+	void thread_cache::flush()
+	{
+		pimpl->m_flush_requested.store(false, std::memory_order_relaxed);
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index) {
+			free_list& list = pimpl->m_free_cache[index];
+			if (!list.empty()) {
+				transfer_cache::get_instance().deallocate(std::move(list), size_utils::get_class_size(index));
+			}
+			pimpl->m_low_water[index] = 0;
+		}
+		pimpl->m_size.store(0, std::memory_order_relaxed);
+	}
+
+	bool thread_cache::request_flush(std::thread::id thread_id)
+	{
+		std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+		for (ThreadCacheImpl* i = g_thread_cache_list; i != nullptr; i = i->m_next) {
+			if (i->m_thread_id == thread_id) {
+				i->m_flush_requested.store(true, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void thread_cache::request_flush_all()
+	{
+		{
+			std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+			for (ThreadCacheImpl* i = g_thread_cache_list; i != nullptr; i = i->m_next) {
+				i->m_flush_requested.store(true, std::memory_order_relaxed);
+			}
+		}
+		get_instance().flush();
+#if defined(MYSTL_TCMALLOC_PER_CPU)
+		//按CPU的缓存不属于任何线程，不会响应清空请求，直接清空
+		if (cpu_cache::is_available()) {
+			cpu_cache::get_instance().drain();
+		}
+#endif
+		//中转层里的整批块也一起还给中心缓存，否则每个节点每一级最多还会留着 1MB
+		for (size_t node = 0; node < numa_topology::node_count(); ++node) {
+			transfer_cache::get_instance(node).drain();
+		}
+	}
+
+	void thread_cache::collect_stats(allocator_stats& stats)
+	{
+		std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index) {
+			stats.classes[index].alloc_count += g_retired_alloc_count[index];
+			stats.classes[index].free_count += g_retired_free_count[index];
+		}
+		for (ThreadCacheImpl* i = g_thread_cache_list; i != nullptr; i = i->m_next) {
+			stats.thread_cached_bytes += i->m_size.load(std::memory_order_relaxed);
+			++stats.thread_cache_count;
+			for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index) {
+				stats.classes[index].alloc_count += i->m_alloc_count[index].load(std::memory_order_relaxed);
+				stats.classes[index].free_count += i->m_free_count[index].load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void thread_cache::set_total_cache_budget(size_t total_bytes)
+	{
+		std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+		g_unclaimed_cache_bytes += static_cast<std::ptrdiff_t>(total_bytes) - static_cast<std::ptrdiff_t>(g_total_cache_bytes);
+		g_total_cache_bytes = total_bytes;
+	}
+
+	size_t thread_cache::get_total_cache_budget()
+	{
+		std::lock_guard<std::mutex> lock(g_thread_cache_mutex);
+		return g_total_cache_bytes;
 	}
 
 	std::optional<void*> thread_cache::allocate(size_t memory_size)
 	{
-		if (memory_size == 0)
+		//太大的申请在对齐之前就拒绝，否则对齐时会回绕成一个很小的块
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
 		{
 			return std::nullopt;
 		}
 
-		//뵽8ֽ
+		// 没到采样点时只有一次比较和一次减法
+		if (pimpl->m_bytes_until_sample < memory_size)
+		{
+			return allocate_sampled(memory_size);
+		}
+		pimpl->m_bytes_until_sample -= memory_size;
+		return allocate_unsampled(memory_size);
+	}
+
+	std::optional<void*> thread_cache::allocate_aligned(size_t memory_size, size_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+		if (alignment <= size_utils::ALIGNMENT)
+		{
+			return allocate(memory_size);
+		}
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		if (alignment <= size_utils::PAGE_SIZE && memory_size <= size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			const size_t index = size_utils::get_aligned_index(memory_size, alignment);
+			if (index < size_utils::SIZE_CLASS_COUNT)
+			{
+				return allocate(size_utils::get_class_size(index));
+			}
+		}
+		auto result = page_cache::allocate_unit_aligned(memory_size, alignment);
+		if (result) {
+			sample_large_allocation(result->data(), memory_size, result->size());
+			return std::optional<void*>(result->data());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<void*> thread_cache::allocate_zeroed(size_t memory_size)
+	{
+		if (memory_size == 0 || memory_size > size_utils::MAX_ALLOCATION_SIZE)
+		{
+			return std::nullopt;
+		}
+		//小块都被用过，要清零
+		if (memory_size <= size_utils::MAX_CACHED_UNIT_SIZE)
+		{
+			auto result = allocate(memory_size);
+			if (result)
+			{
+				std::memset(*result, 0, memory_size);
+			}
+			return result;
+		}
+		bool zeroed = false;
+		auto memory = page_cache::allocate_unit(memory_size, &zeroed);
+		if (!memory)
+		{
+			return std::nullopt;
+		}
+		if (!zeroed)
+		{
+			std::memset(memory->data(), 0, memory_size);
+		}
+		sample_large_allocation(memory->data(), memory_size, memory->size());
+		return std::optional<void*>(memory->data());
+	}
+
+	std::optional<void*> thread_cache::reallocate(void* start_p, size_t old_size, size_t new_size)
+	{
+		//和 realloc、mystl::allocator 共用同一份实现，开启按CPU的缓存时也走同样的前端
+		void* result = tcmalloc_reallocate(start_p, old_size, new_size);
+		if (result == nullptr)
+		{
+			return std::nullopt;
+		}
+		return result;
+	}
+
+	std::optional<void*> thread_cache::allocate_sampled(size_t memory_size)
+	{
+		const bool sampling = heap_profiler::get_sample_rate() != 0;
+		pimpl->m_bytes_until_sample = heap_profiler::next_sample_interval(pimpl->m_sample_rng);
+		auto result = allocate_unsampled(memory_size);
+		if (result && sampling)
+		{
+			const size_t aligned_size = size_utils::align(memory_size);
+			const size_t allocated_size = aligned_size > size_utils::MAX_CACHED_UNIT_SIZE
+				? size_utils::align(aligned_size, size_utils::PAGE_SIZE)
+				: size_utils::round_up(aligned_size);
+			heap_profiler::get_instance().record_allocation(*result, memory_size, allocated_size);
+		}
+		return result;
+	}
+
+	void thread_cache::sample_large_allocation(void* address, size_t requested_size, size_t allocated_size)
+	{
+		// 和 allocate 一样消耗距离下一次采样的字节数
+		if (pimpl->m_bytes_until_sample >= requested_size)
+		{
+			pimpl->m_bytes_until_sample -= requested_size;
+			return;
+		}
+		const bool sampling = heap_profiler::get_sample_rate() != 0;
+		pimpl->m_bytes_until_sample = heap_profiler::next_sample_interval(pimpl->m_sample_rng);
+		if (sampling)
+		{
+			heap_profiler::get_instance().record_allocation(address, requested_size, allocated_size);
+		}
+	}
+
+	std::optional<void*> thread_cache::allocate_unsampled(size_t memory_size)
+	{
+
+		//对齐到8字节
 		memory_size = size_utils::align(memory_size);
 
+		// 大块直接向页面缓存申请整段页面，不经过中心缓存
 		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE) {
-			auto result = allocate_from_central_cache(memory_size);
+			auto result = page_cache::allocate_unit(memory_size);
 			if (result) {
 				return std::optional<void*>(result->data());
 			}
@@ -55,16 +329,27 @@ namespace mystl
 			}
 		}
 
+		if (pimpl->m_flush_requested.load(std::memory_order_relaxed)) {
+			flush();
+		}
+
 		const size_t index = size_utils::get_index(memory_size);
-		if (!pimpl->m_free_cache[index].empty())
+		//向上取整到所在级别的块大小
+		memory_size = size_utils::get_class_size(index);
+		free_list& list = pimpl->m_free_cache[index];
+		if (!list.empty())
 		{
-			auto result = pimpl->m_free_cache[index].front();
-			pimpl->m_free_cache[index].pop_front();
-			assert(result.size() == memory_size);
-			return result.data();
+			pimpl->add_size(0 - memory_size);
+			ThreadCacheImpl::increase(pimpl->m_alloc_count[index]);
+			void* result = list.pop();
+			if (list.size() < pimpl->m_low_water[index])
+				pimpl->m_low_water[index] = list.size();
+			return result;
 		}
+		pimpl->m_low_water[index] = 0;
 		auto result = allocate_from_central_cache(memory_size);
 		if (result) {
+			ThreadCacheImpl::increase(pimpl->m_alloc_count[index]);
 			return std::optional<void*>(result->data());
 		}
 		else {
@@ -77,48 +362,60 @@ namespace mystl
 		if (memory_size == 0) {
 			return;
 		}
+		// 没有存活的采样记录时只有一次读取和一次比较
+		if (heap_profiler::has_samples()) {
+			heap_profiler::get_instance().record_deallocation(start_p);
+		}
 		memory_size = size_utils::align(memory_size);
-		span<byte> memory(static_cast<byte*>(start_p), memory_size);
-		// 󻺴ֵˣ˵ֱӴĻģֱӷĻ
+		// 如果大于了最大缓存值了，说明是直接从页面缓存申请的，可以直接返还给页面缓存
 		if (memory_size > size_utils::MAX_CACHED_UNIT_SIZE) {
-			list<span<byte>> free_list;
-			free_list.push_back(memory);
-			central_cache::get_instance().deallocate(std::move(free_list));
+			page_cache::deallocate_unit(span<byte>(static_cast<byte*>(start_p), memory_size));
 			return;
 		}
 		const size_t index = size_utils::get_index(memory_size);
-		pimpl->m_free_cache[index].push_front(memory);
+		memory_size = size_utils::get_class_size(index);
+		pimpl->m_free_cache[index].push(start_p);
+		pimpl->add_size(memory_size);
+		ThreadCacheImpl::increase(pimpl->m_free_count[index]);
+
+		if (pimpl->m_flush_requested.load(std::memory_order_relaxed)) {
+			flush();
+			return;
+		}
+
+		// 不再按单个链表判断，而是看整个线程缓存有没有超过自己的额度
+		if (pimpl->m_size.load(std::memory_order_relaxed) > pimpl->m_max_size.load(std::memory_order_relaxed)) {
+			scavenge();
+		}
+	}
 
-		// һ費Ҫ
-		// ǰбάĴСѾֵ򴥷Դ
-		// άĴС =   ռĴС
-		if (pimpl->m_free_cache[index].size() * memory_size > MAX_FREE_BYTES_PER_LISTS) {
-			// ˣһĶڴ
-			size_t deallocate_block_size = pimpl->m_free_cache[index].size() / 2;
-			list<span<byte>> memory_to_deallocate;
-			auto middle = pimpl->m_free_cache[index].begin();
-			advance(middle, deallocate_block_size);
-			memory_to_deallocate.splice(memory_to_deallocate.begin(), pimpl->m_free_cache[index], middle, pimpl->m_free_cache[index].end());
-			central_cache::get_instance().deallocate(std::move(memory_to_deallocate));
-			// ڻչԺ󣬻ҪռСĸ
-			// һĸ
-			pimpl->m_next_allocate_count[index] /= 2;
+	void thread_cache::deallocate(void* start_p)
+	{
+		if (start_p == nullptr) {
+			return;
 		}
+		// 小块落在 central_cache 登记过的 page_span 里，大块由 page_cache 登记，块大小就是 span 的单元大小
+		page_span* owner = page_map::get_instance().get(start_p);
+		assert(owner != nullptr);
+		deallocate(start_p, owner->unit_size());
 	}
 
 	std::optional<span<byte>> thread_cache::allocate_from_central_cache(size_t memory_size) {
 		size_t block_count = compute_allocate_count(memory_size);
-		auto allocation_result = central_cache::get_instance().allocate(memory_size, block_count);
+		// 先从中转层拿一整批别的线程还回来的内存块，拿不到再找中心缓存
+		auto allocation_result = transfer_cache::get_instance().allocate(memory_size, block_count);
 		if (allocation_result)
 		{
-			auto memory_list = move(allocation_result.value());
+			free_list memory_list = move(allocation_result.value());
 
-			span<byte> result = memory_list.front();
-			assert(result.size() == memory_size);
-			memory_list.pop_front();
-			const size_t index = size_utils::get_index(memory_size);
-
-			pimpl->m_free_cache[index].splice(pimpl->m_free_cache[index].end(), memory_list);
+			span<byte> result(static_cast<byte*>(memory_list.pop()), memory_size);
+			// 多申请的块直接整串接入本地链表（大块只有一个，不会进入这里）
+			if (!memory_list.empty())
+			{
+				const size_t index = size_utils::get_index(memory_size);
+				pimpl->add_size(memory_list.size() * memory_size);
+				pimpl->m_free_cache[index].splice(memory_list);
+			}
 
 			return result;
 		}
@@ -128,29 +425,94 @@ namespace mystl
 		}
 	}
 
+	void thread_cache::scavenge()
+	{
+		// 每个链表回收上一次回收以来一直没用到的那部分的一半
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index) {
+			free_list& list = pimpl->m_free_cache[index];
+			const size_t low_water = pimpl->m_low_water[index];
+			if (low_water > 0) {
+				const size_t memory_size = size_utils::get_class_size(index);
+				const size_t deallocate_block_size = low_water > 1 ? low_water / 2 : 1;
+				free_list memory_to_deallocate = list.pop_range(deallocate_block_size);
+				pimpl->add_size(0 - deallocate_block_size * memory_size);
+				transfer_cache::get_instance().deallocate(std::move(memory_to_deallocate), memory_size);
+				// 这一级用得少，减半下一次申请的个数
+				pimpl->m_next_allocate_count[index] = std::max(pimpl->m_next_allocate_count[index] / 2, static_cast<size_t>(1));
+			}
+			pimpl->m_low_water[index] = list.size();
+		}
+		// 频繁触发回收说明这个线程很忙，尝试扩大它的额度
+		increase_cache_limit();
+	}
+
+	void thread_cache::increase_cache_limit()
+	{
+		// 这里在归还内存的路径上，已经到上限的线程不去碰全局锁
+		if (pimpl->m_max_size.load(std::memory_order_relaxed) >= MAX_CACHE_BYTES_PER_THREAD) {
+			return;
+		}
+		// 锁被别的线程占着时这次就不扩大了，下一次回收时再试，不让忙线程在归还内存时排队
+		std::unique_lock<std::mutex> lock(g_thread_cache_mutex, std::try_to_lock);
+		if (!lock.owns_lock()) {
+			return;
+		}
+		// 其它线程窃取额度时会修改它，加锁以后重新读取
+		const size_t max_size = pimpl->m_max_size.load(std::memory_order_relaxed);
+		if (max_size >= MAX_CACHE_BYTES_PER_THREAD) {
+			return;
+		}
+		// 全局预算还有剩余，直接领取
+		if (g_unclaimed_cache_bytes > 0) {
+			const size_t claimed = std::min(static_cast<size_t>(g_unclaimed_cache_bytes), STEAL_BYTES);
+			g_unclaimed_cache_bytes -= static_cast<std::ptrdiff_t>(claimed);
+			pimpl->m_max_size.store(max_size + claimed, std::memory_order_relaxed);
+			return;
+		}
+		// 否则轮流从其它线程那里窃取额度，被窃取的线程在下一次归还时自己回收多出来的部分
+		ThreadCacheImpl* victim = g_next_victim;
+		for (ThreadCacheImpl* i = g_thread_cache_list; i != nullptr; i = i->m_next) {
+			if (victim == nullptr)
+				victim = g_thread_cache_list;
+			ThreadCacheImpl* next_victim = victim->m_next;
+			if (victim != pimpl) {
+				const size_t victim_size = victim->m_max_size.load(std::memory_order_relaxed);
+				if (victim_size >= MIN_CACHE_BYTES_PER_THREAD + STEAL_BYTES) {
+					victim->m_max_size.store(victim_size - STEAL_BYTES, std::memory_order_relaxed);
+					pimpl->m_max_size.store(max_size + STEAL_BYTES, std::memory_order_relaxed);
+					g_next_victim = next_victim;
+					return;
+				}
+			}
+			victim = next_victim;
+		}
+		g_next_victim = victim;
+	}
+
 	size_t thread_cache::compute_allocate_count(size_t memory_size) {
-		// ȡ±
+		// 获取其下标
 		size_t index = size_utils::get_index(memory_size);
 
-		if (index >= size_utils::CACHE_LINE_SIZE) {
+		if (index >= size_utils::SIZE_CLASS_COUNT) {
 			return 1;
 		}
 
-		// 4
-		size_t result = std::max(pimpl->m_next_allocate_count[index], static_cast<size_t>(4));
+		// 最少申请4个块，但不超过这一级一次搬运的上限
+		const size_t batch_count = size_utils::get_batch_count(index);
+		size_t result = std::min(std::max(pimpl->m_next_allocate_count[index], static_cast<size_t>(4)), batch_count);
 
 
-		// һҪĸĬϳ2
+		// 计算下一次要申请的个数，默认乘2
 		size_t next_allocate_count = result * 2;
-		// Ҫȷᳬcenter_cacheһ
-		next_allocate_count = std::min(next_allocate_count, page_span::MAX_UNIT_COUNT);
-		// ͬʱҲҪȷᳬһбά
-		// 16KBڴ飬һ128
-		// 256 * 1024 B / 16 * 1024 B / 2 = 8ͽ16KBڴһ8Ҫ(2)Ȼܻᷴ룩
+		// 要确保不会超过center_cache一次申请的最大个数
+		next_allocate_count = std::min(next_allocate_count, batch_count);
+		// 同时也要确保不会超过一个列表维护的最大容量
+		// 比如16KB的内存块，不能一次性申请128个吧
+		// 256 * 1024 B / 16 * 1024 B / 2 = 8个（这里就将16KB的内存一次性最多申请8个，要给点冗余(除2)，不然可能会反复申请）
 		next_allocate_count = std::min(next_allocate_count, MAX_FREE_BYTES_PER_LISTS / memory_size / 2);
-		// һҪĸ
+		// 更新下一次要申请的个数
 		pimpl->m_next_allocate_count[index] = next_allocate_count;
-		// һĸ
+		// 返回这一次申请的个数
 		return result;
 	}
 }
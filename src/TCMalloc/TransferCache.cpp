@@ -0,0 +1,241 @@
+#include "../../include/TCMalloc/TransferCache.h"
+#include "../../include/TCMalloc/CentralCache.h"
+#include "../../include/TCMalloc/PageMap.h"
+#include "../../include/TCMalloc/TCMallocBootstrap.h"
+#include "../../include/TCMalloc/TCMallocStats.h"
+#include <atomic>
+#include <thread>
+
+namespace mystl
+{
+	class TransferCacheImpl
+	{
+	public:
+		//每一级单独占一条缓存行，避免不同级别之间的伪共享
+		struct alignas(64) class_slot
+		{
+			free_list batches[transfer_cache::MAX_BATCHES_PER_CLASS];
+			size_t used = 0;
+			//上一次衰减以来 used 的最小值，这么多批一直没有被取走过
+			size_t low_water = 0;
+			std::atomic_flag status = ATOMIC_FLAG_INIT;
+			//统计用的计数器
+			std::atomic<size_t> refill_count{ 0 };
+			std::atomic<size_t> transfer_hit_count{ 0 };
+			std::atomic<size_t> flush_count{ 0 };
+		};
+		class_slot m_slots[size_utils::SIZE_CLASS_COUNT];
+	};
+
+	namespace
+	{
+		//自旋锁，临界区里只有一次链表头的交换
+		class slot_lock
+		{
+		public:
+			explicit slot_lock(std::atomic_flag& flag) :m_flag(flag)
+			{
+				while (m_flag.test_and_set(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+			}
+			~slot_lock()
+			{
+				m_flag.clear(std::memory_order_release);
+			}
+			slot_lock(const slot_lock&) = delete;
+			slot_lock& operator=(const slot_lock&) = delete;
+		private:
+			std::atomic_flag& m_flag;
+		};
+	}
+
+	transfer_cache::transfer_cache(size_t node) :pimpl(nullptr), m_node(node)
+	{
+		//机器上不存在的节点不会被用到，不创建内部数据
+		if (node >= numa_topology::node_count())
+		{
+			return;
+		}
+		allocator_reentry_guard guard;
+		pimpl = new TransferCacheImpl();
+	}
+
+	transfer_cache::~transfer_cache()
+	{
+#if !defined(MYSTL_TCMALLOC_IMMORTAL)
+		delete pimpl;
+#endif
+	}
+
+	size_t transfer_cache::get_capacity(size_t index)
+	{
+		const size_t batch_bytes = size_utils::get_batch_count(index) * size_utils::get_class_size(index);
+		return detail::clamp_size(MAX_BYTES_PER_CLASS / batch_bytes, 2, MAX_BATCHES_PER_CLASS);
+	}
+
+	bool transfer_cache::insert(size_t index, free_list& batch)
+	{
+		assert(index < size_utils::SIZE_CLASS_COUNT);
+		assert(batch.size() == size_utils::get_batch_count(index));
+		const size_t capacity = get_capacity(index);
+		auto& slot = pimpl->m_slots[index];
+		slot_lock lock(slot.status);
+		if (slot.used >= capacity)
+		{
+			return false;
+		}
+		slot.batches[slot.used++] = std::move(batch);
+		return true;
+	}
+
+	std::optional<free_list> transfer_cache::remove(size_t index, size_t block_count)
+	{
+		assert(index < size_utils::SIZE_CLASS_COUNT);
+		assert(block_count > 0);
+		auto& slot = pimpl->m_slots[index];
+		slot_lock lock(slot.status);
+		if (slot.used == 0)
+		{
+			return std::nullopt;
+		}
+		free_list& top = slot.batches[slot.used - 1];
+		//前端缓存慢启动时只要一部分，从最上面那批里切出来，剩下的留在原位
+		if (top.size() > block_count)
+		{
+			return top.pop_range(block_count);
+		}
+		--slot.used;
+		if (slot.used < slot.low_water)
+		{
+			slot.low_water = slot.used;
+		}
+		return std::move(top);
+	}
+
+	std::optional<free_list> transfer_cache::allocate(size_t memory_size, size_t block_count)
+	{
+		const size_t index = size_utils::get_index(memory_size);
+		pimpl->m_slots[index].refill_count.fetch_add(1, std::memory_order_relaxed);
+		std::optional<free_list> result = remove(index, block_count);
+		if (result)
+		{
+			pimpl->m_slots[index].transfer_hit_count.fetch_add(1, std::memory_order_relaxed);
+			return result;
+		}
+		return central_cache::get_instance(m_node).allocate(memory_size, block_count);
+	}
+
+	void transfer_cache::deallocate(free_list memories, size_t memory_size)
+	{
+		const size_t index = size_utils::get_index(memory_size);
+		const size_t batch_count = size_utils::get_batch_count(index);
+		//凑不满一批的归还来自前端缓存的周期回收，说明这一级已经冷下来了
+		const bool partial = memories.size() < batch_count;
+		pimpl->m_slots[index].flush_count.fetch_add(1, std::memory_order_relaxed);
+		if (numa_topology::node_count() > 1)
+		{
+			//线程缓存里混着别的节点申请的块，按所属节点分开，别的节点的整串挂到对方的远程队列上
+			free_list local;
+			free_list remote[numa_topology::MAX_NODES];
+			page_map& map = page_map::get_instance();
+			while (!memories.empty())
+			{
+				void* block = memories.pop();
+				const size_t node = map.get(block)->node();
+				(node == m_node ? local : remote[node]).push(block);
+			}
+			for (size_t node = 0; node < numa_topology::node_count(); ++node)
+			{
+				central_cache::get_instance(node).deallocate_remote(std::move(remote[node]), memory_size);
+			}
+			memories = std::move(local);
+		}
+		while (memories.size() >= batch_count)
+		{
+			free_list batch = memories.pop_range(batch_count);
+			if (!insert(index, batch))
+			{
+				memories.splice(batch);
+				break;
+			}
+		}
+		central_cache::get_instance(m_node).deallocate(std::move(memories), memory_size);
+		if (partial)
+		{
+			decay(index);
+		}
+	}
+
+	void transfer_cache::decay(size_t index)
+	{
+		auto& slot = pimpl->m_slots[index];
+		free_list memories;
+		{
+			slot_lock lock(slot.status);
+			//和线程缓存一样，回收上一次衰减以来一直没被取走的那部分的一半
+			size_t count = slot.low_water > 1 ? slot.low_water / 2 : slot.low_water;
+			while (count-- > 0)
+			{
+				memories.splice(slot.batches[--slot.used]);
+			}
+			slot.low_water = slot.used;
+		}
+		if (!memories.empty())
+		{
+			central_cache::get_instance(m_node).deallocate(std::move(memories), size_utils::get_class_size(index));
+		}
+	}
+
+	size_t transfer_cache::drain()
+	{
+		if (pimpl == nullptr)
+		{
+			return 0;
+		}
+		size_t drained = 0;
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
+		{
+			auto& slot = pimpl->m_slots[index];
+			free_list memories;
+			{
+				slot_lock lock(slot.status);
+				while (slot.used > 0)
+				{
+					memories.splice(slot.batches[--slot.used]);
+				}
+				slot.low_water = 0;
+			}
+			if (!memories.empty())
+			{
+				const size_t memory_size = size_utils::get_class_size(index);
+				drained += memories.size() * memory_size;
+				central_cache::get_instance(m_node).deallocate(std::move(memories), memory_size);
+			}
+		}
+		return drained;
+	}
+
+	void transfer_cache::collect_stats(allocator_stats& stats)
+	{
+		for (size_t index = 0; index < size_utils::SIZE_CLASS_COUNT; ++index)
+		{
+			auto& slot = pimpl->m_slots[index];
+			size_t blocks = 0;
+			{
+				slot_lock lock(slot.status);
+				for (size_t i = 0; i < slot.used; ++i)
+				{
+					blocks += slot.batches[i].size();
+				}
+			}
+			size_class_stats& class_stats = stats.classes[index];
+			class_stats.transfer_cached_blocks += blocks;
+			class_stats.refill_count += slot.refill_count.load(std::memory_order_relaxed);
+			class_stats.transfer_hit_count += slot.transfer_hit_count.load(std::memory_order_relaxed);
+			class_stats.flush_count += slot.flush_count.load(std::memory_order_relaxed);
+			stats.transfer_cached_bytes += blocks * size_utils::get_class_size(index);
+		}
+	}
+}
@@ -0,0 +1,792 @@
+//分配器基准测试：同一组可复现的负载分别跑在 TCMalloc 层、三种哈希桶内存池和系统 malloc 上
+//每一行输出吞吐量、单次操作延迟的 p50/p99/p999 和这一轮的峰值 RSS
+//
+//负载：
+//  fixed     每个线程反复申请一批固定大小的块再倒序释放
+//  mixed     每个线程维护 1024 个槽位，随机替换，大小按小块多、大块少的分布抽取
+//  prodcons  线程两两配对，生产者申请、消费者释放（跨线程释放）
+//  larson    仿 larson：每轮重新创建线程，并把上一轮别的线程留下的槽位交给新线程继续替换
+//  xmalloc   仿 xmalloc-test：一半线程申请、一半线程释放，整批通过共享队列传递
+//
+//用法（在 main.cpp 中调用 allocator_benchmark_main，或者定义 MYSTL_ALLOCATOR_BENCHMARK_STANDALONE 单独编译）：
+//  --threads 1,2,4,8   线程数列表
+//  --ops N             每个线程的操作次数（申请和释放各算一次）
+//  --size N            fixed 负载的块大小
+//  --workloads a,b     只跑指定的负载
+//  --allocators a,b    只跑指定的分配器：tcmalloc,hashbucket,mutex,lockfree,malloc
+//  --seed N            随机数种子，相同的种子得到完全相同的申请序列
+//  --csv               输出 CSV
+//  --repeat N          每一行跑 N 次，取吞吐量最高的一次，比较两次构建时用来压低噪声
+//  --save FILE         把结果另存为 CSV，作为以后 --compare 的基线
+//  --compare FILE      和 --save 保存的基线比较，每一行多输出吞吐量的变化，最后按分配器汇总几何平均
+//
+//HashBucketMemoryPool 不是线程安全的，只参与单线程的负载；prodcons 和 xmalloc 至少需要两个线程
+//延迟每 16 次操作采样一次，包含一次 steady_clock 读取的开销
+//峰值 RSS 在 Linux 上每一行开始前通过 /proc/self/clear_refs 清零，其它平台是进程启动以来的峰值
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+#include "../include/TCMalloc/ThreadCache.h"
+#include "../include/HashBucketMemoryPool/HashBucketMemoryPool.h"
+#include "../include/HashBucketMemoryPool/MutexMemoryPool.h"
+#include "../include/HashBucketMemoryPool/LockFreeMemoryPool.h"
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // -------------------------------------------------------------------
+    // 被测的分配器
+    // -------------------------------------------------------------------
+    struct allocator_backend
+    {
+        const char* name;
+        void* (*allocate)(size_t size);
+        void (*deallocate)(void* ptr, size_t size);
+        //能不能在多个线程中同时使用，以及跨线程释放
+        bool thread_safe;
+    };
+
+    const allocator_backend BACKENDS[] = {
+        { "tcmalloc",
+            [](size_t size) { return mystl::thread_cache::get_instance().allocate(size).value_or(nullptr); },
+            [](void* ptr, size_t size) { mystl::thread_cache::get_instance().deallocate(ptr, size); },
+            true },
+        { "hashbucket",
+            [](size_t size) { return HashBucketMemoryPool::HashBucket::allocate(size); },
+            [](void* ptr, size_t size) { HashBucketMemoryPool::HashBucket::deallocate(ptr, size); },
+            false },
+        { "mutex",
+            [](size_t size) { return MutexMemoryPool::HashBucket::allocate(size); },
+            [](void* ptr, size_t size) { MutexMemoryPool::HashBucket::deallocate(ptr, size); },
+            true },
+        { "lockfree",
+            [](size_t size) { return LockFreeMemoryPool::HashBucket::allocate(size); },
+            [](void* ptr, size_t size) { LockFreeMemoryPool::HashBucket::deallocate(ptr, size); },
+            true },
+        { "malloc",
+            [](size_t size) { return std::malloc(size); },
+            [](void* ptr, size_t) { std::free(ptr); },
+            true },
+    };
+
+    struct benchmark_options
+    {
+        std::vector<size_t> threads{ 1, 2, 4, 8 };
+        size_t ops = 500000;
+        size_t fixed_size = 64;
+        uint64_t seed = 20240601;
+        std::vector<std::string> workloads;
+        std::vector<std::string> allocators;
+        bool csv = false;
+        size_t repeat = 1;
+        std::string save_path;
+        std::string compare_path;
+    };
+
+    // -------------------------------------------------------------------
+    // 可复现的随机数和大小分布
+    // -------------------------------------------------------------------
+    class xorshift_rng
+    {
+    public:
+        explicit xorshift_rng(uint64_t seed) :m_state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 7;
+            m_state ^= m_state << 17;
+            return m_state;
+        }
+
+        //[low, high] 之间均匀分布
+        size_t uniform(size_t low, size_t high)
+        {
+            return low + static_cast<size_t>(next() % (high - low + 1));
+        }
+
+    private:
+        uint64_t m_state;
+    };
+
+    //60% 8~128 字节，30% 到 1KB，9% 到 8KB，1% 到 64KB
+    size_t mixed_size(xorshift_rng& rng)
+    {
+        const size_t dice = rng.uniform(0, 99);
+        if (dice < 60)
+            return rng.uniform(8, 128);
+        if (dice < 90)
+            return rng.uniform(129, 1024);
+        if (dice < 99)
+            return rng.uniform(1025, 8192);
+        return rng.uniform(8193, 65536);
+    }
+
+    // -------------------------------------------------------------------
+    // 每个线程的计数和延迟采样
+    // -------------------------------------------------------------------
+    struct thread_result
+    {
+        static constexpr size_t SAMPLE_INTERVAL = 16;
+
+        size_t ops = 0;
+        std::vector<uint32_t> latencies;
+
+        //每 SAMPLE_INTERVAL 次操作计一次时
+        void* allocate(const allocator_backend& backend, size_t size)
+        {
+            void* ptr = nullptr;
+            if (++ops % SAMPLE_INTERVAL != 0)
+            {
+                ptr = backend.allocate(size);
+            }
+            else
+            {
+                const auto begin = clock_type::now();
+                ptr = backend.allocate(size);
+                record(begin);
+            }
+            if (ptr == nullptr)
+            {
+                std::fprintf(stderr, "%s: allocation of %zu bytes failed\n", backend.name, size);
+                std::abort();
+            }
+            //碰一下内存，让页面真正被使用
+            static_cast<volatile char*>(ptr)[0] = static_cast<char>(size);
+            return ptr;
+        }
+
+        void deallocate(const allocator_backend& backend, void* ptr, size_t size)
+        {
+            if (++ops % SAMPLE_INTERVAL != 0)
+            {
+                backend.deallocate(ptr, size);
+                return;
+            }
+            const auto begin = clock_type::now();
+            backend.deallocate(ptr, size);
+            record(begin);
+        }
+
+    private:
+        void record(clock_type::time_point begin)
+        {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - begin).count();
+            latencies.push_back(static_cast<uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+        }
+    };
+
+    //一个块和它的大小，内存池释放时需要大小
+    struct block
+    {
+        void* ptr = nullptr;
+        size_t size = 0;
+    };
+
+    // -------------------------------------------------------------------
+    // 负载
+    // -------------------------------------------------------------------
+    void run_fixed(const allocator_backend& backend, size_t thread_count, const benchmark_options& options, std::vector<thread_result>& results)
+    {
+        constexpr size_t BATCH = 256;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                thread_result& result = results[t];
+                void* batch[BATCH];
+                const size_t rounds = options.ops / (2 * BATCH);
+                for (size_t round = 0; round < rounds; ++round)
+                {
+                    for (size_t i = 0; i < BATCH; ++i)
+                        batch[i] = result.allocate(backend, options.fixed_size);
+                    for (size_t i = BATCH; i-- > 0;)
+                        result.deallocate(backend, batch[i], options.fixed_size);
+                }
+                });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    void run_mixed(const allocator_backend& backend, size_t thread_count, const benchmark_options& options, std::vector<thread_result>& results)
+    {
+        constexpr size_t SLOTS = 1024;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                thread_result& result = results[t];
+                xorshift_rng rng(options.seed + t);
+                std::vector<block> slots(SLOTS);
+                while (result.ops < options.ops)
+                {
+                    block& slot = slots[rng.uniform(0, SLOTS - 1)];
+                    if (slot.ptr != nullptr)
+                        result.deallocate(backend, slot.ptr, slot.size);
+                    slot.size = mixed_size(rng);
+                    slot.ptr = result.allocate(backend, slot.size);
+                }
+                for (block& slot : slots)
+                {
+                    if (slot.ptr != nullptr)
+                        result.deallocate(backend, slot.ptr, slot.size);
+                }
+                });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    //单生产者单消费者的环形队列
+    class spsc_ring
+    {
+    public:
+        static constexpr size_t CAPACITY = 1024;
+
+        bool push(block value)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == CAPACITY)
+                return false;
+            m_items[tail % CAPACITY] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(block& value)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+            value = m_items[head % CAPACITY];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        block m_items[CAPACITY];
+        alignas(64) std::atomic<size_t> m_head{ 0 };
+        alignas(64) std::atomic<size_t> m_tail{ 0 };
+    };
+
+    void run_prodcons(const allocator_backend& backend, size_t thread_count, const benchmark_options& options, std::vector<thread_result>& results)
+    {
+        const size_t pairs = thread_count / 2;
+        std::vector<spsc_ring> rings(pairs);
+        std::vector<std::thread> workers;
+        for (size_t p = 0; p < pairs; ++p)
+        {
+            workers.emplace_back([&, p]() {
+                thread_result& result = results[2 * p];
+                xorshift_rng rng(options.seed + p);
+                for (size_t i = 0; i < options.ops; ++i)
+                {
+                    block item;
+                    item.size = rng.uniform(16, 256);
+                    item.ptr = result.allocate(backend, item.size);
+                    while (!rings[p].push(item))
+                        std::this_thread::yield();
+                }
+                });
+            workers.emplace_back([&, p]() {
+                thread_result& result = results[2 * p + 1];
+                block item;
+                for (size_t i = 0; i < options.ops; ++i)
+                {
+                    while (!rings[p].pop(item))
+                        std::this_thread::yield();
+                    result.deallocate(backend, item.ptr, item.size);
+                }
+                });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    void run_larson(const allocator_backend& backend, size_t thread_count, const benchmark_options& options, std::vector<thread_result>& results)
+    {
+        constexpr size_t SLOTS = 1000;
+        constexpr size_t ROUNDS = 10;
+        std::vector<std::vector<block>> slots(thread_count, std::vector<block>(SLOTS));
+        for (size_t round = 0; round < ROUNDS; ++round)
+        {
+            //每一轮都是新线程，拿到的是上一轮另一个线程留下的槽位
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < thread_count; ++t)
+            {
+                workers.emplace_back([&, t, round]() {
+                    thread_result& result = results[t];
+                    std::vector<block>& own = slots[(t + round) % thread_count];
+                    xorshift_rng rng(options.seed + round * thread_count + t);
+                    const size_t target = options.ops * (round + 1) / ROUNDS;
+                    while (result.ops < target)
+                    {
+                        block& slot = own[rng.uniform(0, SLOTS - 1)];
+                        if (slot.ptr != nullptr)
+                            result.deallocate(backend, slot.ptr, slot.size);
+                        slot.size = rng.uniform(16, 256);
+                        slot.ptr = result.allocate(backend, slot.size);
+                    }
+                    });
+            }
+            for (auto& worker : workers)
+                worker.join();
+        }
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            for (block& slot : slots[t])
+            {
+                if (slot.ptr != nullptr)
+                    results[t].deallocate(backend, slot.ptr, slot.size);
+            }
+        }
+    }
+
+    void run_xmalloc(const allocator_backend& backend, size_t thread_count, const benchmark_options& options, std::vector<thread_result>& results)
+    {
+        constexpr size_t BATCH = 64;
+        constexpr size_t MAX_QUEUED_BATCHES = 256;
+        const size_t producers = thread_count / 2;
+        const size_t consumers = thread_count - producers;
+        const size_t batches_per_producer = options.ops / BATCH;
+
+        //队列里的批次事先申请好，传递过程中不再经过任何分配器
+        std::vector<std::vector<block>> batches(MAX_QUEUED_BATCHES, std::vector<block>(BATCH));
+        std::vector<size_t> free_batches;
+        std::vector<size_t> full_batches;
+        free_batches.reserve(MAX_QUEUED_BATCHES);
+        full_batches.reserve(MAX_QUEUED_BATCHES);
+        for (size_t i = 0; i < MAX_QUEUED_BATCHES; ++i)
+            free_batches.push_back(i);
+        std::mutex queue_mutex;
+        std::atomic<size_t> producers_left{ producers };
+
+        auto take = [&](std::vector<size_t>& from, size_t& index) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (from.empty())
+                return false;
+            index = from.back();
+            from.pop_back();
+            return true;
+        };
+        auto give = [&](std::vector<size_t>& to, size_t index) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            to.push_back(index);
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t p = 0; p < producers; ++p)
+        {
+            workers.emplace_back([&, p]() {
+                thread_result& result = results[p];
+                xorshift_rng rng(options.seed + p);
+                for (size_t b = 0; b < batches_per_producer; ++b)
+                {
+                    size_t index = 0;
+                    while (!take(free_batches, index))
+                        std::this_thread::yield();
+                    for (block& item : batches[index])
+                    {
+                        item.size = rng.uniform(8, 512);
+                        item.ptr = result.allocate(backend, item.size);
+                    }
+                    give(full_batches, index);
+                }
+                producers_left.fetch_sub(1, std::memory_order_release);
+                });
+        }
+        for (size_t c = 0; c < consumers; ++c)
+        {
+            workers.emplace_back([&, c]() {
+                thread_result& result = results[producers + c];
+                while (true)
+                {
+                    size_t index = 0;
+                    if (!take(full_batches, index))
+                    {
+                        if (producers_left.load(std::memory_order_acquire) == 0 && !take(full_batches, index))
+                            break;
+                        if (producers_left.load(std::memory_order_acquire) != 0)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                    }
+                    for (block& item : batches[index])
+                        result.deallocate(backend, item.ptr, item.size);
+                    give(free_batches, index);
+                }
+                });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    struct workload
+    {
+        const char* name;
+        void (*run)(const allocator_backend&, size_t, const benchmark_options&, std::vector<thread_result>&);
+        //至少需要的线程数
+        size_t min_threads;
+        //有跨线程释放
+        bool cross_thread;
+    };
+
+    const workload WORKLOADS[] = {
+        { "fixed", run_fixed, 1, false },
+        { "mixed", run_mixed, 1, false },
+        { "prodcons", run_prodcons, 2, true },
+        { "larson", run_larson, 1, true },
+        { "xmalloc", run_xmalloc, 2, true },
+    };
+
+    // -------------------------------------------------------------------
+    // 峰值 RSS
+    // -------------------------------------------------------------------
+    void reset_peak_rss()
+    {
+#if defined(__linux__)
+        //写入 5 会把 VmHWM 重置为当前的 RSS
+        if (FILE* file = std::fopen("/proc/self/clear_refs", "w"))
+        {
+            std::fputs("5", file);
+            std::fclose(file);
+        }
+#endif
+    }
+
+    size_t peak_rss_kb()
+    {
+#if defined(__linux__)
+        size_t result = 0;
+        if (FILE* file = std::fopen("/proc/self/status", "r"))
+        {
+            char line[256];
+            while (std::fgets(line, sizeof(line), file))
+            {
+                if (std::strncmp(line, "VmHWM:", 6) == 0)
+                {
+                    result = std::strtoull(line + 6, nullptr, 10);
+                    break;
+                }
+            }
+            std::fclose(file);
+        }
+        return result;
+#elif defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize / 1024;
+        return 0;
+#else
+        return 0;
+#endif
+    }
+
+    // -------------------------------------------------------------------
+    // 运行和输出
+    // -------------------------------------------------------------------
+    struct row_result
+    {
+        double mops = 0;
+        uint32_t p50 = 0;
+        uint32_t p99 = 0;
+        uint32_t p999 = 0;
+        size_t peak_rss_kb = 0;
+    };
+
+    row_result run_row_once(const workload& load, const allocator_backend& backend, size_t thread_count, const benchmark_options& options)
+    {
+        std::vector<thread_result> results(thread_count);
+        for (auto& result : results)
+            result.latencies.reserve(options.ops / thread_result::SAMPLE_INTERVAL + 1024);
+
+        reset_peak_rss();
+        const auto begin = clock_type::now();
+        load.run(backend, thread_count, options, results);
+        const double seconds = std::chrono::duration<double>(clock_type::now() - begin).count();
+
+        row_result row;
+        row.peak_rss_kb = peak_rss_kb();
+        size_t total_ops = 0;
+        std::vector<uint32_t> latencies;
+        for (auto& result : results)
+        {
+            total_ops += result.ops;
+            latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        }
+        row.mops = seconds > 0 ? static_cast<double>(total_ops) / seconds / 1e6 : 0;
+        if (!latencies.empty())
+        {
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double q) {
+                return latencies[std::min(latencies.size() - 1, static_cast<size_t>(q * static_cast<double>(latencies.size())))];
+            };
+            row.p50 = percentile(0.50);
+            row.p99 = percentile(0.99);
+            row.p999 = percentile(0.999);
+        }
+        return row;
+    }
+
+    row_result run_row(const workload& load, const allocator_backend& backend, size_t thread_count, const benchmark_options& options)
+    {
+        row_result best = run_row_once(load, backend, thread_count, options);
+        for (size_t i = 1; i < options.repeat; ++i)
+        {
+            const row_result row = run_row_once(load, backend, thread_count, options);
+            if (row.mops > best.mops)
+                best = row;
+        }
+        return best;
+    }
+
+    bool selected(const std::vector<std::string>& filter, const char* name)
+    {
+        return filter.empty() || std::find(filter.begin(), filter.end(), name) != filter.end();
+    }
+
+    std::vector<std::string> split(const char* text)
+    {
+        std::vector<std::string> result;
+        std::string current;
+        for (const char* p = text; ; ++p)
+        {
+            if (*p == ',' || *p == '\0')
+            {
+                if (!current.empty())
+                    result.push_back(current);
+                current.clear();
+                if (*p == '\0')
+                    break;
+            }
+            else
+            {
+                current += *p;
+            }
+        }
+        return result;
+    }
+
+    // -------------------------------------------------------------------
+    // 基线：--save 写出、--compare 读入，格式和 --csv 的输出相同
+    // -------------------------------------------------------------------
+    struct baseline_row
+    {
+        std::string workload;
+        std::string allocator;
+        size_t threads = 0;
+        double mops = 0;
+    };
+
+    bool load_baseline(const std::string& path, std::vector<baseline_row>& rows)
+    {
+        FILE* file = std::fopen(path.c_str(), "r");
+        if (file == nullptr)
+            return false;
+        char line[512];
+        while (std::fgets(line, sizeof(line), file))
+        {
+            line[std::strcspn(line, "\r\n")] = '\0';
+            const std::vector<std::string> fields = split(line);
+            if (fields.size() < 4 || fields[0] == "workload")
+                continue;
+            baseline_row row;
+            row.workload = fields[0];
+            row.allocator = fields[1];
+            row.threads = std::strtoull(fields[2].c_str(), nullptr, 10);
+            row.mops = std::strtod(fields[3].c_str(), nullptr);
+            rows.push_back(row);
+        }
+        std::fclose(file);
+        return true;
+    }
+
+    const baseline_row* find_baseline(const std::vector<baseline_row>& rows, const char* load, const char* allocator, size_t threads)
+    {
+        for (const baseline_row& row : rows)
+        {
+            if (row.workload == load && row.allocator == allocator && row.threads == threads && row.mops > 0)
+                return &row;
+        }
+        return nullptr;
+    }
+
+    bool parse_options(int argc, char** argv, benchmark_options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (arg == "--csv")
+            {
+                options.csv = true;
+                continue;
+            }
+            if (value == nullptr)
+            {
+                std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+                return false;
+            }
+            ++i;
+            if (arg == "--threads")
+            {
+                options.threads.clear();
+                for (const std::string& item : split(value))
+                    options.threads.push_back(std::strtoull(item.c_str(), nullptr, 10));
+            }
+            else if (arg == "--ops")
+                options.ops = std::strtoull(value, nullptr, 10);
+            else if (arg == "--size")
+                options.fixed_size = std::strtoull(value, nullptr, 10);
+            else if (arg == "--seed")
+                options.seed = std::strtoull(value, nullptr, 10);
+            else if (arg == "--workloads")
+                options.workloads = split(value);
+            else if (arg == "--allocators")
+                options.allocators = split(value);
+            else if (arg == "--repeat")
+                options.repeat = std::max<size_t>(1, std::strtoull(value, nullptr, 10));
+            else if (arg == "--save")
+                options.save_path = value;
+            else if (arg == "--compare")
+                options.compare_path = value;
+            else
+            {
+                std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int allocator_benchmark_main(int argc, char** argv)
+{
+    benchmark_options options;
+    if (!parse_options(argc, argv, options))
+        return 1;
+
+    std::vector<baseline_row> baseline;
+    const bool compare = !options.compare_path.empty();
+    if (compare && !load_baseline(options.compare_path, baseline))
+    {
+        std::fprintf(stderr, "cannot read baseline %s\n", options.compare_path.c_str());
+        return 1;
+    }
+    FILE* save = nullptr;
+    if (!options.save_path.empty())
+    {
+        save = std::fopen(options.save_path.c_str(), "w");
+        if (save == nullptr)
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.save_path.c_str());
+            return 1;
+        }
+        std::fprintf(save, "workload,allocator,threads,mops,p50_ns,p99_ns,p999_ns,peak_rss_kb\n");
+    }
+
+    HashBucketMemoryPool::HashBucket::initMemoryPools();
+    MutexMemoryPool::HashBucket::initMemoryPools();
+    LockFreeMemoryPool::HashBucket::initMemoryPools();
+
+    if (options.csv)
+        std::printf("workload,allocator,threads,mops,p50_ns,p99_ns,p999_ns,peak_rss_kb%s\n", compare ? ",delta_pct" : "");
+    else
+        std::printf("%-10s %-11s %7s %10s %9s %9s %9s %12s%s\n", "workload", "allocator", "threads", "Mops/s", "p50(ns)", "p99(ns)", "p999(ns)", "peakRSS(MB)", compare ? "   vs base" : "");
+
+    //每个分配器和基线相比的吞吐量比值取对数累加，最后算几何平均
+    double log_ratio_sum[std::size(BACKENDS)] = {};
+    size_t compared_rows[std::size(BACKENDS)] = {};
+
+    for (const workload& load : WORKLOADS)
+    {
+        if (!selected(options.workloads, load.name))
+            continue;
+        for (size_t thread_count : options.threads)
+        {
+            if (thread_count < load.min_threads)
+                continue;
+            for (size_t b = 0; b < std::size(BACKENDS); ++b)
+            {
+                const allocator_backend& backend = BACKENDS[b];
+                if (!selected(options.allocators, backend.name))
+                    continue;
+                //不是线程安全的内存池只能在单线程、没有跨线程释放的负载里使用
+                if (!backend.thread_safe && (thread_count > 1 || load.cross_thread))
+                    continue;
+                const row_result row = run_row(load, backend, thread_count, options);
+
+                char delta[32] = "";
+                if (compare)
+                {
+                    const baseline_row* base = find_baseline(baseline, load.name, backend.name, thread_count);
+                    if (base != nullptr && row.mops > 0)
+                    {
+                        const double ratio = row.mops / base->mops;
+                        log_ratio_sum[b] += std::log(ratio);
+                        ++compared_rows[b];
+                        std::snprintf(delta, sizeof(delta), "%+.1f%%", (ratio - 1.0) * 100.0);
+                    }
+                    else
+                    {
+                        std::snprintf(delta, sizeof(delta), "n/a");
+                    }
+                }
+
+                if (options.csv)
+                    std::printf("%s,%s,%zu,%.3f,%u,%u,%u,%zu%s%s\n", load.name, backend.name, thread_count, row.mops, row.p50, row.p99, row.p999, row.peak_rss_kb, compare ? "," : "", delta);
+                else
+                    std::printf("%-10s %-11s %7zu %10.2f %9u %9u %9u %12.1f%s%10s\n", load.name, backend.name, thread_count, row.mops, row.p50, row.p99, row.p999, static_cast<double>(row.peak_rss_kb) / 1024.0, compare ? " " : "", delta);
+                std::fflush(stdout);
+                if (save != nullptr)
+                    std::fprintf(save, "%s,%s,%zu,%.3f,%u,%u,%u,%zu\n", load.name, backend.name, thread_count, row.mops, row.p50, row.p99, row.p999, row.peak_rss_kb);
+            }
+        }
+    }
+
+    if (save != nullptr)
+        std::fclose(save);
+    if (compare)
+    {
+        //CSV 模式下汇总写到 stderr，不破坏输出的格式
+        FILE* summary = options.csv ? stderr : stdout;
+        std::fprintf(summary, "\nthroughput vs %s (geometric mean):\n", options.compare_path.c_str());
+        for (size_t b = 0; b < std::size(BACKENDS); ++b)
+        {
+            if (compared_rows[b] == 0)
+                continue;
+            const double ratio = std::exp(log_ratio_sum[b] / static_cast<double>(compared_rows[b]));
+            std::fprintf(summary, "  %-11s %+.1f%% over %zu rows\n", BACKENDS[b].name, (ratio - 1.0) * 100.0, compared_rows[b]);
+        }
+    }
+    return 0;
+}
+
+#if defined(MYSTL_ALLOCATOR_BENCHMARK_STANDALONE)
+int main(int argc, char** argv)
+{
+    return allocator_benchmark_main(argc, argv);
+}
+#endif
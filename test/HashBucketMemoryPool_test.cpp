@@ -7,20 +7,20 @@
 #include <cstdio>     // For printf
 #include <utility>    // For std::forward
 
-// ĹϣͰڴͷļ
+// 包含你的哈希桶内存池头文件
 #include "../include/HashBucketMemoryPool/HashBucketMemoryPool.h"
 
-// ʹռ
+// 使用你的命名空间
 using namespace HashBucketMemoryPool;
 
 // -------------------------------------------------------------------
-// ࣺͬСĶ
+// 测试用例类：不同大小的对象
 // -------------------------------------------------------------------
 class P1 {
 public:
     int id_; // 4 bytes
     P1(int id = 0) : id_(id) {}
-    // ~P1() { std::cout << "P1 dtor " << id_ << std::endl; } //  uncomment ڵ
+    // ~P1() { std::cout << "P1 dtor " << id_ << std::endl; } // 可以 uncomment 用于调试生命周期
 };
 
 class P2 {
@@ -44,7 +44,7 @@ public:
     // ~P4() { std::cout << "P4 dtor " << id_[0] << std::endl; }
 };
 
-class P_Large { // ģ MAX_SLOT_SIZE (512ֽ) Ķ
+class P_Large { // 模拟大于 MAX_SLOT_SIZE (512字节) 的对象
 public:
     int data[200]; // 800 bytes
     P_Large(int id = 0) { data[0] = id; }
@@ -52,27 +52,27 @@ public:
 };
 
 // -------------------------------------------------------------------
-// ׼Ժ HashBucketMemoryPool (Ķߴڴ)
+// 基准测试函数：用于 HashBucketMemoryPool (你的多尺寸内存池)
 // -------------------------------------------------------------------
 void BenchmarkHashBucketMemoryPool(size_t ntimes, size_t nworks, size_t rounds)
 {
-    // HashBucketMemoryPool ڵǰʵǵ̰߳ȫ (Ϊ SimpleMemoryPool ǵ̵߳)
-    // nworks Ϊ 1򽫵ݾ
+    // HashBucketMemoryPool 在当前实现中是单线程安全的 (因为 SimpleMemoryPool 是单线程的)。
+    // nworks 必须为 1，否则将导致数据竞争。
     if (nworks > 1) {
         std::cerr << "Warning: HashBucketMemoryPool is NOT fully thread-safe in this version. Running with nworks=1." << std::endl;
         nworks = 1;
     }
 
-    std::vector<std::thread> vthread(nworks); // ̳߳ (ʵֻһ߳)
+    std::vector<std::thread> vthread(nworks); // 线程池 (实际上只有一个线程)
     size_t total_costtime = 0;
 
-    for (size_t k = 0; k < nworks; ++k) //  nworks ߳
+    for (size_t k = 0; k < nworks; ++k) // 创建 nworks 个线程
     {
-        vthread[k] = std::thread([&]() { // Lambda ʽⲿ
+        vthread[k] = std::thread([&]() { // Lambda 表达式捕获外部变量
             for (size_t j = 0; j < rounds; ++j) {
-                clock_t begin1 = clock(); // ʹ clock_t, clock()
+                clock_t begin1 = clock(); // 使用 clock_t, clock()
                 for (size_t i = 0; i < ntimes; i++) {
-                    // ʹ HashBucketMemoryPool ӿڷͷŲͬСĶ
+                    // 使用 HashBucketMemoryPool 接口分配和释放不同大小的对象
                     P1* p1 = newElement<P1>(i);
                     deleteElement<P1>(p1);
                     P2* p2 = newElement<P2>(i);
@@ -81,49 +81,49 @@ void BenchmarkHashBucketMemoryPool(size_t ntimes, size_t nworks, size_t rounds)
                     deleteElement<P3>(p3);
                     P4* p4 = newElement<P4>(i);
                     deleteElement<P4>(p4);
-                    // Դ MAX_SLOT_SIZE Ķ󣬻˵ malloc/free
+                    // 测试大于 MAX_SLOT_SIZE 的对象，会回退到 malloc/free
                     P_Large* p_large = newElement<P_Large>(i); 
                     deleteElement<P_Large>(p_large);
                 }
                 clock_t end1 = clock();
-                total_costtime += (end1 - begin1); // ۼʱ
+                total_costtime += (end1 - begin1); // 累加时间
             }
         });
     }
 
     for (auto& t : vthread) {
-        t.join(); // ȴ߳
+        t.join(); // 等待所有线程完成
     }
 
-    // ӡ
-    printf("%zuִ̲߳%zuִΣÿִnewElement&deleteElement %zu (HashBucketMemoryPool)ܼƻѣ%zu ms\n", 
+    // 打印结果
+    printf("%zu个线程并发执行%zu轮次，每轮次newElement&deleteElement %zu次 (HashBucketMemoryPool)，总计花费：%zu ms\n", 
            nworks, rounds, ntimes, total_costtime);
 }
 
 // -------------------------------------------------------------------
-// ׼Ժڱ׼ new/delete
+// 基准测试函数：用于标准 new/delete
 // -------------------------------------------------------------------
 extern void BenchmarkNewDelete(size_t ntimes, size_t nworks, size_t rounds);
 
 
 // -------------------------------------------------------------------
-// Main 
+// Main 函数
 // -------------------------------------------------------------------
 int test_hash_bucket_main()
 {
     std::cout << "--- Starting Memory Pool Benchmarks ---" << std::endl;
     std::cout << "Note: HashBucketMemoryPool is NOT thread-safe in this version. 'nworks' should be 1 for accurate comparison." << std::endl;
 
-    // === ؼʼ HashBucketMemoryPool ϵͳ ===
+    // === 关键：初始化 HashBucketMemoryPool 系统 ===
     HashBucket::initMemoryPools(); 
 
-    // ִͷŴ, ߳, ִ
-    //  HashBucketMemoryPool (nworks Ϊ 1)
+    // 参数：单轮次申请释放次数, 线程数, 轮次
+    // 测试 HashBucketMemoryPool (nworks 必须为 1)
     BenchmarkHashBucketMemoryPool(1000, 1, 10000);
 
     std::cout << "===========================================================================" << std::endl;
     
-    // Ա׼ new/delete (ʹọ̈߳Ϊ˶Աȱ nworks=1)
+    // 测试标准 new/delete (可以使用多个线程，但这里为了对比保持 nworks=1)
     BenchmarkNewDelete(1000, 1, 10000);
 
     std::cout << "--- Benchmarks Finished ---" << std::endl;
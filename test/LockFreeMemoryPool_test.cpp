@@ -9,17 +9,17 @@
 
 #include "../include/HashBucketMemoryPool/LockFreeMemoryPool.h"
 
-// ʹռ
+// 使用你的命名空间
 using namespace LockFreeMemoryPool;
 
 // -------------------------------------------------------------------
-// ࣺͬСĶ
+// 测试用例类：不同大小的对象
 // -------------------------------------------------------------------
 class P1 {
 public:
     int id_; // 4 bytes
     P1(int id = 0) : id_(id) {}
-    // ~P1() { std::cout << "P1 dtor " << id_ << std::endl; } //  uncomment ڵ
+    // ~P1() { std::cout << "P1 dtor " << id_ << std::endl; } // 可以 uncomment 用于调试生命周期
 };
 
 class P2 {
@@ -43,7 +43,7 @@ public:
     // ~P4() { std::cout << "P4 dtor " << id_[0] << std::endl; }
 };
 
-class P_Large { // ģ MAX_SLOT_SIZE (512ֽ) Ķ
+class P_Large { // 模拟大于 MAX_SLOT_SIZE (512字节) 的对象
 public:
     int data[200]; // 800 bytes
     P_Large(int id = 0) { data[0] = id; }
@@ -51,25 +51,25 @@ public:
 };
 
 // -------------------------------------------------------------------
-// ׼Ժ HashBucketMemoryPool (Ķߴڴ)
+// 基准测试函数：用于 HashBucketMemoryPool (你的多尺寸内存池)
 // -------------------------------------------------------------------
 void BenchmarkLockFreeMemoryPool(size_t ntimes, size_t nworks, size_t rounds)
 {
 
-    std::vector<std::thread> vthread(nworks);//̳߳
+    std::vector<std::thread> vthread(nworks);//线程池
     std::atomic<size_t> total_costtime = 0;
 
-    for (size_t k = 0; k < nworks; ++k) //  nworks ߳
+    for (size_t k = 0; k < nworks; ++k) // 创建 nworks 个线程
     {
-        vthread[k] = std::thread([&]() { // Lambda ʽⲿ
+        vthread[k] = std::thread([&]() { // Lambda 表达式捕获外部变量
             clock_t begin1;
             clock_t end1;
-            size_t thread_cost_time = 0; // ÿ߳Լļʱ
+            size_t thread_cost_time = 0; // 每个线程自己的计时器
 
             for (size_t j = 0; j < rounds; ++j) {
-                clock_t begin1 = clock(); // ʹ clock_t, clock()
+                clock_t begin1 = clock(); // 使用 clock_t, clock()
                 for (size_t i = 0; i < ntimes; i++) {
-                    // ʹ HashBucketMemoryPool ӿڷͷŲͬСĶ
+                    // 使用 HashBucketMemoryPool 接口分配和释放不同大小的对象
                     P1* p1 = newElement<P1>(i);
                     deleteElement<P1>(p1);
                     P2* p2 = newElement<P2>(i);
@@ -78,41 +78,41 @@ void BenchmarkLockFreeMemoryPool(size_t ntimes, size_t nworks, size_t rounds)
                     deleteElement<P3>(p3);
                     P4* p4 = newElement<P4>(i);
                     deleteElement<P4>(p4);
-                    // Դ MAX_SLOT_SIZE Ķ󣬻˵ malloc/free
+                    // 测试大于 MAX_SLOT_SIZE 的对象，会回退到 malloc/free
                     P_Large* p_large = newElement<P_Large>(i);
                     deleteElement<P_Large>(p_large);
                 }
                 end1 = clock();
                 thread_cost_time += (end1 - begin1);
             }
-            total_costtime += thread_cost_time; // std::atomic  += ̰߳ȫ
+            total_costtime += thread_cost_time; // std::atomic 的 += 是线程安全的
             });
     }
 
     for (auto& t : vthread) {
-        t.join(); // ȴ߳
+        t.join(); // 等待所有线程完成
     }
 
-    // ӡ
-    printf("%zuִ̲߳%zuִΣÿִnewElement&deleteElement %zu (HashBucketMemoryPool)ܼƻѣ%zu ms\n",
+    // 打印结果
+    printf("%zu个线程并发执行%zu轮次，每轮次newElement&deleteElement %zu次 (HashBucketMemoryPool)，总计花费：%zu ms\n",
         nworks, rounds, ntimes, total_costtime.load());
 }
 
 // -------------------------------------------------------------------
-// ׼Ժڱ׼ new/delete
+// 基准测试函数：用于标准 new/delete
 // -------------------------------------------------------------------
 void BenchmarkLockFreeNewDelete(size_t ntimes, size_t nworks, size_t rounds)
 {
-    std::vector<std::thread> vthread(nworks); // ̳߳
+    std::vector<std::thread> vthread(nworks); // 线程池
     std::atomic<size_t> total_costtime = 0;
 
-    for (size_t k = 0; k < nworks; ++k) //  nworks ߳
+    for (size_t k = 0; k < nworks; ++k) // 创建 nworks 个线程
     {
         vthread[k] = std::thread([&]() {
             for (size_t j = 0; j < rounds; ++j) {
                 clock_t begin1 = clock();
                 for (size_t i = 0; i < ntimes; i++) {
-                    // ʹñ׼ new/delete
+                    // 使用标准 new/delete
                     P1* p1 = new P1;
                     delete p1;
                     P2* p2 = new P2;
@@ -132,12 +132,12 @@ void BenchmarkLockFreeNewDelete(size_t ntimes, size_t nworks, size_t rounds)
         t.join();
     }
 
-    printf("%zuִ̲߳%zuִΣÿִnew/delete %zu (Standard)ܼƻѣ%zu ms\n",
+    printf("%zu个线程并发执行%zu轮次，每轮次new/delete %zu次 (Standard)，总计花费：%zu ms\n",
         nworks, rounds, ntimes, total_costtime.load());
 }
 
 // -------------------------------------------------------------------
-// Main 
+// Main 函数
 // -------------------------------------------------------------------
 int test_LockFree_main()
 {
@@ -147,10 +147,10 @@ int test_LockFree_main()
 
     //std::cout << "--- Benchmarks Finished ---" << std::endl;
 
-    // === ؼʼ HashBucketMemoryPool ϵͳ ===
+    // === 关键：初始化 HashBucketMemoryPool 系统 ===
     HashBucket::initMemoryPools();
 
-    // ִͷŴ, ߳, ִ
+    // 参数：单轮次申请释放次数, 线程数, 轮次
     BenchmarkLockFreeMemoryPool(1000, 100, 100);
 
     std::cout << "===========================================================================" << std::endl;
@@ -7,47 +7,58 @@
 
 #include "../include/vector.h"
 
-// ڴͷļ
+// 包含您的内存池头文件
 #include "../include/TCMalloc/ThreadCache.h"
 #include "../include/TCMalloc/CentralCache.h"
+#include "../include/TCMalloc/TransferCache.h"
+#include "../include/TCMalloc/CpuCache.h"
 #include "../include/TCMalloc/PageCache.h"
+#include "../include/TCMalloc/MetadataArena.h"
 #include "../include/TCMalloc/TCMallocutils.h"
+#include "../include/TCMalloc/PageMap.h"
+#include "../include/TCMalloc/TCMallocStats.h"
+#include "../include/TCMalloc/HeapProfiler.h"
+#include "../include/TCMalloc/TCMallocBootstrap.h"
 #include<vector>
+#include <cstring>
+#include <cstdint>
+#include <sstream>
+#include <algorithm>
 
 
 // -------------------------------------------------------------------
-// 1. ģĴ룬ģ廯 new/delete ӿ
+// 1. 模仿您的代码，创建模板化的 new/delete 接口
 // -------------------------------------------------------------------
 
-// ģ廯 newڴڴط͹
+// 模板化的 new，用于从您的内存池分配和构造对象
 template<typename T, typename... Args>
 T* my_new(Args&&... args) {
-    //  thread_cache ڴ
+    // 从 thread_cache 分配内存
     size_t size = sizeof(T);
     void* p = mystl::thread_cache::get_instance().allocate(size).value_or(nullptr);
     if (!p) {
         throw std::bad_alloc();
     }
-    // ʹ placement new ѷڴϹ
+    // 使用 placement new 在已分配的内存上构造对象
     return new(p) T(std::forward<Args>(args)...);
 }
 
-// ģ廯 deleteͷŶڴ
+// 模板化的 delete，用于析构和释放对象回您的内存池
 template<typename T>
 void my_delete(T* p) {
     if (!p) {
         return;
     }
     size_t size = sizeof(T);
-    // ʽ
+    // 显式调用析构函数
     p->~T();
-    // 黹ڴ thread_cache
+    // 归还内存给 thread_cache
     mystl::thread_cache::get_instance().deallocate(p, size);
 }
 
 
 // -------------------------------------------------------------------
-// 2. ࣺͬСĶ (ʾȫͬ)
+// 2. 测试用例类：不同大小的对象 (与您的示例完全相同)
 // -------------------------------------------------------------------
 class P1 {
 public:
@@ -73,15 +84,15 @@ public:
     P4(int id = 0) { id_[0] = id; }
 };
 
-// ģһ ThreadCache ֱӴ (16K) Ĵ
+// 模拟一个大于 ThreadCache 直接处理上限 (16K) 的大对象
 class P_Large {
 public:
-    char data[mystl::size_utils::MAX_CACHED_UNIT_SIZE + 1]; // 16KB
+    char data[mystl::size_utils::MAX_CACHED_UNIT_SIZE + 1]; // 大于16KB
     P_Large(int id = 0) { data[0] = id; }
 };
 
 // -------------------------------------------------------------------
-// 3. ׼Ժ TCMalloc-like ڴ
+// 3. 基准测试函数：用于您的 TCMalloc-like 内存池
 // -------------------------------------------------------------------
 void BenchmarkTCMalloc(size_t ntimes, size_t nworks, size_t rounds)
 {
@@ -92,13 +103,13 @@ void BenchmarkTCMalloc(size_t ntimes, size_t nworks, size_t rounds)
     {
         vthread[k] = std::thread([&]() {
             size_t thread_cost_time = 0;
-            mystl::vector<void*> p_vec; // ڴ洢ָ룬ģʵĸ
+            mystl::vector<void*> p_vec; // 用于存储分配的指针，以模拟更真实的负载
             p_vec.reserve(ntimes * 4);
 
             for (size_t j = 0; j < rounds; ++j) {
                 clock_t begin1 = clock();
                 for (size_t i = 0; i < ntimes; i++) {
-                    // ʹ my_new / my_delete ӿ
+                    // 使用 my_new / my_delete 接口
                     my_delete(my_new<P1>(i));
                     my_delete(my_new<P2>(i));
                     my_delete(my_new<P3>(i));
@@ -115,37 +126,559 @@ void BenchmarkTCMalloc(size_t ntimes, size_t nworks, size_t rounds)
         t.join();
     }
 
-    // ӡ
-    printf("%zuִ̲߳%zuִΣÿִmy_new/my_delete %zu (TCMalloc-like)ܼƻѣ%zu ms\n",
+    // 打印结果
+    printf("%zu个线程并发执行%zu轮次，每轮次my_new/my_delete %zu次 (TCMalloc-like)，总计花费：%zu ms\n",
         nworks, rounds, ntimes, total_costtime.load());
 }
 
 // -------------------------------------------------------------------
-// 4. ׼Ժڱ׼ new/delete
+// 4. 基准测试函数：用于标准 new/delete
 // -------------------------------------------------------------------
 extern void BenchmarkNewDelete(size_t ntimes, size_t nworks, size_t rounds);
 
+// -------------------------------------------------------------------
+// 5. 正确性检查：失败时打印位置，test_TCMalloc_main 返回非零
+// -------------------------------------------------------------------
+static int g_tcmalloc_failures = 0;
+
+#define TCMALLOC_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ++g_tcmalloc_failures; \
+            std::cerr << "CHECK failed: " #condition " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        } \
+    } while (0)
+
+// 每个级别的块大小能放下申请的大小，并且 round_up 得到的就是所在级别的块大小
+static void TestSizeClassRoundTrip()
+{
+    size_t previous_index = 0;
+    for (size_t size = 1; size <= mystl::size_utils::MAX_CACHED_UNIT_SIZE; ++size) {
+        const size_t index = mystl::size_utils::get_index(size);
+        const size_t unit_size = mystl::size_utils::get_class_size(index);
+        TCMALLOC_CHECK(index < mystl::size_utils::SIZE_CLASS_COUNT);
+        TCMALLOC_CHECK(unit_size >= size);
+        TCMALLOC_CHECK(unit_size % mystl::size_utils::ALIGNMENT == 0);
+        TCMALLOC_CHECK(mystl::size_utils::round_up(size) == unit_size);
+        // 块大小本身落在自己的级别里，级别随大小单调不减
+        TCMALLOC_CHECK(mystl::size_utils::get_index(unit_size) == index);
+        TCMALLOC_CHECK(index >= previous_index);
+        previous_index = index;
+    }
+}
+
+// 不带大小的归还：大小从 page_map 恢复，小块回到线程缓存后下一次同样大小的申请拿到同一块
+static void TestSizelessDeallocate()
+{
+    mystl::thread_cache& cache = mystl::thread_cache::get_instance();
+    const size_t sizes[] = { 1, 8, 24, 100, 1000, 4096, mystl::size_utils::MAX_CACHED_UNIT_SIZE };
+    for (size_t size : sizes) {
+        void* p = cache.allocate(size).value_or(nullptr);
+        TCMALLOC_CHECK(p != nullptr);
+        if (p == nullptr) {
+            continue;
+        }
+        mystl::page_span* owner = mystl::page_map::get_instance().get(p);
+        TCMALLOC_CHECK(owner != nullptr && owner->unit_size() == mystl::size_utils::round_up(size));
+        std::memset(p, 0x5a, size);
+        cache.deallocate(p);
+        void* q = cache.allocate(size).value_or(nullptr);
+        TCMALLOC_CHECK(q == p);
+        cache.deallocate(q);
+    }
+
+    // 大块也可以不带大小归还
+    const size_t large_count = mystl::get_allocator_stats().large_allocated_count;
+    void* large = cache.allocate(mystl::size_utils::MAX_CACHED_UNIT_SIZE * 3).value_or(nullptr);
+    TCMALLOC_CHECK(large != nullptr);
+    TCMALLOC_CHECK(mystl::get_allocator_stats().large_allocated_count == large_count + 1);
+    cache.deallocate(large);
+    TCMALLOC_CHECK(mystl::get_allocator_stats().large_allocated_count == large_count);
+}
+
+// 大块：按起始地址登记在 page_map 里，可以写满，归还后不再计入使用中的大块
+static void TestLargeSpans()
+{
+    const size_t sizes[] = {
+        mystl::size_utils::MAX_CACHED_UNIT_SIZE + 1,
+        300 * 1024,
+        mystl::page_cache::LARGE_MMAP_THRESHOLD,
+        mystl::page_cache::LARGE_MMAP_THRESHOLD * 3 + 123,
+    };
+    const mystl::allocator_stats before = mystl::get_allocator_stats();
+    for (size_t size : sizes) {
+        auto memory = mystl::page_cache::allocate_unit(size);
+        TCMALLOC_CHECK(memory.has_value());
+        if (!memory) {
+            continue;
+        }
+        mystl::byte* p = memory->data();
+        TCMALLOC_CHECK(reinterpret_cast<uintptr_t>(p) % mystl::size_utils::PAGE_SIZE == 0);
+        TCMALLOC_CHECK(memory->size() >= size);
+        std::memset(p, 0xa5, size);
+        mystl::page_span* owner = mystl::page_map::get_instance().get(p);
+        // 释放时拿到的一定是起始地址，所以大块只登记第一页
+        TCMALLOC_CHECK(owner != nullptr && owner->data() == p && owner->unit_size() >= size);
+
+        const mystl::allocator_stats in_use = mystl::get_allocator_stats();
+        TCMALLOC_CHECK(in_use.large_allocated_count == before.large_allocated_count + 1);
+        TCMALLOC_CHECK(in_use.large_allocated_bytes >= before.large_allocated_bytes + size);
+
+        mystl::page_cache::deallocate_unit(*memory);
+        TCMALLOC_CHECK(mystl::page_map::get_instance().get(p) == nullptr);
+        TCMALLOC_CHECK(mystl::get_allocator_stats().large_allocated_count == before.large_allocated_count);
+    }
+    // 超过 PTRDIFF_MAX 的申请直接失败
+    TCMALLOC_CHECK(!mystl::page_cache::allocate_unit(static_cast<size_t>(-1)));
+}
+
+// 线程退出时把自己缓存的块全部还给下层，并且从线程缓存的登记表里移除
+static void TestThreadExitDrain()
+{
+    const mystl::allocator_stats before = mystl::get_allocator_stats();
+    std::atomic<size_t> cached_in_worker{ 0 };
+    std::thread worker([&]() {
+        std::vector<void*> blocks;
+        for (size_t i = 0; i < 2000; ++i) {
+            blocks.push_back(mystl::thread_cache::get_instance().allocate(64 + (i % 8) * 64).value_or(nullptr));
+        }
+        for (void* p : blocks) {
+            mystl::thread_cache::get_instance().deallocate(p);
+        }
+        cached_in_worker = mystl::get_allocator_stats().thread_cached_bytes;
+    });
+    worker.join();
+
+    const mystl::allocator_stats after = mystl::get_allocator_stats();
+    TCMALLOC_CHECK(cached_in_worker.load() > before.thread_cached_bytes);
+    TCMALLOC_CHECK(after.thread_cache_count == before.thread_cache_count);
+    TCMALLOC_CHECK(after.thread_cached_bytes == before.thread_cached_bytes);
+
+    // 累计的申请、归还次数在线程退出以后仍然保留
+    size_t allocs = 0;
+    size_t frees = 0;
+    for (size_t index = 0; index < mystl::size_utils::SIZE_CLASS_COUNT; ++index) {
+        allocs += after.classes[index].alloc_count - before.classes[index].alloc_count;
+        frees += after.classes[index].free_count - before.classes[index].free_count;
+    }
+    TCMALLOC_CHECK(allocs >= 2000);
+    TCMALLOC_CHECK(frees >= 2000);
+}
+
+// 对齐申请：从一个指针大小到 1MB 的对齐，起始地址都要对齐并且整块可写
+static void TestAlignedAllocation()
+{
+    mystl::thread_cache& cache = mystl::thread_cache::get_instance();
+    const size_t sizes[] = { 1, 100, 5000, 40000 };
+    for (size_t alignment = mystl::size_utils::ALIGNMENT; alignment <= 1024 * 1024; alignment *= 2) {
+        for (size_t size : sizes) {
+            void* p = cache.allocate_aligned(size, alignment).value_or(nullptr);
+            TCMALLOC_CHECK(p != nullptr);
+            if (p == nullptr) {
+                continue;
+            }
+            TCMALLOC_CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+            mystl::page_span* owner = mystl::page_map::get_instance().get(p);
+            TCMALLOC_CHECK(owner != nullptr && owner->unit_size() >= size);
+            std::memset(p, 0x3c, size);
+            cache.deallocate(p);
+        }
+    }
+}
+
+// 重新分配：同一级别内返回原指针，跨级别时搬到新块并保留内容
+static void TestReallocate()
+{
+    mystl::thread_cache& cache = mystl::thread_cache::get_instance();
+    const size_t first = 100;
+    const size_t unit_size = mystl::size_utils::round_up(first);
+    unsigned char* p = static_cast<unsigned char*>(cache.allocate(first).value_or(nullptr));
+    TCMALLOC_CHECK(p != nullptr);
+    if (p == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < first; ++i) {
+        p[i] = static_cast<unsigned char>(i);
+    }
+
+    // 还在同一级别里，原地返回
+    void* same = cache.reallocate(p, first, unit_size).value_or(nullptr);
+    TCMALLOC_CHECK(same == p);
+
+    // 跨到更大的级别，要复制
+    const size_t grown_size = unit_size * 4;
+    unsigned char* grown = static_cast<unsigned char*>(cache.reallocate(p, first, grown_size).value_or(nullptr));
+    TCMALLOC_CHECK(grown != nullptr && grown != p);
+    if (grown == nullptr) {
+        return;
+    }
+    bool kept = true;
+    for (size_t i = 0; i < first; ++i) {
+        kept = kept && grown[i] == static_cast<unsigned char>(i);
+    }
+    TCMALLOC_CHECK(kept);
+    TCMALLOC_CHECK(mystl::page_map::get_instance().get(grown)->unit_size() == mystl::size_utils::round_up(grown_size));
+
+    // 小块变成大块，再在大块之间调整，内容都要保留
+    size_t size = grown_size;
+    unsigned char* large = grown;
+    const size_t large_sizes[] = { 64 * 1024, 200 * 1024, 2 * 1024 * 1024, 40 * 1024 };
+    for (size_t new_size : large_sizes) {
+        unsigned char* next = static_cast<unsigned char*>(cache.reallocate(large, size, new_size).value_or(nullptr));
+        TCMALLOC_CHECK(next != nullptr);
+        if (next == nullptr) {
+            cache.deallocate(large);
+            return;
+        }
+        kept = true;
+        for (size_t i = 0; i < first; ++i) {
+            kept = kept && next[i] == static_cast<unsigned char>(i);
+        }
+        TCMALLOC_CHECK(kept);
+        TCMALLOC_CHECK(mystl::page_map::get_instance().get(next)->unit_size() >= new_size);
+        large = next;
+        size = new_size;
+    }
+    cache.deallocate(large);
+}
+
+// 中心缓存里一个 span 的块全部归还以后，这个 span 立即还给页面缓存
+static void TestEmptySpanRelease()
+{
+    // 用最大的级别，其它测试基本不会在这一级留下 span
+    const size_t unit_size = mystl::size_utils::MAX_CACHED_UNIT_SIZE;
+    const size_t index = mystl::size_utils::get_index(unit_size);
+    const size_t batch = mystl::size_utils::get_batch_count(index);
+    const size_t units_per_span = mystl::size_utils::get_span_pages(index) * mystl::size_utils::PAGE_SIZE / unit_size;
+    mystl::central_cache& central = mystl::central_cache::get_instance();
+
+    const size_t spans_before = mystl::get_allocator_stats().classes[index].span_count;
+    std::vector<void*> blocks;
+    // 至少多要两个 span 的块，保证会切出新的 span
+    while (blocks.size() < units_per_span * 2 + 1) {
+        auto list = central.allocate(unit_size, batch);
+        TCMALLOC_CHECK(list.has_value());
+        if (!list) {
+            break;
+        }
+        while (!list->empty()) {
+            blocks.push_back(list->pop());
+        }
+    }
+    const size_t spans_in_use = mystl::get_allocator_stats().classes[index].span_count;
+    TCMALLOC_CHECK(spans_in_use > spans_before);
+
+    for (void* p : blocks) {
+        mystl::free_list block;
+        block.push(p);
+        central.deallocate(std::move(block), unit_size);
+    }
+    TCMALLOC_CHECK(mystl::get_allocator_stats().classes[index].span_count == spans_before);
+}
+
+// 中转层缓存的整批块在 release_free_memory 时还给中心缓存，前端送来零散的块时按空闲程度衰减
+static void TestTransferCacheDrain()
+{
+    const size_t unit_size = 256;
+    const size_t index = mystl::size_utils::get_index(unit_size);
+    const size_t batch = mystl::size_utils::get_batch_count(index);
+    mystl::transfer_cache& transfer = mystl::transfer_cache::get_instance();
+    mystl::central_cache& central = mystl::central_cache::get_instance();
+
+    // 放进四整批
+    for (size_t i = 0; i < 4; ++i) {
+        auto list = central.allocate(unit_size, batch);
+        TCMALLOC_CHECK(list.has_value() && list->size() == batch);
+        if (list) {
+            transfer.deallocate(std::move(*list), unit_size);
+        }
+    }
+    const size_t cached = mystl::get_allocator_stats().classes[index].transfer_cached_blocks;
+    TCMALLOC_CHECK(cached >= 4 * batch);
+
+    // 第一次零散归还只确定起点，第二次把一直没动过的批还回去一半
+    for (size_t i = 0; i < 2; ++i) {
+        auto list = central.allocate(unit_size, 1);
+        TCMALLOC_CHECK(list.has_value());
+        if (list) {
+            transfer.deallocate(std::move(*list), unit_size);
+        }
+    }
+    const size_t decayed = mystl::get_allocator_stats().classes[index].transfer_cached_blocks;
+    TCMALLOC_CHECK(decayed < cached);
+
+    mystl::page_cache::get_instance().release_free_memory();
+    const mystl::allocator_stats after = mystl::get_allocator_stats();
+    TCMALLOC_CHECK(after.transfer_cached_bytes == 0);
+}
+
+// 前端缓存慢启动时只要几个块，中转层从整批里切出需要的数目，剩下的留着给下一次
+static void TestTransferCachePartialBatch()
+{
+    const size_t unit_size = 512;
+    const size_t index = mystl::size_utils::get_index(unit_size);
+    const size_t batch = mystl::size_utils::get_batch_count(index);
+    mystl::transfer_cache& transfer = mystl::transfer_cache::get_instance();
+
+    mystl::page_cache::get_instance().release_free_memory();
+    auto list = mystl::central_cache::get_instance().allocate(unit_size, batch);
+    TCMALLOC_CHECK(list.has_value() && list->size() == batch);
+    if (!list) {
+        return;
+    }
+    transfer.deallocate(std::move(*list), unit_size);
+
+    const size_t wanted = 3;
+    auto first = transfer.allocate(unit_size, wanted);
+    TCMALLOC_CHECK(first.has_value() && first->size() == wanted);
+    const size_t left = mystl::get_allocator_stats().classes[index].transfer_cached_blocks;
+    TCMALLOC_CHECK(left == batch - wanted);
+
+    auto rest = transfer.allocate(unit_size, batch);
+    TCMALLOC_CHECK(rest.has_value() && rest->size() == batch - wanted);
+    if (first) {
+        transfer.deallocate(std::move(*first), unit_size);
+    }
+    if (rest) {
+        transfer.deallocate(std::move(*rest), unit_size);
+    }
+    mystl::page_cache::get_instance().release_free_memory();
+}
+
+// 页面缓存拆开页段之前先预留记录；元数据池要不到系统内存时，可以用归还的页面补充
+static void TestMetadataArenaReserve()
+{
+    struct record {
+        void* prev;
+        void* next;
+        size_t count;
+    };
+    mystl::metadata_arena<record> arena;
+    TCMALLOC_CHECK(arena.reserve(3));
+    record* reserved[3];
+    for (record*& r : reserved) {
+        r = arena.create();
+        TCMALLOC_CHECK(r != nullptr);
+    }
+
+    alignas(64) static unsigned char buffer[4096];
+    mystl::byte* begin = reinterpret_cast<mystl::byte*>(buffer);
+    arena.donate(mystl::span<mystl::byte>(begin, sizeof(buffer)));
+    record* donated = arena.create();
+    mystl::byte* address = reinterpret_cast<mystl::byte*>(donated);
+    TCMALLOC_CHECK(address >= begin && address + sizeof(record) <= begin + sizeof(buffer));
+    arena.destroy(donated);
+    for (record* r : reserved) {
+        arena.destroy(r);
+    }
+}
+
+// 开启大页时页面缓存按大页记录分出去的页数，跨过大页边界的页面分别记到两边
+static void TestHugePageUsedCount()
+{
+    const size_t huge_size = size_t(1) << mystl::page_map::HUGE_PAGE_SHIFT;
+    // 只登记计数，不会访问这段地址
+    mystl::byte* huge = reinterpret_cast<mystl::byte*>(uintptr_t(1) << (mystl::page_map::ADDRESS_BITS - 2));
+    mystl::page_map& map = mystl::page_map::get_instance();
+    mystl::span<mystl::byte> pages(huge + huge_size - 2 * mystl::size_utils::PAGE_SIZE, 5 * mystl::size_utils::PAGE_SIZE);
+
+    map.add_huge_used(pages, true);
+    TCMALLOC_CHECK(map.get_huge_used(huge) == 2);
+    TCMALLOC_CHECK(map.get_huge_used(huge + huge_size) == 3);
+    map.add_huge_used(pages, false);
+    TCMALLOC_CHECK(map.get_huge_used(huge) == 0);
+    TCMALLOC_CHECK(map.get_huge_used(huge + huge_size) == 0);
+}
+
+// 按CPU的缓存不会响应线程的清空请求，drain 把所有CPU缓存的块一次还给中转层
+static void TestCpuCacheDrain()
+{
+    // 拿不到CPU编号（没有 rseq）时按CPU的缓存不会被用到
+    if (!mystl::cpu_cache::is_available()) {
+        return;
+    }
+    mystl::cpu_cache& cache = mystl::cpu_cache::get_instance();
+    void* blocks[64];
+    for (void*& p : blocks) {
+        p = cache.allocate(256).value_or(nullptr);
+        TCMALLOC_CHECK(p != nullptr);
+    }
+    for (void* p : blocks) {
+        cache.deallocate(p, 256);
+    }
+    mystl::allocator_stats before;
+    cache.collect_stats(before);
+    TCMALLOC_CHECK(before.cpu_cached_bytes >= sizeof(blocks) / sizeof(void*) * 256);
+    TCMALLOC_CHECK(cache.drain() == before.cpu_cached_bytes);
+    mystl::allocator_stats after;
+    cache.collect_stats(after);
+    TCMALLOC_CHECK(after.cpu_cached_bytes == 0);
+}
+
+// 多个线程同时 dump，每一份输出都是完整的：头部的存活个数和后面的记录行数一致
+static void TestConcurrentHeapDump()
+{
+    mystl::heap_profiler::set_sample_rate(4096);
+    mystl::thread_cache& cache = mystl::thread_cache::get_instance();
+    // 关闭采样时每 RECHECK_INTERVAL 字节才重新检查一次采样率，要分配得比它多
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 4 * mystl::heap_profiler::RECHECK_INTERVAL / 512; ++i) {
+        blocks.push_back(cache.allocate(512).value_or(nullptr));
+    }
+
+    std::string outputs[4];
+    std::vector<std::thread> dumpers;
+    for (std::string& output : outputs) {
+        dumpers.emplace_back([&output]() {
+            std::ostringstream os;
+            mystl::heap_profiler::get_instance().dump(os);
+            output = os.str();
+        });
+    }
+    for (auto& t : dumpers) {
+        t.join();
+    }
+    for (const std::string& output : outputs) {
+        std::istringstream is(output);
+        std::string header;
+        std::getline(is, header);
+        size_t live = 0;
+        TCMALLOC_CHECK(std::sscanf(header.c_str(), "heap profile: %zu:", &live) == 1);
+        TCMALLOC_CHECK(live > 0);
+        size_t records = 0;
+        std::string line;
+        while (std::getline(is, line) && !line.empty()) {
+            ++records;
+        }
+        TCMALLOC_CHECK(records == live);
+    }
+
+    for (void* p : blocks) {
+        cache.deallocate(p);
+    }
+    mystl::heap_profiler::set_sample_rate(0);
+}
+
+// 大的 calloc 和大的对齐申请不经过 allocate 的快路径，也要被采样，释放后记录随之删除
+static bool IsSampled(void* p)
+{
+    std::vector<mystl::heap_profiler::sample> samples(mystl::heap_profiler::MAX_SAMPLES);
+    const size_t count = mystl::heap_profiler::get_instance().snapshot(samples.data(), samples.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (samples[i].address == p) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void TestLargeAllocationSampling()
+{
+    mystl::heap_profiler::set_sample_rate(4096);
+    const size_t size = 2 * mystl::heap_profiler::RECHECK_INTERVAL;
+    // 关闭采样时攒下的间隔最多 RECHECK_INTERVAL，先用一次大块把它消耗掉
+    mystl::tcmalloc_deallocate(mystl::tcmalloc_allocate_zeroed(size));
+
+    void* zeroed = mystl::tcmalloc_allocate_zeroed(size);
+    TCMALLOC_CHECK(zeroed != nullptr);
+    TCMALLOC_CHECK(IsSampled(zeroed));
+    void* aligned = mystl::tcmalloc_allocate_aligned(size, 64 * 1024);
+    TCMALLOC_CHECK(aligned != nullptr && reinterpret_cast<uintptr_t>(aligned) % (64 * 1024) == 0);
+    TCMALLOC_CHECK(IsSampled(aligned));
+
+    mystl::tcmalloc_deallocate(zeroed);
+    mystl::tcmalloc_deallocate_aligned(aligned);
+    TCMALLOC_CHECK(!IsSampled(zeroed));
+    TCMALLOC_CHECK(!IsSampled(aligned));
+    mystl::heap_profiler::set_sample_rate(0);
+}
+
+// 线程缓存不能用时（重入或者线程退出以后）释放直接走中心缓存和页面缓存，采样记录也要删掉
+static void TestFallbackFreeSampling()
+{
+    mystl::heap_profiler::set_sample_rate(4096);
+    const size_t size = 2 * mystl::heap_profiler::RECHECK_INTERVAL;
+    mystl::tcmalloc_deallocate(mystl::tcmalloc_allocate(size));
+
+    void* large = mystl::tcmalloc_allocate(size);
+    TCMALLOC_CHECK(large != nullptr && IsSampled(large));
+    // 一共 64K，按 4K 的采样间隔一定有块被采到
+    std::vector<void*> small(256);
+    for (void*& p : small) {
+        p = mystl::tcmalloc_allocate(256);
+    }
+    {
+        mystl::allocator_reentry_guard guard;
+        mystl::tcmalloc_deallocate(large);
+        for (void* p : small) {
+            mystl::tcmalloc_deallocate(p);
+        }
+    }
+    TCMALLOC_CHECK(!IsSampled(large));
+    std::vector<mystl::heap_profiler::sample> samples(mystl::heap_profiler::MAX_SAMPLES);
+    const size_t count = mystl::heap_profiler::get_instance().snapshot(samples.data(), samples.size());
+    for (size_t i = 0; i < count; ++i) {
+        TCMALLOC_CHECK(std::find(small.begin(), small.end(), samples[i].address) == small.end());
+    }
+    mystl::heap_profiler::set_sample_rate(0);
+}
+
+// 在分配器的单例之前构造的静态容器：构造时不申请内存，第一次申请发生在单例创建之后，
+// 所以它在单例之后析构，进程退出时还要把块还给分配器
+static std::vector<int, mystl::allocator<int>> g_exit_time_values;
+
+static void TestExitTimeContainer()
+{
+    for (int i = 0; i < 100000; ++i) {
+        g_exit_time_values.push_back(i);
+    }
+    TCMALLOC_CHECK(g_exit_time_values.back() == 99999);
+}
+
+static void RunTCMallocChecks()
+{
+    TestSizeClassRoundTrip();
+    TestSizelessDeallocate();
+    TestLargeSpans();
+    TestThreadExitDrain();
+    TestAlignedAllocation();
+    TestReallocate();
+    TestEmptySpanRelease();
+    TestTransferCacheDrain();
+    TestTransferCachePartialBatch();
+    TestMetadataArenaReserve();
+    TestHugePageUsedCount();
+    TestCpuCacheDrain();
+    TestConcurrentHeapDump();
+    TestLargeAllocationSampling();
+    TestFallbackFreeSampling();
+    TestExitTimeContainer();
+}
+
 int test_TCMalloc_main()
 {
-    // Բ
-    const size_t ntimes = 20;  // ÿֲ
-    const size_t nworks = 1;      // ߳
-    const size_t rounds = 10;     // ִ
+    // 定义测试参数
+    const size_t ntimes = 20;  // 每轮操作次数
+    const size_t nworks = 1;      // 并发线程数
+    const size_t rounds = 10;     // 总轮次
 
-    std::cout << "--- ʼڴػ׼ ---" << std::endl;
-    printf("Բ: ߳=%zu, ִ=%zu, ÿֲ=%zu\n\n", nworks, rounds, ntimes * 4);
+    std::cout << "--- 开始内存池基准测试 ---" << std::endl;
+    printf("测试参数: 线程数=%zu, 轮次=%zu, 每轮操作数=%zu\n\n", nworks, rounds, ntimes * 4);
 
-    // б׼ new/delete Ļ׼
+    // 首先运行标准 new/delete 的基准
     BenchmarkNewDelete(ntimes, nworks, rounds);
 
-    //  TCMalloc-like ڴصĻ׼
-    // ע: ڴʵͨ thread_local static ʵԶʼʾʽ Init 
+    // 运行您的 TCMalloc-like 内存池的基准
+    // 注意: 您的内存池实现通过 thread_local static 实例自动初始化，无需像示例中那样调用显式的 Init 函数。
     BenchmarkTCMalloc(ntimes, nworks, rounds);
 
-    std::cout << "\n--- ׼Խ ---" << std::endl;
-
-    
-    mystl::page_cache::get_instance().stop();
+    std::cout << "\n--- 基准测试结束 ---" << std::endl;
 
+    RunTCMallocChecks();
+    if (g_tcmalloc_failures != 0) {
+        std::cerr << g_tcmalloc_failures << " TCMalloc check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "TCMalloc checks passed" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -4,13 +4,13 @@
 #include <cassert>
 #include <string>
 #include <functional> // for std::greater
-#include "../include/list.h" //  list.h ·
+#include "../include/list.h" // 假设您的 list.h 在这个路径
 
 namespace mystl {
     namespace test {
         namespace list_test {
 
-            // ڴӡͱȽ list 
+            // 辅助函数，用于打印和比较 list 内容
             template <class T>
             void print_list(const mystl::list<T>& l, const std::string& name) {
                 std::cout << name << " : [ ";
@@ -25,7 +25,7 @@ namespace mystl {
                 std::cout << "[------------------- Run container test : list -----------------]\n";
                 std::cout << "[-------------------------- API test ---------------------------]\n";
 
-                // 1. 캯ϵ
+                // 1. 构造函数系列
                 {
                     std::cout << "\n*** 1. Testing constructors ***\n";
                     int arr[] = { 1,3,5,7,9 };
@@ -45,17 +45,17 @@ namespace mystl {
                     mystl::list<int> l5(l4);
                     assert(l5.size() == 5 && l5.front() == 1 && l5.back() == 9);
 
-                    // ƶ캯ΪƶΪ״̬
+                    // 假设移动构造函数已修正为将被移动对象置为空状态
                     mystl::list<int> l6(std::move(l5));
                     assert(l6.size() == 5 && l6.front() == 1 && l6.back() == 9);
-                    assert(l5.empty() && l5.size() == 0); // ֤ƶ״̬
+                    assert(l5.empty() && l5.size() == 0); // 验证被移动对象的状态
 
                     mystl::list<int> l7{ 2,4,6,8 };
                     assert(l7.size() == 4 && l7.front() == 2 && l7.back() == 8);
                     std::cout << "Constructors PASSED\n";
                 }
 
-                // 2. ֵϵ
+                // 2. 赋值操作系列
                 {
                     std::cout << "\n*** 2. Testing assignments ***\n";
                     mystl::list<int> src{ 1,2,3 };
@@ -64,7 +64,7 @@ namespace mystl {
                     l1 = src;
                     assert(l1.size() == 3 && l1.back() == 3);
 
-                    // ƶֵԴӦΪ
+                    // 移动赋值后，源对象应为空
                     l2 = std::move(src);
                     assert(l2.size() == 3 && l2.back() == 3);
                     assert(src.empty());
@@ -72,13 +72,13 @@ namespace mystl {
                     l1 = { 4,5,6,7 };
                     assert(l1.size() == 4 && l1.back() == 7);
 
-                    // Ҹֵ
+                    // 自我赋值
                     l1 = l1;
                     assert(l1.size() == 4 && l1.back() == 7);
                     std::cout << "Assignments PASSED\n";
                 }
 
-                // 3. 
+                // 3. 迭代器测试
                 {
                     std::cout << "\n*** 3. Testing iterators ***\n";
                     mystl::list<int> l{ 1, 2, 3 };
@@ -106,7 +106,7 @@ namespace mystl {
                     std::cout << "Iterators PASSED\n";
                 }
 
-                // 4. ز
+                // 4. 容量相关测试
                 {
                     std::cout << "\n*** 4. Testing capacity ***\n";
                     mystl::list<int> l;
@@ -120,11 +120,11 @@ namespace mystl {
                     std::cout << "Capacity PASSED\n";
                 }
 
-                // 5. ޸ϵУص㲹䣩
+                // 5. 修改器系列（重点补充）
                 {
                     std::cout << "\n*** 5. Testing modifiers ***\n";
 
-                    // push_front / pop_front (֮ǰȱʧĲ)
+                    // push_front / pop_front (之前缺失的测试)
                     {
                         mystl::list<int> l;
                         l.push_front(10);
@@ -137,7 +137,7 @@ namespace mystl {
                         std::cout << "push_front / pop_front PASSED\n";
                     }
 
-                    // push_back / pop_back (֮ǰȱʧĲ)
+                    // push_back / pop_back (之前缺失的测试)
                     {
                         mystl::list<int> l;
                         l.push_back(10);
@@ -154,7 +154,7 @@ namespace mystl {
                     {
                         mystl::list<int> l{ 1, 5 };
                         auto it = l.begin();
-                        ++it; // ָ 5
+                        ++it; // 指向 5
                         l.insert(it, 3); // 1, 3, 5
                         it = l.begin();
                         assert(*it++ == 1);
@@ -174,13 +174,13 @@ namespace mystl {
                     {
                         mystl::list<int> l{ 1,2,3,4,5 };
                         auto it = l.begin();
-                        ++it; // ָ 2
-                        it = l.erase(it); // ɾ 2, it ָ 3
+                        ++it; // 指向 2
+                        it = l.erase(it); // 删除 2, it 指向 3
                         assert(*it == 3 && l.size() == 4);
 
                         auto it2 = l.end();
-                        --it2; --it2; // ָ 4
-                        it = l.erase(it, it2); // ɾ 3, it ָ 4
+                        --it2; --it2; // 指向 4
+                        it = l.erase(it, it2); // 删除 3, it 指向 4
                         assert(*it == 4 && l.size() == 3);
                         std::cout << "erase PASSED\n";
                     }
@@ -209,7 +209,7 @@ namespace mystl {
                     }
                 }
 
-                // 6. List ϵ
+                // 6. List 操作系列
                 {
                     std::cout << "\n*** 6. Testing list operations ***\n";
 